@@ -0,0 +1,1893 @@
+#ifndef __MAZE_ENGINE__
+#define __MAZE_ENGINE__
+
+#include <stdbool.h>
+#include <float.h>
+#include <math.h>
+#include <netinet/in.h>
+#include <pthread.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+
+#define PI 3.14159265
+#define TILE_SIZE 64
+#define NUM_TEXTURES 6
+#define TEXTURE_MAX_IDS 255
+#define TEXTURE_HIT_WORDS ((TEXTURE_MAX_IDS + 31) / 32)
+#define TEXTURE_PLACEHOLDER_SHIFT 3
+#define FOV_ANGLE (60 * (PI / 180))
+#define MAP_NUM_ROWS 13 /*13*/
+#define MAP_NUM_COLS 20 /*20*/
+#define FLOOR_TEXTURE_INDEX 4
+#define CEILING_TEXTURE_INDEX 4
+#define MINIMAP_SCALE_FACTOR 0.2
+#define MINIMAP_MAX_WIDTH 320
+#define MINIMAP_MAX_HEIGHT 240
+#define TEXTURE_CACHE_MAGIC "MAZETEX"
+#define TEXTURE_CACHE_VERSION 1
+#define TEXTURE_CACHE_ALIGN 64
+#define CACHE_LINE_SIZE 64
+#define DRAW_BATCH_SIZE 256
+#define CAPTURE_RING_SIZE 8
+#define STREAM_RING_SIZE 2
+#define STREAM_TILE 32
+#define STREAM_MAGIC "MZFS"
+#define STREAM_VERSION 1
+#define STREAM_HELLO_SIZE 20
+#define STREAM_FRAME_HEADER 12
+#define STREAM_DRAIN_MS 500
+#define MAP_MAX_SIZE 16384
+#define MAP_READ_CHUNK 65536
+#define NAV_STRAIGHT_COST 10
+#define NAV_DIAGONAL_COST 14
+#define NAV_BUCKETS (NAV_DIAGONAL_COST + 1)
+#define NAV_UNREACHABLE 0xFFFFFFFFu
+#define NAV_NONE 8
+#define PVS_MAGIC "MAZEPVS"
+#define PVS_VERSION 1
+#define LIGHT_LEVELS 64
+#define LIGHT_FULL (LIGHT_LEVELS - 1)
+#define LIGHT_AMBIENT 44
+#define LIGHT_VERTICAL_SHADE 179
+#define LIGHT_MAX_SOURCES 64
+#define LIGHT_MERGE_CELLS 8
+#define WATCH_MAX_FILES (2 + TEXTURE_MAX_IDS)
+#define INTERLEAVE_MAX_STEP (TILE_SIZE / 8)
+#define INTERLEAVE_MAX_TURN (FOV_ANGLE / 16)
+#define WALL_SPAN_MAX 32
+#define WALL_SPAN_SLACK 2
+#define RENDER_FLOOR 1
+#define RENDER_CEILING 2
+#define RENDER_WALLS 4
+#define RENDER_ALL (RENDER_FLOOR | RENDER_CEILING | RENDER_WALLS)
+#define RAY_CACHE_STEPS 1024
+#define RAY_PACKET 8
+#define NET_MAX_PLAYERS 64
+#define NET_TICK_RATE 30
+#define NET_HISTORY 64
+#define NET_MAX_PACKET 1200
+#define NET_LINK_QUEUE 512
+#define NET_POSITION_SCALE 16
+#define NET_TIMEOUT 5.0
+#define NET_INTERP_TICKS 2
+#define NET_MSG_INPUT 1
+#define NET_MSG_SNAPSHOT 2
+#define NET_MSG_BYE 3
+#define STATS_MAGIC 0x4D5A5354
+#define STATS_VERSION 3
+#define STATS_HUD_SCALE 2
+#define LATENCY_BUCKETS 1000
+#define LATENCY_BUCKET_US 100
+typedef uint32_t color_t;
+
+/**
+ * struct ray_buffer_s - The rays of a frame, one array per field.
+ *
+ * @ray_angle: The angle of each ray.
+ * @wall_hit_x: The x-coordinate of each wall hit point.
+ * @wall_hit_y: The y-coordinate of each wall hit point.
+ * @distance: The distance from the ray's origin to the wall hit point.
+ * @was_hit_vertical: Non-zero when the wall hit was vertical, zero when it
+ * was horizontal.
+ * @texture: The texture associated with each wall hit.
+ * @count: The number of rays, one per screen column.
+ *
+ * Description: Each render pass only streams the fields it needs, and
+ * consecutive rays of a field are contiguous for vector code.
+ */
+typedef struct ray_buffer_s
+{
+	float *ray_angle;
+	float *wall_hit_x;
+	float *wall_hit_y;
+	float *distance;
+	unsigned char *was_hit_vertical;
+	int *texture;
+	int count;
+} ray_buffer_t;
+
+/**
+ * struct frame_arena_s - A bump allocator for data living one frame.
+ *
+ * @base: Start of the arena, aligned to CACHE_LINE_SIZE.
+ * @size: The capacity of the arena in bytes.
+ * @used: The number of bytes handed out since the last reset.
+ *
+ * Description: The arena is sized once, and every allocation is rounded
+ * to a whole number of cache lines so arrays never share a line.
+ */
+typedef struct frame_arena_s
+{
+	unsigned char *base;
+	size_t size;
+	size_t used;
+} frame_arena_t;
+
+/**
+ * struct wall_hit_data - Structure to hold wall hit data
+ * @horz_wall_hit_x: X-coordinate of the horizontal wall hit
+ * @horz_wall_hit_y: Y-coordinate of the horizontal wall hit
+ * @vert_wall_hit_x: X-coordinate of the vertical wall hit
+ * @vert_wall_hit_y: Y-coordinate of the vertical wall hit
+ * @horz_wall_texture: Horizontal wall texture
+ * @vert_wall_texture: Vertical wall texture
+ * @found_horz_wall_hit: Flag indicating if a horizontal wall hit was found
+ * @found_vert_wall_hit: Flag indicating if a vertical wall hit was found
+ * @cells: The number of grid cells checked for a wall, by both searches
+ *
+ * This structure encapsulates the variables related to wall hit information.
+ */
+typedef struct wall_hit_data
+{
+	float horz_wall_hit_x;
+	float horz_wall_hit_y;
+	float vert_wall_hit_x;
+	float vert_wall_hit_y;
+	int horz_wall_texture;
+	int vert_wall_texture;
+	bool found_horz_wall_hit;
+	bool found_vert_wall_hit;
+	int cells;
+} wall_hit_data_t;
+
+typedef float ray_lanes_t __attribute__((vector_size(4 * RAY_PACKET)));
+typedef int32_t ray_mask_t __attribute__((vector_size(4 * RAY_PACKET)));
+
+/**
+ * struct ray_walk_s - A packet of rays stepping from grid line to grid
+ * line, one lane per ray.
+ *
+ * @x: The x-coordinate of the next grid line crossing of each ray.
+ * @y: The y-coordinate of the next grid line crossing of each ray.
+ * @step_x: The x distance between two crossings.
+ * @step_y: The y distance between two crossings.
+ * @offset_x: -1 for the rays checking the cell left of the crossing, or 0.
+ * @offset_y: -1 for the rays checking the cell above the crossing, or 0.
+ * @active: All bits set in the lanes still stepping, 0 in the others.
+ * @vertical: Whether the rays cross vertical grid lines.
+ *
+ * Description: The horizontal and vertical searches of cast_ray() are the
+ * same walk from different starts, so one packet type serves both.
+ */
+typedef struct ray_walk_s
+{
+	ray_lanes_t x;
+	ray_lanes_t y;
+	ray_lanes_t step_x;
+	ray_lanes_t step_y;
+	ray_lanes_t offset_x;
+	ray_lanes_t offset_y;
+	ray_mask_t active;
+	bool vertical;
+} ray_walk_t;
+
+/**
+ * struct map_s - Represents a map of wall texture IDs.
+ *
+ * @cells: The @rows x @cols cells, row by row. 0 is open space and any
+ *         other value, up to TEXTURE_MAX_IDS, is a wall drawn with
+ *         texture ID - 1.
+ * @rows: The number of rows, at most MAP_MAX_SIZE.
+ * @cols: The number of columns, at most MAP_MAX_SIZE.
+ * @version: Incremented every time the content of the map changes, so
+ * data derived from the map knows when to rebuild.
+ *
+ * Description: The size of the map comes from its file, so @cells is
+ * allocated by parse_map_from_file() and released by map_free().
+ */
+typedef struct map_s
+{
+	unsigned char *cells;
+	int rows;
+	int cols;
+	unsigned int version;
+} map_t;
+
+/**
+ * struct map_area_s - A rectangle of map cells, bounds included.
+ *
+ * @top: The first row.
+ * @left: The first column.
+ * @bottom: The last row.
+ * @right: The last column.
+ */
+typedef struct map_area_s
+{
+	int top;
+	int left;
+	int bottom;
+	int right;
+} map_area_t;
+
+/**
+ * struct map_reader_s - The state of a map file being parsed.
+ *
+ * @map: Pointer to the map receiving the cells.
+ * @capacity: The number of cells @map->cells can hold.
+ * @count: The number of cells read so far.
+ * @row_cols: The number of cells read on the current line.
+ * @line: The current line of the file, for error messages.
+ * @value: The number being read, or -1 between numbers.
+ *
+ * Description: The file is read in chunks of MAP_READ_CHUNK bytes, so a
+ * number may start in one chunk and end in the next.
+ */
+typedef struct map_reader_s
+{
+	map_t *map;
+	size_t capacity;
+	size_t count;
+	int row_cols;
+	int line;
+	int value;
+} map_reader_t;
+
+/**
+ * enum maze_layout_e - The layouts the map generator produces.
+ *
+ * @MAZE_PERFECT: Corridors with exactly one path between any two cells.
+ * @MAZE_BRAIDED: A perfect maze whose dead ends are opened into loops.
+ * @MAZE_CAVE: Smooth noise cut into winding caverns.
+ * @MAZE_HALL: An open hall scattered with square pillars.
+ */
+typedef enum maze_layout_e
+{
+	MAZE_PERFECT,
+	MAZE_BRAIDED,
+	MAZE_CAVE,
+	MAZE_HALL
+} maze_layout_t;
+
+/**
+ * struct mazegen_s - The parameters of a generated map.
+ *
+ * @layout: The kind of map to generate.
+ * @rows: The number of rows of the map, walls included.
+ * @cols: The number of columns of the map, walls included.
+ * @seed: The seed; the same parameters always give the same map.
+ */
+typedef struct mazegen_s
+{
+	maze_layout_t layout;
+	int rows;
+	int cols;
+	uint64_t seed;
+} mazegen_t;
+
+/**
+ * struct maze_rows_s - The rolling row state of Eller's algorithm.
+ *
+ * @width: The number of maze cells in a row.
+ * @parent: Union-find parents joining the cells of the current row.
+ * @scratch: Per-set flags and roots, reused by each pass over a row.
+ * @count: Per-set cell counts, reused by each pass over a row.
+ * @east: Whether each cell opens into the cell on its right.
+ * @south: Whether each cell opens into the cell below.
+ * @north: Whether each cell opens into the cell above.
+ * @walls: One row of map cells, nonzero for walls.
+ * @line: The text of one row of the map.
+ * @rng: The state of the xorshift generator.
+ *
+ * Description: Only the current row and the links to the previous one
+ * are kept, so the memory used grows with the width of the maze alone.
+ */
+typedef struct maze_rows_s
+{
+	int width;
+	int *parent;
+	int *scratch;
+	int *count;
+	unsigned char *east;
+	unsigned char *south;
+	unsigned char *north;
+	unsigned char *walls;
+	char *line;
+	uint64_t rng;
+} maze_rows_t;
+
+/**
+ * struct player_t - Represents a player in the game.
+ *
+ * @x: The x-coordinate of the player's position.
+ * @y: The y-coordinate of the player's position.
+ * @width: The width of the player's bounding box.
+ * @height: The height of the player's bounding box.
+ * @turn_direction: The player's turn direction
+ * (-1 for left, 1 for right, 0 for no turn).
+ * @walk_direction: The player's walk direction
+ * (-1 for backward, 1 for forward, 0 for no walk).
+ * @rotation_angle: The current rotation angle of the player.
+ * @walk_speed: The speed at which the player walks.
+ * @turn_speed: The speed at which the player turns.
+ */
+typedef struct player_t
+{
+	float x;
+	float y;
+	float width;
+	float height;
+	int turn_direction;
+	int walk_direction;
+	float rotation_angle;
+	float walk_speed;
+	float turn_speed;
+} player_t;
+
+/**
+ * struct texture_s - Represents a texture in the game.
+ *
+ * @width: The width of the texture in pixels
+ * @height: The height of the texture in pixels.
+ * @width_shift: log2(@width) for textures packed in a texture_atlas_t,
+ * whose dimensions are powers of two.
+ * @texture_buffer: Pointer to the texture buffer storing pixel data.
+ *
+ * Description: The texture_t struct represents a texture used in the game.
+ * It contains the dimensions of the texture and a buffer that stores its
+ * pixel data, in the RGBA32 format, which is all the renderer reads.
+ */
+typedef struct texture_s
+{
+	int width;
+	int height;
+	int width_shift;
+	color_t *texture_buffer;
+} texture_t;
+
+/**
+ * struct texture_atlas_s - Every texture packed in a single allocation.
+ *
+ * @pixels: The allocation holding the pixels of every tile.
+ * @tiles: One texture_t per texture index, pointing into @pixels.
+ * @count: The number of tiles packed.
+ *
+ * Description: Tiles are stored one after the other, each padded up to a
+ * cache line, and their dimensions are rounded up to powers of two so
+ * texture coordinates wrap with a mask instead of a modulo. The indices
+ * past @count share a single black texel, so a map naming a texture the
+ * atlas lacks still renders.
+ */
+typedef struct texture_atlas_s
+{
+	color_t *pixels;
+	texture_t tiles[TEXTURE_MAX_IDS];
+	int count;
+} texture_atlas_t;
+
+/**
+ * struct plane_column_s - Per-column constants of a floor or ceiling span.
+ *
+ * @texture: Pointer to the texture mapped on the plane.
+ * @cos_angle: Cosine of the ray angle, negated for the ceiling.
+ * @sin_angle: Sine of the ray angle, negated for the ceiling.
+ * @cos_correction: Cosine of the ray angle relative to the view angle.
+ * @column: The screen column being rendered.
+ */
+typedef struct plane_column_s
+{
+	const texture_t *texture;
+	double cos_angle;
+	double sin_angle;
+	double cos_correction;
+	int column;
+} plane_column_t;
+
+/**
+ * struct texture_cache_header_s - The header of a texture cache file.
+ *
+ * @magic: TEXTURE_CACHE_MAGIC, NUL terminated.
+ * @version: TEXTURE_CACHE_VERSION of the writer.
+ * @num_textures: The number of texture_cache_entry_t following the header.
+ */
+typedef struct texture_cache_header_s
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t num_textures;
+} texture_cache_header_t;
+
+/**
+ * struct texture_cache_entry_s - Describes one texture of a cache file.
+ *
+ * @source_mtime: Modification time of the source image, in nanoseconds.
+ * @source_size: Size of the source image, in bytes.
+ * @width: The width of the decoded texture in pixels.
+ * @height: The height of the decoded texture in pixels.
+ * @offset: Offset of the RGBA32 pixels from the start of the file.
+ */
+typedef struct texture_cache_entry_s
+{
+	int64_t source_mtime;
+	int64_t source_size;
+	uint32_t width;
+	uint32_t height;
+	uint64_t offset;
+} texture_cache_entry_t;
+
+/**
+ * struct texture_cache_s - A texture cache file mapped in memory.
+ *
+ * @mapping: Start of the read-only mapping, NULL when nothing is mapped.
+ * @size: The size of the mapping in bytes.
+ */
+typedef struct texture_cache_s
+{
+	void *mapping;
+	size_t size;
+} texture_cache_t;
+
+/**
+ * enum texture_state_e - Where the texels of a texture index are.
+ *
+ * @TEXTURE_ABSENT: Not loaded; the placeholder is drawn.
+ * @TEXTURE_QUEUED: Waiting for or being read by the loader thread.
+ * @TEXTURE_RESIDENT: Loaded and drawn.
+ * @TEXTURE_FAILED: The loader could not read it; it is not retried
+ * until texture_pool_invalidate().
+ */
+typedef enum texture_state_e
+{
+	TEXTURE_ABSENT,
+	TEXTURE_QUEUED,
+	TEXTURE_RESIDENT,
+	TEXTURE_FAILED
+} texture_state_t;
+
+/**
+ * struct texture_slot_s - The residency of one texture index.
+ *
+ * @pixels: The tile of the texture, or NULL when not resident.
+ * @bytes: The size of @pixels.
+ * @last_used: The last update of the pool a view hit the texture in.
+ * @state: Where the texels are.
+ * @stale: Set when the source changed; the texture is read again the
+ * next time it is hit, and drawn as it was meanwhile.
+ */
+typedef struct texture_slot_s
+{
+	color_t *pixels;
+	size_t bytes;
+	unsigned long last_used;
+	texture_state_t state;
+	bool stale;
+} texture_slot_t;
+
+/**
+ * struct texture_pool_s - Textures loaded on demand under a memory budget.
+ *
+ * @textures: One texture per texture index, what world_t.textures points
+ * to; an index that is not resident shows @placeholder.
+ * @slots: The residency of each index.
+ * @loaded: The tiles the loader thread finished, by index, with a NULL
+ * buffer when loading failed.
+ * @queue: The indices waiting for the loader, in a ring.
+ * @head: The position of the next index to load in @queue.
+ * @queued: The number of indices in @queue.
+ * @done: The indices of @loaded not installed yet.
+ * @num_done: The number of indices in @done.
+ * @busy: The loads requested and not finished yet.
+ * @generations: How many times the source of each index changed, as
+ * texture_pool_invalidate() counts it.
+ * @placeholder: The texels drawn for textures that are not resident.
+ * @load: Reads a texture into a malloc'ed buffer the pool frees, or
+ * points it at texels it keeps and sets its last argument, on the loader
+ * thread, given its generation; returns false if it cannot.
+ * @context: The first argument of @load.
+ * @count: The number of texture indices that can be loaded.
+ * @budget: The bytes the resident tiles should stay under.
+ * @resident: The bytes of the resident tiles.
+ * @frame: The number of updates so far.
+ * @loads: The textures installed so far.
+ * @evictions: The textures evicted so far.
+ * @stopping: Set when the loader thread has to exit.
+ * @lock: Protects @loaded, @queue to @generations and @stopping.
+ * @wake: Signalled when an index is queued or the pool stops.
+ * @idle: Signalled when the last requested load finishes.
+ * @loader: The loader thread.
+ *
+ * Description: Only texture_pool_update() changes what views read, so
+ * it must run between frames. The loader thread never touches @textures
+ * or @slots.
+ */
+typedef struct texture_pool_s
+{
+	texture_t textures[TEXTURE_MAX_IDS];
+	texture_slot_t slots[TEXTURE_MAX_IDS];
+	texture_t loaded[TEXTURE_MAX_IDS];
+	int queue[TEXTURE_MAX_IDS];
+	int head;
+	int queued;
+	int done[TEXTURE_MAX_IDS];
+	int num_done;
+	int busy;
+	unsigned int generations[TEXTURE_MAX_IDS];
+	color_t placeholder[1 << 2 * TEXTURE_PLACEHOLDER_SHIFT];
+	bool (*load)(void *, int, unsigned int, texture_t *, bool *);
+	void *context;
+	int count;
+	size_t budget;
+	size_t resident;
+	unsigned long frame;
+	unsigned long loads;
+	unsigned long evictions;
+	bool stopping;
+	pthread_mutex_t lock;
+	pthread_cond_t wake;
+	pthread_cond_t idle;
+	pthread_t loader;
+} texture_pool_t;
+
+/**
+ * struct framebuffer_s - A caller-owned RGBA32 pixel buffer.
+ *
+ * @pixels: Pointer to the first pixel of the buffer.
+ * @width: The width of the buffer in pixels.
+ * @height: The height of the buffer in pixels.
+ * @pitch: The distance between two rows, in pixels (>= @width).
+ * @pixel_calls: The number of draw_pixel() calls on the buffer since a
+ * view last started a frame in it.
+ */
+typedef struct framebuffer_s
+{
+	color_t *pixels;
+	int width;
+	int height;
+	int pitch;
+	unsigned long pixel_calls;
+} framebuffer_t;
+
+/**
+ * enum draw_kind_e - The kinds of primitives a draw batch holds.
+ *
+ * @DRAW_LINE: A line from (x0, y0) to (x1, y1), end point excluded.
+ * @DRAW_RECT: A filled rectangle at (x0, y0) of size x1 by y1.
+ */
+typedef enum draw_kind_e
+{
+	DRAW_LINE,
+	DRAW_RECT
+} draw_kind_t;
+
+/**
+ * struct draw_cmd_s - A primitive queued in a draw batch.
+ *
+ * @kind: The kind of primitive.
+ * @x0: First x-coordinate.
+ * @y0: First y-coordinate.
+ * @x1: Second x-coordinate, or the width of a rectangle.
+ * @y1: Second y-coordinate, or the height of a rectangle.
+ * @color: The color of the primitive.
+ */
+typedef struct draw_cmd_s
+{
+	draw_kind_t kind;
+	int x0;
+	int y0;
+	int x1;
+	int y1;
+	color_t color;
+} draw_cmd_t;
+
+/**
+ * struct draw_batch_s - Primitives queued to be drawn in one pass.
+ *
+ * @cmds: The queued primitives, in submission order.
+ * @count: The number of queued primitives.
+ * @capacity: The number of primitives @cmds can hold.
+ */
+typedef struct draw_batch_s
+{
+	draw_cmd_t *cmds;
+	int count;
+	int capacity;
+} draw_batch_t;
+
+/**
+ * struct light_s - A static point light baked into a lightmap.
+ *
+ * @x: The x-coordinate of the light, in world units.
+ * @y: The y-coordinate of the light, in world units.
+ * @radius: The distance at which the light fades out, in world units.
+ * @level: The light added next to the source, up to LIGHT_FULL.
+ */
+typedef struct light_s
+{
+	float x;
+	float y;
+	float radius;
+	int level;
+} light_t;
+
+/**
+ * struct lightmap_s - The static lighting of a map, baked once.
+ *
+ * @rows: The number of rows of the map.
+ * @cols: The number of columns of the map.
+ * @cells: One light level per cell, lighting the floor and the ceiling
+ * of open cells.
+ * @corners: (@rows + 1) x (@cols + 1) light levels at the corners of the
+ * cells; a wall face is lit by blending the levels of its two ends.
+ * @shade: @shade[level][c] is the channel value c scaled by
+ * level / LIGHT_FULL.
+ * @lights: A copy of the point lights, so changes to the map can be
+ * rebaked by lightmap_update().
+ * @num_lights: The number of lights.
+ * @ambient: The level of the ambient light.
+ * @map_version: The version of the map the lighting was baked from.
+ *
+ * Description: Levels are baked from the ambient light, darkened where
+ * walls occlude it, plus the lights reaching each cell in a straight
+ * line. Walls get one level per column and shade their texels through
+ * @shade; floors and ceilings change level from cell to cell and look
+ * the level of the cell up per pixel, with no floating point.
+ */
+typedef struct lightmap_s
+{
+	int rows;
+	int cols;
+	unsigned char *cells;
+	unsigned char *corners;
+	unsigned char shade[LIGHT_LEVELS][256];
+	light_t *lights;
+	int num_lights;
+	int ambient;
+	unsigned int map_version;
+} lightmap_t;
+
+/**
+ * struct world_s - The immutable data shared by every camera.
+ *
+ * @map: Pointer to the map the cameras look into.
+ * @textures: Array of TEXTURE_MAX_IDS wall, floor and ceiling textures,
+ * as packed by texture_atlas_build() or kept by a texture_pool_t.
+ * @lightmap: Pointer to the lighting baked for @map, or NULL to only
+ * darken the walls hit on a vertical grid line.
+ *
+ * Description: Nothing in the engine writes through these pointers, so a
+ * single world can be rendered from any number of threads at once.
+ */
+typedef struct world_s
+{
+	const map_t *map;
+	const texture_t *textures;
+	const lightmap_t *lightmap;
+} world_t;
+
+/**
+ * struct minimap_s - The minimap of a view and its cached tile layer.
+ *
+ * @scale: Minimap pixels per world unit; changing it zooms the minimap.
+ * @origin_x: Left edge of the visible window, in minimap pixels.
+ * @origin_y: Top edge of the visible window, in minimap pixels.
+ * @width: Width of the visible window, in screen pixels.
+ * @height: Height of the visible window, in screen pixels.
+ * @layer: The map tiles rasterized at @scale, or NULL.
+ * @layer_capacity: The number of pixels @layer can hold.
+ * @layer_x: Left edge of the area held by @layer, in minimap pixels.
+ * @layer_y: Top edge of the area held by @layer, in minimap pixels.
+ * @layer_width: Width of the area held by @layer.
+ * @layer_height: Height of the area held by @layer.
+ * @layer_map: Pointer to the map @layer was rasterized from.
+ * @layer_version: The version of @layer_map @layer was rasterized from.
+ * @layer_scale: The scale @layer was rasterized at.
+ *
+ * Description: The tiles never change between frames, so they are drawn
+ * once into @layer, which covers the visible window plus a margin, and
+ * copied into the frame row by row. The layer is only redrawn when the
+ * map, the scale, or a window leaving the margin invalidates it.
+ */
+typedef struct minimap_s
+{
+	float scale;
+	int origin_x;
+	int origin_y;
+	int width;
+	int height;
+	color_t *layer;
+	size_t layer_capacity;
+	int layer_x;
+	int layer_y;
+	int layer_width;
+	int layer_height;
+	const map_t *layer_map;
+	unsigned int layer_version;
+	float layer_scale;
+} minimap_t;
+
+/**
+ * struct wall_span_s - The setup shared by adjacent columns of a wall.
+ *
+ * @id: The texture index of the wall, as stored in the map.
+ * @vertical: Whether the wall was hit on a vertical grid line.
+ * @texture: The texture of the wall.
+ * @shade: The table shading every texel channel of the span, or NULL.
+ */
+typedef struct wall_span_s
+{
+	int id;
+	bool vertical;
+	const texture_t *texture;
+	const unsigned char *shade;
+} wall_span_t;
+
+/**
+ * struct view_history_s - The last frame of a view, kept for reprojection.
+ *
+ * @pixels: The scene of the last frame, without the minimap, row by row.
+ * @hit_x: The x-coordinate of the wall hit of each column.
+ * @hit_y: The y-coordinate of the wall hit of each column.
+ * @texture: The texture of the wall hit of each column.
+ * @was_hit_vertical: Whether each column hit a vertical grid line.
+ * @source: For each column of the current frame, the column of @pixels
+ * it is reprojected from, or -1 if it was cast.
+ * @scale: For each reprojected column, its height over the height of
+ * its @source column.
+ * @x: The x-coordinate of the camera of the last frame.
+ * @y: The y-coordinate of the camera of the last frame.
+ * @angle: The rotation angle of the camera of the last frame.
+ * @map: Pointer to the map of the last frame.
+ * @map_version: The version of @map in the last frame.
+ * @phase: The number of frames kept, which picks the columns to cast.
+ * @reused: The number of columns reprojected in the current frame.
+ * @valid: Whether the fields above describe the last frame.
+ * @active: Whether the current frame reprojects columns.
+ */
+typedef struct view_history_s
+{
+	color_t *pixels;
+	float *hit_x;
+	float *hit_y;
+	int *texture;
+	unsigned char *was_hit_vertical;
+	int *source;
+	float *scale;
+	float x;
+	float y;
+	float angle;
+	const map_t *map;
+	unsigned int map_version;
+	unsigned int phase;
+	int reused;
+	bool valid;
+	bool active;
+} view_history_t;
+
+/**
+ * struct ray_cache_s - Rays cast from a camera position on a fixed grid
+ * of angles, reused while the camera only turns.
+ *
+ * @probes: The ray of each of the RAY_CACHE_STEPS angles of the grid,
+ * the n-th one at n * 2 * PI / RAY_CACHE_STEPS; a texture of -1 marks a
+ * ray not cast yet.
+ * @x: The x-coordinate the rays are cast from.
+ * @y: The y-coordinate the rays are cast from.
+ * @map: Pointer to the map the rays are cast through.
+ * @map_version: The version of @map the rays saw.
+ * @valid: Whether the fields above describe the rays.
+ * @cast: The number of rays of the grid cast in the current frame.
+ */
+typedef struct ray_cache_s
+{
+	ray_buffer_t probes;
+	float x;
+	float y;
+	const map_t *map;
+	unsigned int map_version;
+	bool valid;
+	int cast;
+} ray_cache_t;
+
+/**
+ * struct frame_stats_s - The work done to produce a frame.
+ *
+ * @rays_cast: The rays traced through the grid.
+ * @cells_visited: The grid cells those rays checked for a wall.
+ * @wall_pixels: The wall pixels written.
+ * @floor_pixels: The floor pixels written.
+ * @ceiling_pixels: The ceiling pixels written.
+ * @texel_fetches: The texels read by the walls, floor and ceiling.
+ * @pixel_calls: The draw_pixel() calls.
+ * @uploaded_bytes: The bytes of the frame sent to the screen.
+ * @late_frames: The frames that missed their deadline.
+ * @dropped_frames: The frames a recording or the frame stream skipped.
+ * @input_events: The key presses and releases the frame was the first
+ * to show.
+ * @input_latency_us: The microseconds from each of those events to the
+ * frame being presented, summed.
+ * @stream_bytes: The bytes the frame stream sent while the frame was made.
+ * @stream_encode_us: The microseconds it spent encoding them.
+ *
+ * Description: The engine fills the first seven counters of each view,
+ * the game the others. Every field is 64 bits wide, so the struct can
+ * be shared with other processes as is.
+ */
+typedef struct frame_stats_s
+{
+	uint64_t rays_cast;
+	uint64_t cells_visited;
+	uint64_t wall_pixels;
+	uint64_t floor_pixels;
+	uint64_t ceiling_pixels;
+	uint64_t texel_fetches;
+	uint64_t pixel_calls;
+	uint64_t uploaded_bytes;
+	uint64_t late_frames;
+	uint64_t dropped_frames;
+	uint64_t input_events;
+	uint64_t input_latency_us;
+	uint64_t stream_bytes;
+	uint64_t stream_encode_us;
+} frame_stats_t;
+
+/**
+ * struct latency_hist_s - A distribution of latencies.
+ *
+ * @buckets: The number of latencies in each LATENCY_BUCKET_US wide
+ * range from 0; the last one also counts every longer latency.
+ * @count: The number of latencies recorded.
+ * @total_us: Their sum, in microseconds.
+ * @max_us: The longest, in microseconds.
+ */
+typedef struct latency_hist_s
+{
+	uint32_t buckets[LATENCY_BUCKETS];
+	uint64_t count;
+	uint64_t total_us;
+	uint64_t max_us;
+} latency_hist_t;
+
+/**
+ * enum perf_event_e - The counters read around each stage of a frame.
+ *
+ * @PERF_TASK_CLOCK: The nanoseconds the thread ran, a software counter
+ * leading the group, so stages are timed even without hardware counters.
+ * @PERF_CYCLES: The processor cycles.
+ * @PERF_INSTRUCTIONS: The instructions retired.
+ * @PERF_L1D_MISSES: The reads missing the level 1 data cache.
+ * @PERF_LLC_MISSES: The references missing the last level cache.
+ * @PERF_BRANCH_MISSES: The mispredicted branches.
+ * @PERF_EVENTS: The number of counters.
+ */
+typedef enum perf_event_e
+{
+	PERF_TASK_CLOCK,
+	PERF_CYCLES,
+	PERF_INSTRUCTIONS,
+	PERF_L1D_MISSES,
+	PERF_LLC_MISSES,
+	PERF_BRANCH_MISSES,
+	PERF_EVENTS
+} perf_event_t;
+
+/**
+ * enum perf_stage_e - The stages of a frame the counters are split into.
+ *
+ * @PERF_STAGE_INPUT: Waiting for the frame, reloads and reading the keys.
+ * @PERF_STAGE_MOVE: Moving the player, or playing on the server.
+ * @PERF_STAGE_CAST: cast_all_rays().
+ * @PERF_STAGE_FLOOR: Clearing the frame and drawing the floor.
+ * @PERF_STAGE_CEILING: Drawing the ceiling.
+ * @PERF_STAGE_WALLS: Drawing the walls.
+ * @PERF_STAGE_MINIMAP: Drawing the minimap.
+ * @PERF_STAGE_PRESENT: Recording, streaming, uploading and presenting.
+ * @PERF_STAGES: The number of stages.
+ */
+typedef enum perf_stage_e
+{
+	PERF_STAGE_INPUT,
+	PERF_STAGE_MOVE,
+	PERF_STAGE_CAST,
+	PERF_STAGE_FLOOR,
+	PERF_STAGE_CEILING,
+	PERF_STAGE_WALLS,
+	PERF_STAGE_MINIMAP,
+	PERF_STAGE_PRESENT,
+	PERF_STAGES
+} perf_stage_t;
+
+/**
+ * struct perf_counters_s - Per-stage counters of the calling thread.
+ *
+ * @fds: The counter of each event, or -1 if it cannot be opened here;
+ * the task clock leads the group, which is read at once.
+ * @slots: The position of each event in a read of the group, or -1.
+ * @count: The number of events open.
+ * @error: The errno of the task clock, when it could not be opened.
+ * @active: Set when the group is counting.
+ * @last: The scaled counts at the last mark.
+ * @frame: The counts of each stage in the current frame.
+ * @total: The counts of each stage, summed over @frames frames.
+ * @frames: The number of frames ended.
+ *
+ * Description: Only the thread that opened the counters is counted, so
+ * stages run on a thread pool are left out. When the processor runs out
+ * of counters the group is multiplexed and the counts are scaled by the
+ * time it was scheduled.
+ */
+typedef struct perf_counters_s
+{
+	int fds[PERF_EVENTS];
+	int slots[PERF_EVENTS];
+	int count;
+	int error;
+	bool active;
+	uint64_t last[PERF_EVENTS];
+	uint64_t frame[PERF_STAGES][PERF_EVENTS];
+	uint64_t total[PERF_STAGES][PERF_EVENTS];
+	uint64_t frames;
+} perf_counters_t;
+
+/**
+ * struct view_s - A camera rendering into its own framebuffer.
+ *
+ * @world: Pointer to the shared world being rendered.
+ * @player: Pointer to the player_t whose position and angle the view uses.
+ * @frame: The framebuffer the view renders into.
+ * @arena: The arena holding the per-frame data of the view.
+ * @rays: The rays of the current frame, carved from @arena.
+ * @overlay: Batch of 2D primitives drawn over the frame, carved from @arena.
+ * @dist_proj_plane: Distance from the eye to the projection plane.
+ * @enable_minimap: A flag to draw the minimap on top of the scene.
+ * @minimap: The state of the minimap of the view.
+ * @interleave: 1 to cast and shade every column every frame, or N to
+ * only do so for one column in N and reproject the others.
+ * @history: The last frame, kept while @interleave is above 1.
+ * @darken: The table darkening walls hit on a vertical grid line when
+ * the world has no lightmap.
+ * @span_columns: The number of columns of the last frame whose wall was
+ * confirmed from a wall span, between two cast columns or two rays of
+ * @ray_cache, instead of a grid traversal.
+ * @ray_cache: The rays cast from the camera position, while it stays.
+ * @stats: The counters of the current frame, reset by cast_all_rays().
+ * @textures_hit: One bit per texture index the current frame shows, set
+ * by cast_all_rays() for texture_pool_update().
+ * @perf: The counters render_view() marks its stages on, drawing the
+ * floor, ceiling and walls in separate passes, or NULL. Only set on a
+ * view rendered by the thread that opened them.
+ *
+ * Description: Everything a view writes to lives in the view itself, so
+ * distinct views can be cast and rendered concurrently, and each keeps
+ * its counters to itself until they are summed with frame_stats_add().
+ */
+typedef struct view_s
+{
+	const world_t *world;
+	const player_t *player;
+	framebuffer_t frame;
+	frame_arena_t arena;
+	ray_buffer_t rays;
+	draw_batch_t overlay;
+	float dist_proj_plane;
+	bool enable_minimap;
+	minimap_t minimap;
+	int interleave;
+	view_history_t history;
+	unsigned char darken[256];
+	int span_columns;
+	ray_cache_t ray_cache;
+	frame_stats_t stats;
+	uint32_t textures_hit[TEXTURE_HIT_WORDS];
+	perf_counters_t *perf;
+} view_t;
+
+/**
+ * struct thread_pool_s - A fixed set of workers running parallel loops.
+ *
+ * @threads: Array of the worker thread handles.
+ * @num_threads: The number of workers (the caller thread is not counted).
+ * @lock: Mutex protecting every field below.
+ * @work_ready: Signalled when a new loop is published.
+ * @work_done: Signalled when the last item of a loop completes.
+ * @job: The function run for every item of the current loop.
+ * @job_arg: The argument passed to @job.
+ * @job_count: The number of items in the current loop.
+ * @next_index: The next item to be handed out.
+ * @pending: The number of items not finished yet.
+ * @generation: Incremented every time a new loop is published.
+ * @shutting_down: Set when the workers have to exit.
+ */
+typedef struct thread_pool_s
+{
+	pthread_t *threads;
+	int num_threads;
+	pthread_mutex_t lock;
+	pthread_cond_t work_ready;
+	pthread_cond_t work_done;
+	void (*job)(void *, int);
+	void *job_arg;
+	int job_count;
+	int next_index;
+	int pending;
+	unsigned long generation;
+	bool shutting_down;
+} thread_pool_t;
+
+/**
+ * struct env_action_s - The input applied to one environment for a step.
+ *
+ * @walk_direction: -1 to walk backward, 1 to walk forward, 0 to stand.
+ * @turn_direction: -1 to turn left, 1 to turn right, 0 to keep the angle.
+ */
+typedef struct env_action_s
+{
+	int walk_direction;
+	int turn_direction;
+} env_action_t;
+
+/**
+ * struct env_state_s - Everything that changes while an environment runs.
+ *
+ * @player: The player_t the environment moves.
+ * @step_count: The number of steps taken since the last restore.
+ *
+ * Description: The state holds no pointers, so snapshotting or restoring
+ * an environment is a plain struct copy.
+ */
+typedef struct env_state_s
+{
+	player_t player;
+	unsigned long step_count;
+} env_state_t;
+
+/**
+ * struct env_batch_s - A batch of environments stepped in lockstep.
+ *
+ * @world: Pointer to the world shared by every environment.
+ * @pool: Pointer to the thread_pool_t used to step, or NULL.
+ * @count: The number of environments.
+ * @states: Array of @count environment states.
+ * @views: Array of @count views casting from the matching state.
+ * @observations: The @count rendered frames, or NULL without rendering.
+ * @actions: The actions of the step in progress.
+ * @delta_time: The time step of the step in progress.
+ * @render: Whether the step in progress renders observations.
+ */
+typedef struct env_batch_s
+{
+	const world_t *world;
+	thread_pool_t *pool;
+	int count;
+	env_state_t *states;
+	view_t *views;
+	color_t *observations;
+	const env_action_t *actions;
+	float delta_time;
+	bool render;
+} env_batch_t;
+
+/**
+ * enum capture_format_e - The output formats of a frame capture.
+ *
+ * @CAPTURE_Y4M: One YUV4MPEG2 stream, 4:2:0 chroma.
+ * @CAPTURE_RAW: One stream of packed 8-bit RGB frames.
+ * @CAPTURE_PPM: One binary PPM file per frame.
+ * @CAPTURE_QOI: One QOI file per frame.
+ */
+typedef enum capture_format_e
+{
+	CAPTURE_Y4M,
+	CAPTURE_RAW,
+	CAPTURE_PPM,
+	CAPTURE_QOI
+} capture_format_t;
+
+/**
+ * struct capture_s - Frames recorded to disk by a background thread.
+ *
+ * @format: The output format, chosen from the extension of @path.
+ * @path: The output file, or the template of numbered frame files.
+ * @width: The width of the captured frames.
+ * @height: The height of the captured frames.
+ * @fps: The frame rate written to stream headers.
+ * @slots: CAPTURE_RING_SIZE frames of @width * @height pixels.
+ * @scratch: Encoding buffer owned by the writer thread.
+ * @stream: The open output stream for Y4M and raw captures.
+ * @head: The number of frames queued so far.
+ * @tail: The number of frames the writer has finished with.
+ * @written: The number of frames written successfully.
+ * @dropped: The number of frames skipped because the ring was full.
+ * @failed: Set by the writer once an output error occurred.
+ * @stopping: Set when no more frames will be queued.
+ * @lock: Protects @head, @tail and @stopping.
+ * @frame_ready: Signalled when a frame is queued or capture stops.
+ * @writer: The writer thread.
+ *
+ * Description: Queueing a frame costs one memcpy into a free slot; the
+ * encoding and the I/O happen on @writer. When the disk falls behind and
+ * every slot is in use, new frames are dropped and counted instead of
+ * stalling the caller.
+ */
+typedef struct capture_s
+{
+	capture_format_t format;
+	char *path;
+	int width;
+	int height;
+	int fps;
+	color_t *slots;
+	unsigned char *scratch;
+	FILE *stream;
+	unsigned long head;
+	unsigned long tail;
+	unsigned long written;
+	unsigned long dropped;
+	bool failed;
+	bool stopping;
+	pthread_mutex_t lock;
+	pthread_cond_t frame_ready;
+	pthread_t writer;
+} capture_t;
+
+/**
+ * struct frame_stream_s - Frames sent over a socket by a background thread.
+ *
+ * @address: The receiver, as host:port or unix:path.
+ * @fd: The connected socket.
+ * @width: The width of the streamed frames.
+ * @height: The height of the streamed frames.
+ * @slots: STREAM_RING_SIZE frames of @width * @height pixels.
+ * @previous: The last frame sent, as the receiver holds it.
+ * @scratch: Encoding buffer owned by the sender thread.
+ * @keyed: Set once @previous holds a frame; until then every tile is sent.
+ * @head: The number of frames queued so far.
+ * @tail: The number of frames the sender has finished with.
+ * @sent: The number of frames sent.
+ * @dropped: The number of frames skipped because the ring was full.
+ * @bytes: The bytes sent.
+ * @encode_ns: The nanoseconds spent encoding the frames sent.
+ * @failed: Set by the sender once the connection was lost.
+ * @stopping: Set when no more frames will be queued.
+ * @lock: Protects @head, @tail, @sent, @bytes, @encode_ns and @stopping.
+ * @frame_ready: Broadcast when a frame is queued or sent, or the stream
+ * stops.
+ * @sender: The sender thread.
+ *
+ * Description: Works like capture_t: queueing a frame costs one memcpy,
+ * and a frame finding every slot taken, because the receiver or the
+ * network falls behind, is skipped rather than waited for. Each frame
+ * only carries the STREAM_TILE square tiles that differ from @previous.
+ */
+typedef struct frame_stream_s
+{
+	char *address;
+	int fd;
+	int width;
+	int height;
+	color_t *slots;
+	color_t *previous;
+	unsigned char *scratch;
+	bool keyed;
+	unsigned long head;
+	unsigned long tail;
+	unsigned long sent;
+	unsigned long dropped;
+	uint64_t bytes;
+	uint64_t encode_ns;
+	bool failed;
+	bool stopping;
+	pthread_mutex_t lock;
+	pthread_cond_t frame_ready;
+	pthread_t sender;
+} frame_stream_t;
+
+/**
+ * struct stream_mirror_s - The receiving end of a frame stream.
+ *
+ * @fd: The connected socket, owned by the mirror.
+ * @width: The width of the frames.
+ * @height: The height of the frames.
+ * @tile: The size of the tiles, STREAM_TILE for this version.
+ * @pixels: The frame as last received, @width pixels per row.
+ * @data: Buffer receiving one encoded frame.
+ * @capacity: The size of @data, the largest frame the sender can send.
+ * @frame: The number of the last frame received.
+ * @tiles: The number of tiles it changed.
+ * @bytes: Its size on the wire, headers included.
+ */
+typedef struct stream_mirror_s
+{
+	int fd;
+	int width;
+	int height;
+	int tile;
+	color_t *pixels;
+	unsigned char *data;
+	size_t capacity;
+	unsigned long frame;
+	int tiles;
+	size_t bytes;
+} stream_mirror_t;
+
+/**
+ * struct nav_field_s - A flow field leading every cell of a map to a goal.
+ *
+ * @map: Pointer to the map the field covers.
+ * @goal: The index of the goal cell, row * cols + col.
+ * @cost: The integration field: the cost of the shortest path from each
+ * cell to @goal, or NAV_UNREACHABLE.
+ * @direction: The direction field: the neighbour to step to from each
+ * cell, 0 (east) to 7 (north-east) clockwise, or NAV_NONE.
+ * @valid: True once the field has been computed.
+ *
+ * Description: Steps cost NAV_STRAIGHT_COST, or NAV_DIAGONAL_COST for a
+ * diagonal, which may not cut the corner of a wall. A field is computed
+ * once per goal and only read afterwards, so any number of agents on any
+ * number of threads can steer with it at the cost of a lookup.
+ */
+typedef struct nav_field_s
+{
+	const map_t *map;
+	int goal;
+	uint32_t *cost;
+	unsigned char *direction;
+	bool valid;
+} nav_field_t;
+
+/**
+ * struct nav_seed_s - A cell given a cost before a field is propagated.
+ *
+ * @cell: The index of the cell.
+ * @cost: The cost of the cell.
+ */
+typedef struct nav_seed_s
+{
+	int cell;
+	uint32_t cost;
+} nav_seed_t;
+
+/**
+ * struct nav_queue_s - The bucket queue of a flow field propagation.
+ *
+ * @cells: NAV_BUCKETS growable stacks of cells; cost c sits in bucket
+ * c % NAV_BUCKETS.
+ * @count: The number of cells in each bucket.
+ * @capacity: The number of cells each bucket can hold.
+ * @size: The number of cells in every bucket.
+ * @current: The cost being popped.
+ * @seeds: Cells sorted by cost, fed in as @current reaches them.
+ * @seed_count: The number of @seeds.
+ * @next_seed: The index of the first seed not fed in yet.
+ *
+ * Description: A step costs at most NAV_DIAGONAL_COST, so every queued
+ * cost lies within NAV_BUCKETS of @current and pushing or popping is
+ * O(1), unlike a binary heap.
+ */
+typedef struct nav_queue_s
+{
+	int *cells[NAV_BUCKETS];
+	int count[NAV_BUCKETS];
+	int capacity[NAV_BUCKETS];
+	long size;
+	uint32_t current;
+	const nav_seed_t *seeds;
+	int seed_count;
+	int next_seed;
+} nav_queue_t;
+
+/**
+ * struct nav_list_s - A growable list of cells.
+ *
+ * @cells: The indices of the cells.
+ * @count: The number of cells in the list.
+ * @capacity: The number of cells @cells can hold.
+ */
+typedef struct nav_list_s
+{
+	int *cells;
+	int count;
+	int capacity;
+} nav_list_t;
+
+/**
+ * struct nav_node_s - A cell reached by a path search.
+ *
+ * @cell: The index of the cell.
+ * @parent: The index of the node the best path came from, or -1.
+ * @g: The cost of the best path from the start found so far.
+ * @closed: True once the cell has been expanded.
+ */
+typedef struct nav_node_s
+{
+	int cell;
+	int parent;
+	uint32_t g;
+	bool closed;
+} nav_node_t;
+
+/**
+ * struct nav_open_s - An entry of the open list of a path search.
+ *
+ * @key: The estimated cost of a path through the node in the high 32
+ * bits, and the estimated cost left to the goal in the low 32 bits, so
+ * ties go to the node closest to the goal.
+ * @node: The index of the node in the nodes of the search.
+ */
+typedef struct nav_open_s
+{
+	uint64_t key;
+	int node;
+} nav_open_t;
+
+/**
+ * struct nav_search_s - The reusable memory of A* path searches.
+ *
+ * @nodes: The nodes reached by the current search.
+ * @node_count: The number of @nodes.
+ * @node_capacity: The number of nodes @nodes can hold.
+ * @table: Open-addressing hash table from cells to @nodes, -1 if empty.
+ * @table_capacity: The number of slots of @table, a power of two.
+ * @heap: The open list, a binary heap ordered by key.
+ * @heap_count: The number of entries in @heap.
+ * @heap_capacity: The number of entries @heap can hold.
+ * @path: The cells of the last path found, from start to goal.
+ * @path_count: The number of cells in @path.
+ * @path_capacity: The number of cells @path can hold.
+ *
+ * Description: Nodes are only created for the cells a search reaches,
+ * so memory follows the search and not the map, which matters with jump
+ * point search on maps of millions of cells. A zeroed struct is ready to
+ * use; give each thread its own.
+ */
+typedef struct nav_search_s
+{
+	nav_node_t *nodes;
+	int node_count;
+	int node_capacity;
+	int *table;
+	int table_capacity;
+	nav_open_t *heap;
+	int heap_count;
+	int heap_capacity;
+	int *path;
+	int path_count;
+	int path_capacity;
+} nav_search_t;
+
+/**
+ * struct pvs_s - Which parts of a map can see each other.
+ *
+ * @rows: The number of rows of the map.
+ * @cols: The number of columns of the map.
+ * @shift: Clusters are squares of 1 << @shift cells on a side; 0 makes
+ * the set exact to the cell.
+ * @radius: How far visibility is kept, in clusters on each axis; clusters
+ * farther away count as visible.
+ * @cluster_rows: The number of rows of clusters.
+ * @cluster_cols: The number of columns of clusters.
+ * @window: 2 * @radius + 1, the side of the square of clusters around a
+ * cluster that its bits cover.
+ * @row_bytes: The number of bytes of the bits of one cluster.
+ * @map_hash: The hash of the map the set was built from.
+ * @bits: @row_bytes per cluster; bit (dr + @radius) * @window +
+ * (dc + @radius) of a cluster says whether the cluster @dr rows and @dc
+ * columns away is visible from it.
+ *
+ * Description: Two clusters see each other when the segment between the
+ * centers of a cell of each, one of them open, only crosses open cells.
+ * Storing a window around each cluster instead of a bit for every
+ * cluster of the map keeps the set linear in the size of the map.
+ */
+typedef struct pvs_s
+{
+	int rows;
+	int cols;
+	int shift;
+	int radius;
+	int cluster_rows;
+	int cluster_cols;
+	int window;
+	size_t row_bytes;
+	uint64_t map_hash;
+	unsigned char *bits;
+} pvs_t;
+
+/**
+ * struct pvs_header_s - The header of a visibility file.
+ *
+ * @magic: PVS_MAGIC, NUL terminated.
+ * @version: PVS_VERSION of the writer.
+ * @shift: The @shift of the pvs_t.
+ * @radius: The @radius of the pvs_t.
+ * @rows: The number of rows of the map.
+ * @cols: The number of columns of the map.
+ * @reserved: Zero.
+ * @map_hash: The hash of the map the bits were built from.
+ */
+typedef struct pvs_header_s
+{
+	char magic[8];
+	uint32_t version;
+	uint32_t shift;
+	uint32_t radius;
+	uint32_t rows;
+	uint32_t cols;
+	uint32_t reserved;
+	uint64_t map_hash;
+} pvs_header_t;
+
+/**
+ * struct watch_s - Files watched for changes with inotify.
+ *
+ * @fd: The inotify descriptor, non-blocking, or -1.
+ * @count: The number of files watched.
+ * @paths: The files watched; the strings belong to the caller.
+ * @dirs: The watch descriptor of the directory of each file.
+ *
+ * Description: The directories are watched rather than the files, so a
+ * file an editor saves by renaming a new one over it is still seen.
+ */
+typedef struct watch_s
+{
+	int fd;
+	int count;
+	const char *paths[WATCH_MAX_FILES];
+	int dirs[WATCH_MAX_FILES];
+} watch_t;
+
+/**
+ * struct map_reload_s - A map file read again by a background thread.
+ *
+ * @path: The map file.
+ * @live: Pointer to the map in use, only read by the thread.
+ * @parsed: The map read from @path.
+ * @changed: The indices of the cells of @parsed that differ from @live.
+ * @count: The number of @changed cells, or -1 if the size of the map
+ * changed or the file could not be read.
+ * @capacity: The number of indices @changed can hold.
+ * @valid: Whether @path was read successfully.
+ * @running: Whether a thread was started and not joined yet.
+ * @done: Set by the thread when it is finished.
+ * @lock: Protects @done.
+ * @thread: The thread reading the map.
+ *
+ * Description: Reading and comparing a large map takes long, so it runs
+ * beside the game; applying the result only copies the changed cells.
+ */
+typedef struct map_reload_s
+{
+	const char *path;
+	const map_t *live;
+	map_t parsed;
+	int *changed;
+	int count;
+	int capacity;
+	bool valid;
+	bool running;
+	bool done;
+	pthread_mutex_t lock;
+	pthread_t thread;
+} map_reload_t;
+
+/**
+ * struct net_packet_s - A datagram waiting in a net_link_t.
+ *
+ * @due: The time to send it at, in seconds.
+ * @to: The address to send it to.
+ * @size: The number of bytes of @data.
+ * @data: The datagram.
+ */
+typedef struct net_packet_s
+{
+	double due;
+	struct sockaddr_in to;
+	int size;
+	unsigned char data[NET_MAX_PACKET];
+} net_packet_t;
+
+/**
+ * struct net_link_s - A UDP socket that can simulate a bad network.
+ *
+ * @fd: The socket, non-blocking, or -1.
+ * @loss: The fraction of outgoing datagrams to drop, 0 to 1.
+ * @latency: The delay added to every outgoing datagram, in seconds.
+ * @jitter: The most extra delay drawn for each datagram, in seconds;
+ * datagrams may overtake each other.
+ * @seed: The state of the generator drawing losses and delays.
+ * @queue: NET_LINK_QUEUE datagrams waiting for their time.
+ * @queued: The number of datagrams in @queue.
+ * @sent_bytes: The number of bytes handed to the socket.
+ * @sent_packets: The number of datagrams handed to the socket.
+ * @dropped: The number of datagrams lost on purpose or for lack of room.
+ *
+ * Description: With no loss, latency or jitter, datagrams are sent as
+ * soon as they are queued and @queue is never allocated.
+ */
+typedef struct net_link_s
+{
+	int fd;
+	float loss;
+	double latency;
+	double jitter;
+	uint32_t seed;
+	net_packet_t *queue;
+	int queued;
+	unsigned long sent_bytes;
+	unsigned long sent_packets;
+	unsigned long dropped;
+} net_link_t;
+
+/**
+ * struct net_entity_s - The quantized state of one player slot.
+ *
+ * @x: The x-coordinate, in 1 / NET_POSITION_SCALE units.
+ * @y: The y-coordinate, in 1 / NET_POSITION_SCALE units.
+ * @angle: The rotation angle, in 1 / 65536 turns.
+ * @active: Whether a player holds the slot.
+ */
+typedef struct net_entity_s
+{
+	uint32_t x;
+	uint32_t y;
+	uint16_t angle;
+	bool active;
+} net_entity_t;
+
+/**
+ * struct net_snapshot_s - The state of every player slot at a tick.
+ *
+ * @tick: The server tick, from 1; 0 marks an empty history entry.
+ * @entities: The NET_MAX_PLAYERS slots.
+ */
+typedef struct net_snapshot_s
+{
+	uint32_t tick;
+	net_entity_t entities[NET_MAX_PLAYERS];
+} net_snapshot_t;
+
+/**
+ * struct net_peer_s - A client as seen by the server.
+ *
+ * @addr: The address its datagrams come from.
+ * @connected: Whether the slot of the peer is in use.
+ * @acked: The newest snapshot tick the client confirmed, or 0.
+ * @input_seq: The sequence number of the newest input applied.
+ * @heard: The time the client was last heard from, in seconds.
+ * @sent_bytes: The number of snapshot bytes sent to the client.
+ */
+typedef struct net_peer_s
+{
+	struct sockaddr_in addr;
+	bool connected;
+	uint32_t acked;
+	uint32_t input_seq;
+	double heard;
+	unsigned long sent_bytes;
+} net_peer_t;
+
+/**
+ * struct net_server_s - The authoritative simulation of a shared maze.
+ *
+ * @map: Pointer to the map the players move in.
+ * @link: The socket the clients talk to.
+ * @tick_rate: The number of ticks per second.
+ * @tick: The number of ticks simulated.
+ * @spawn_x: The x-coordinate new players start at.
+ * @spawn_y: The y-coordinate new players start at.
+ * @players: The player of each slot.
+ * @peers: The client of each slot.
+ * @history: The last NET_HISTORY snapshots, by tick % NET_HISTORY.
+ *
+ * Description: Every tick moves the players by the input their client
+ * last sent and sends each client the new snapshot as a delta from the
+ * newest one it acknowledged, or whole if that one left @history.
+ */
+typedef struct net_server_s
+{
+	const map_t *map;
+	net_link_t link;
+	float tick_rate;
+	uint32_t tick;
+	float spawn_x;
+	float spawn_y;
+	player_t players[NET_MAX_PLAYERS];
+	net_peer_t peers[NET_MAX_PLAYERS];
+	net_snapshot_t history[NET_HISTORY];
+} net_server_t;
+
+/**
+ * struct net_client_s - A client of a net_server_t.
+ *
+ * @link: The socket talking to the server.
+ * @server: The address of the server.
+ * @tick_rate: The tick rate of the server.
+ * @slot: The slot of the client on the server, or -1 before the first
+ * snapshot.
+ * @input_seq: The sequence number of the last input sent.
+ * @latest: The newest snapshot tick received, or 0.
+ * @latest_time: The time @latest arrived, in seconds.
+ * @received_bytes: The number of snapshot bytes received.
+ * @history: The last NET_HISTORY snapshots, by tick % NET_HISTORY.
+ */
+typedef struct net_client_s
+{
+	net_link_t link;
+	struct sockaddr_in server;
+	float tick_rate;
+	int slot;
+	uint32_t input_seq;
+	uint32_t latest;
+	double latest_time;
+	unsigned long received_bytes;
+	net_snapshot_t history[NET_HISTORY];
+} net_client_t;
+
+/**
+ * struct stats_shared_s - The counters a process publishes in shared
+ * memory.
+ *
+ * @magic: STATS_MAGIC once the segment is set up.
+ * @version: STATS_VERSION, the version of this layout.
+ * @sequence: Odd while the publisher updates the segment; a reader
+ * retries when it is odd or changed during its copy.
+ * @pid: The publishing process.
+ * @frames: The number of frames published.
+ * @last: The counters of the last frame.
+ * @total: The counters summed over every frame.
+ */
+typedef struct stats_shared_s
+{
+	uint32_t magic;
+	uint32_t version;
+	volatile uint32_t sequence;
+	int32_t pid;
+	uint64_t frames;
+	frame_stats_t last;
+	frame_stats_t total;
+} stats_shared_t;
+
+/**
+ * struct stats_export_s - A shared-memory segment counters are published
+ * to.
+ *
+ * @shared: The mapped segment, or NULL.
+ * @name: The POSIX shared-memory name of the segment.
+ */
+typedef struct stats_export_s
+{
+	stats_shared_t *shared;
+	char name[64];
+} stats_export_t;
+
+bool env_batch_init(env_batch_t *, const world_t *, thread_pool_t *,
+		int, int, int);
+void env_batch_free(env_batch_t *);
+void env_batch_step(env_batch_t *, const env_action_t *, float, bool);
+void env_batch_snapshot(const env_batch_t *, int, env_state_t *);
+void env_batch_restore(env_batch_t *, int, const env_state_t *);
+
+int nav_neighbor(const map_t *, int, int);
+uint32_t nav_octile(const map_t *, int, int);
+bool nav_field_steer(const nav_field_t *, float, float, float *);
+bool nav_field_init(nav_field_t *, const map_t *, int);
+void nav_field_free(nav_field_t *);
+bool nav_field_compute(nav_field_t *);
+bool nav_fields_compute(thread_pool_t *, nav_field_t *, int);
+bool nav_field_update(nav_field_t *, const int *, int);
+bool nav_list_push(nav_list_t *, int);
+bool nav_list_push_around(nav_list_t *, const map_t *, int);
+bool nav_queue_push(nav_queue_t *, int, uint32_t);
+bool nav_queue_pop(nav_queue_t *, int *, uint32_t *);
+void nav_queue_free(nav_queue_t *);
+bool nav_field_propagate(nav_field_t *, const nav_seed_t *, int);
+int nav_search_node(nav_search_t *, int);
+bool nav_heap_push(nav_search_t *, int, uint32_t, uint32_t);
+int nav_heap_pop(nav_search_t *);
+void nav_search_free(nav_search_t *);
+bool nav_jps_expand(nav_search_t *, const map_t *, int, int);
+int nav_find_path(nav_search_t *, const map_t *, int, int);
+
+bool pvs_layout(pvs_t *, const map_t *, int, int);
+bool pvs_build(pvs_t *, const map_t *, int, int);
+void pvs_free(pvs_t *);
+bool pvs_visible(const pvs_t *, int, int);
+int pvs_list(const pvs_t *, int, int *);
+uint64_t pvs_map_hash(const map_t *);
+bool pvs_save(const pvs_t *, const char *);
+bool pvs_load(pvs_t *, const char *, const map_t *);
+bool pvs_open(pvs_t *, const char *, const map_t *, int, int);
+bool map_line_of_sight(const map_t *, int, int, int, int);
+
+bool lightmap_build(lightmap_t *, const map_t *, const light_t *, int, int);
+void lightmap_free(lightmap_t *);
+void lightmap_bake(lightmap_t *, const map_t *, const map_area_t *);
+bool lightmap_update(lightmap_t *, const map_t *, const int *, int);
+void lightmap_shade_init(lightmap_t *);
+int lightmap_wall_level(const lightmap_t *, const ray_buffer_t *, int);
+int lightmap_load_lights(const char *, light_t *, int);
+
+bool capture_start(capture_t *, const char *, int, int, int);
+bool capture_frame(capture_t *, const color_t *, int);
+void capture_stop(capture_t *);
+bool capture_write_frame(capture_t *, const color_t *, unsigned long);
+bool capture_format_from_path(const char *, capture_format_t *);
+bool capture_open_stream(capture_t *);
+FILE *capture_open_frame_file(const capture_t *, unsigned long);
+size_t capture_encode_qoi(const color_t *, int, int, unsigned char *);
+unsigned char *qoi_encode_rows(const color_t *, int, int, int,
+		unsigned char *);
+size_t qoi_decode_rows(const unsigned char *, size_t, color_t *, int, int,
+		int);
+
+bool stream_start(frame_stream_t *, const char *, int, int);
+bool stream_frame(frame_stream_t *, const color_t *, int);
+void stream_stop(frame_stream_t *);
+size_t stream_frame_bound(int, int);
+size_t stream_encode_frame(frame_stream_t *, const color_t *,
+		unsigned long);
+void stream_totals(frame_stream_t *, uint64_t *, uint64_t *);
+int stream_connect(const char *);
+int stream_listen(const char *);
+bool stream_send(int, const void *, size_t);
+size_t stream_receive(int, void *, size_t);
+bool stream_mirror_open(stream_mirror_t *, int);
+int stream_mirror_read(stream_mirror_t *);
+void stream_mirror_close(stream_mirror_t *);
+
+bool texture_cache_load(texture_cache_t *, const char *,
+		const char * const *, texture_t *, int);
+bool texture_cache_save(const char *, const char * const *, int,
+		bool (*)(void *, int, texture_t *), void *);
+void texture_cache_close(texture_cache_t *);
+bool texture_atlas_build(texture_atlas_t *, const texture_t *, int);
+void texture_atlas_free(texture_atlas_t *);
+bool texture_source_stat(const char *, int64_t *, int64_t *);
+bool texture_pool_init(texture_pool_t *, int, size_t,
+		bool (*)(void *, int, unsigned int, texture_t *, bool *),
+		void *);
+void texture_pool_update(texture_pool_t *, const view_t *, int);
+void texture_pool_flush(texture_pool_t *);
+void texture_pool_invalidate(texture_pool_t *, int);
+void texture_pool_free(texture_pool_t *);
+
+void player_init(player_t *, float, float);
+void move_player(float, player_t *, const map_t *);
+void normalize_angle(float *);
+void handle_wall_collision(player_t *, const map_t *);
+void cast_all_rays(view_t *);
+void cast_ray(float, int, view_t *);
+void ray_choose_hit(view_t *, int, float, const wall_hit_data_t *);
+void cast_ray_packet(view_t *, const int *, int);
+void ray_set_hit(view_t *, int, float, float, bool, int);
+void cast_wall_span(view_t *, int, int);
+bool wall_span_same_face(const ray_buffer_t *, int, int);
+bool ray_cache_init(ray_cache_t *);
+void ray_cache_free(ray_cache_t *);
+bool ray_cache_cast(view_t *);
+void find_horizontal_intersection(float, const player_t *, const map_t *,
+		wall_hit_data_t *);
+void find_vertical_intersection(float, const player_t *, const map_t *,
+		wall_hit_data_t *);
+bool parse_map_from_file(const char *file_path, map_t *);
+void map_free(map_t *);
+bool map_reload_start(map_reload_t *, const char *, const map_t *);
+bool map_reload_poll(map_reload_t *, map_t *);
+void map_reload_free(map_reload_t *);
+bool watch_init(watch_t *, const char * const *, int);
+int watch_poll(watch_t *, bool *);
+void watch_close(watch_t *);
+bool net_link_open(net_link_t *, int);
+bool net_link_send(net_link_t *, const struct sockaddr_in *,
+		const unsigned char *, int, double);
+void net_link_flush(net_link_t *, double);
+int net_link_receive(net_link_t *, unsigned char *, struct sockaddr_in *);
+void net_link_close(net_link_t *);
+int net_snapshot_encode(const net_snapshot_t *, const net_snapshot_t *,
+		int, unsigned char *);
+bool net_snapshot_decode(const unsigned char *, int, const net_snapshot_t *,
+		net_snapshot_t *, int *);
+bool net_server_init(net_server_t *, const map_t *, int, float);
+void net_server_tick(net_server_t *, double);
+void net_server_free(net_server_t *);
+bool net_client_init(net_client_t *, const char *, int, float);
+bool net_client_send(net_client_t *, const env_action_t *, double);
+int net_client_poll(net_client_t *, double);
+bool net_client_interpolate(const net_client_t *, int, double, player_t *);
+void net_client_free(net_client_t *);
+void frame_stats_add(frame_stats_t *, const frame_stats_t *);
+void stats_hud_draw(framebuffer_t *, const frame_stats_t *,
+		const frame_stats_t *);
+bool stats_export_open(stats_export_t *, const char *);
+void stats_export_publish(stats_export_t *, const frame_stats_t *);
+void stats_export_close(stats_export_t *);
+bool stats_export_read(const char *, stats_shared_t *);
+void latency_record(latency_hist_t *, uint64_t);
+uint64_t latency_percentile(const latency_hist_t *, double);
+void latency_report(const latency_hist_t *, const char *, FILE *);
+bool perf_init(perf_counters_t *);
+void perf_mark(perf_counters_t *, perf_stage_t);
+void perf_close(perf_counters_t *);
+const char *perf_stage_name(perf_stage_t);
+void perf_frame_end(perf_counters_t *, FILE *);
+void perf_report(const perf_counters_t *, FILE *);
+bool is_inside_map(float, float, const map_t *);
+bool map_has_wall_at(float, float, const map_t *);
+int get_map_at(int, int, const map_t *);
+color_t get_tile_color(int, int, const map_t *);
+bool map_find_open_cell(float *, float *, const map_t *);
+
+bool mazegen_write(FILE *, const mazegen_t *);
+bool mazegen_write_maze(FILE *, const mazegen_t *);
+bool mazegen_emit_row(FILE *, const mazegen_t *, int,
+		const unsigned char *, char *);
+void mazegen_field_row(const mazegen_t *, int, unsigned char *, long *);
+uint64_t mazegen_hash(uint64_t, int, int);
+bool maze_rows_init(maze_rows_t *, const mazegen_t *);
+void maze_rows_free(maze_rows_t *);
+void maze_rows_link(maze_rows_t *, bool);
+void maze_rows_braid(maze_rows_t *, bool, bool);
+void maze_rows_next(maze_rows_t *);
+
+bool is_ray_facing_down(float);
+bool is_ray_facing_up(float);
+bool is_ray_facing_right(float);
+bool is_ray_facing_left(float);
+int distance_between_points(float, float, float, float);
+
+bool view_init(view_t *, const world_t *, const player_t *,
+		color_t *, int, int);
+void view_free(view_t *);
+bool view_set_interleave(view_t *, int);
+void view_history_save(view_t *);
+bool interleave_cast(view_t *);
+void interleave_render_column(view_t *, int);
+bool view_begin_frame(view_t *);
+void render_view(view_t *);
+void render_cameras(thread_pool_t *, view_t *, int);
+
+void draw_pixel(int, int, color_t, framebuffer_t *);
+void fill_color_buffer(framebuffer_t *, color_t);
+void render_textured_walls(view_t *, int);
+void wall_span_init(wall_span_t *, const view_t *, int);
+void render_wall_column(int, int, int, int, const wall_span_t *,
+		view_t *);
+void render_floor(int, int, view_t *);
+void render_ceil(int, int, view_t *);
+void render_plane(int, int, float, const texture_t *, int, view_t *);
+void darken_color_intensity(color_t *, float);
+void render_minimap(view_t *);
+void render_minimap_rays(view_t *, draw_batch_t *);
+void render_player_on_minimap(view_t *, draw_batch_t *);
+int minimap_cell_to_px(int, float);
+bool minimap_layer_update(minimap_t *, const map_t *);
+void minimap_layer_blit(const minimap_t *, framebuffer_t *);
+void minimap_free(minimap_t *);
+void draw_line(int, int, int, int, color_t, framebuffer_t *);
+void draw_rect(int, int, int, int, color_t, framebuffer_t *);
+bool draw_batch_init(draw_batch_t *, frame_arena_t *, int);
+bool draw_batch_line(draw_batch_t *, int, int, int, int, color_t);
+bool draw_batch_rect(draw_batch_t *, int, int, int, int, color_t);
+void draw_batch_flush(draw_batch_t *, framebuffer_t *);
+
+bool frame_arena_init(frame_arena_t *, size_t);
+void *frame_arena_alloc(frame_arena_t *, size_t);
+void frame_arena_reset(frame_arena_t *);
+void frame_arena_free(frame_arena_t *);
+
+bool thread_pool_init(thread_pool_t *, int);
+void thread_pool_run(thread_pool_t *, int, void (*)(void *, int), void *);
+void thread_pool_destroy(thread_pool_t *);
+
+#endif /* __MAZE_ENGINE__ */
@@ -0,0 +1,29 @@
+#include "../../headers/maze.h"
+
+/**
+ * render_camera_job - Casts and renders one view of a batch.
+ * @arg: Pointer to the first view_t of the batch.
+ * @index: The index of the view to render.
+ */
+static void render_camera_job(void *arg, int index)
+{
+	view_t *view = (view_t *)arg + index;
+
+	cast_all_rays(view);
+	render_view(view);
+}
+
+/**
+ * render_cameras - Renders independent views in parallel.
+ * @pool: Pointer to the thread_pool_t to use, or NULL to render serially.
+ * @views: Array of views to render.
+ * @count: The number of views in @views.
+ *
+ * Description: Each view is cast and rendered on a single thread, so
+ * views sharing a world never write to the same memory. Views must not
+ * share a framebuffer.
+ */
+void render_cameras(thread_pool_t *pool, view_t *views, int count)
+{
+	thread_pool_run(pool, count, render_camera_job, views);
+}
@@ -0,0 +1,172 @@
+#include "../../headers/maze.h"
+
+/**
+ * capture_writer - The main loop of the capture writer thread.
+ * @arg: Pointer to the capture_t struct being recorded.
+ *
+ * Description: Frames are written in the order they were queued. After
+ * an output error the remaining frames are still consumed, so the caller
+ * never blocks, but nothing more is written.
+ *
+ * Return: Always NULL.
+ */
+static void *capture_writer(void *arg)
+{
+	capture_t *capture = arg;
+	size_t frame_size = (size_t)capture->width * capture->height;
+	const color_t *slot;
+	unsigned long index;
+
+	pthread_mutex_lock(&capture->lock);
+	while (true)
+	{
+		while (capture->tail == capture->head && !capture->stopping)
+			pthread_cond_wait(&capture->frame_ready,
+					&capture->lock);
+		if (capture->tail == capture->head)
+			break;
+		index = capture->tail;
+		pthread_mutex_unlock(&capture->lock);
+		slot = capture->slots + index % CAPTURE_RING_SIZE * frame_size;
+		if (!capture->failed &&
+				capture_write_frame(capture, slot, index))
+			capture->written++;
+		else if (!capture->failed)
+		{
+			capture->failed = true;
+			fprintf(stderr, "Unable to write frame %lu to %s\n",
+					index, capture->path);
+		}
+		pthread_mutex_lock(&capture->lock);
+		capture->tail++;
+	}
+	pthread_mutex_unlock(&capture->lock);
+	return (NULL);
+}
+
+/**
+ * capture_release - Frees everything a capture owns.
+ * @capture: Pointer to the capture_t struct, whose writer is not running.
+ */
+static void capture_release(capture_t *capture)
+{
+	if (capture->stream)
+		fclose(capture->stream);
+	free(capture->slots);
+	free(capture->scratch);
+	free(capture->path);
+	pthread_mutex_destroy(&capture->lock);
+	pthread_cond_destroy(&capture->frame_ready);
+	memset(capture, 0, sizeof(*capture));
+}
+
+/**
+ * capture_start - Starts recording frames to disk.
+ * @capture: Pointer to the capture_t struct to initialize.
+ * @path: The output file. Its extension picks the format: .y4m and .rgb
+ * write one stream, .ppm and .qoi write one numbered file per frame next
+ * to @path, e.g. shot-000000.ppm for shot.ppm.
+ * @width: The width of the frames.
+ * @height: The height of the frames.
+ * @fps: The frame rate recorded in the Y4M header.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool capture_start(capture_t *capture, const char *path, int width,
+		int height, int fps)
+{
+	size_t frame_size = (size_t)width * height;
+
+	memset(capture, 0, sizeof(*capture));
+	pthread_mutex_init(&capture->lock, NULL);
+	pthread_cond_init(&capture->frame_ready, NULL);
+	capture->width = width;
+	capture->height = height;
+	capture->fps = fps;
+	capture->path = malloc(strlen(path) + 1);
+	/* Large enough for one frame in any of the formats */
+	capture->scratch = malloc(frame_size * 5 + 32);
+	capture->slots = malloc(frame_size * CAPTURE_RING_SIZE *
+			sizeof(color_t));
+	if (!capture_format_from_path(path, &capture->format) ||
+			!capture->path || !capture->scratch || !capture->slots)
+	{
+		fprintf(stderr, "Unable to start capturing to %s\n", path);
+		capture_release(capture);
+		return (false);
+	}
+	strcpy(capture->path, path);
+	if (!capture_open_stream(capture) ||
+			pthread_create(&capture->writer, NULL, capture_writer,
+				capture) != 0)
+	{
+		fprintf(stderr, "Unable to start capturing to %s\n", path);
+		capture_release(capture);
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * capture_frame - Queues a finished frame for the writer thread.
+ * @capture: Pointer to the capture_t struct.
+ * @pixels: The frame, of the size given to capture_start.
+ * @pitch: The number of pixels between the starts of two rows of @pixels.
+ *
+ * Description: Only one thread may queue frames. The cost is one memcpy
+ * of the frame; when every slot is still waiting for the disk the frame
+ * is counted in @capture->dropped instead. A zero-initialized capture
+ * that was never started ignores every frame.
+ *
+ * Return: True if the frame was queued, false if it was dropped.
+ */
+bool capture_frame(capture_t *capture, const color_t *pixels, int pitch)
+{
+	size_t frame_size = (size_t)capture->width * capture->height;
+	color_t *slot;
+	bool full;
+	int y;
+
+	if (!capture->slots)
+		return (false);
+	pthread_mutex_lock(&capture->lock);
+	full = capture->head - capture->tail >= CAPTURE_RING_SIZE;
+	pthread_mutex_unlock(&capture->lock);
+	if (full)
+	{
+		capture->dropped++;
+		return (false);
+	}
+	slot = capture->slots + capture->head % CAPTURE_RING_SIZE * frame_size;
+	if (pitch == capture->width)
+		memcpy(slot, pixels, frame_size * sizeof(color_t));
+	else
+		for (y = 0; y < capture->height; y++)
+			memcpy(slot + (size_t)y * capture->width,
+					pixels + (size_t)y * pitch,
+					capture->width * sizeof(color_t));
+	pthread_mutex_lock(&capture->lock);
+	capture->head++;
+	pthread_cond_signal(&capture->frame_ready);
+	pthread_mutex_unlock(&capture->lock);
+	return (true);
+}
+
+/**
+ * capture_stop - Writes the queued frames and ends a capture.
+ * @capture: Pointer to the capture_t struct. Stopping a capture that was
+ * never started, or zero-initialized, does nothing.
+ */
+void capture_stop(capture_t *capture)
+{
+	if (!capture->slots)
+		return;
+	pthread_mutex_lock(&capture->lock);
+	capture->stopping = true;
+	pthread_cond_signal(&capture->frame_ready);
+	pthread_mutex_unlock(&capture->lock);
+	pthread_join(capture->writer, NULL);
+	fprintf(stderr, "Captured %lu frames to %s, dropped %lu\n",
+			capture->written, capture->path, capture->dropped);
+	capture_release(capture);
+}
@@ -0,0 +1,130 @@
+#include "../../headers/maze.h"
+
+/**
+ * capture_pack_rgb - Converts RGBA32 pixels to packed 8-bit RGB.
+ * @pixels: The pixels to convert.
+ * @count: The number of pixels.
+ * @out: Buffer of 3 * @count bytes receiving the RGB triplets.
+ */
+static void capture_pack_rgb(const color_t *pixels, size_t count,
+		unsigned char *out)
+{
+	size_t i;
+
+	for (i = 0; i < count; i++)
+	{
+		*out++ = pixels[i] & 0xFF;
+		*out++ = (pixels[i] >> 8) & 0xFF;
+		*out++ = (pixels[i] >> 16) & 0xFF;
+	}
+}
+
+/**
+ * capture_pack_luma - Writes the full range BT.601 luma plane of a frame.
+ * @pixels: The RGBA32 frame.
+ * @count: The number of pixels.
+ * @out: Buffer of @count bytes receiving the Y plane.
+ */
+static void capture_pack_luma(const color_t *pixels, size_t count,
+		unsigned char *out)
+{
+	size_t i;
+	color_t c;
+
+	for (i = 0; i < count; i++)
+	{
+		c = pixels[i];
+		out[i] = (77 * (c & 0xFF) + 150 * ((c >> 8) & 0xFF) +
+				29 * ((c >> 16) & 0xFF) + 128) >> 8;
+	}
+}
+
+/**
+ * capture_pack_chroma - Writes the 4:2:0 chroma planes of a frame.
+ * @pixels: The RGBA32 frame.
+ * @width: The width of the frame.
+ * @height: The height of the frame.
+ * @out: Buffer receiving the U plane followed by the V plane, each of
+ * ((@width + 1) / 2) * ((@height + 1) / 2) bytes.
+ *
+ * Description: Each chroma sample averages a 2x2 block; blocks at an odd
+ * right or bottom edge repeat the last column or row.
+ */
+static void capture_pack_chroma(const color_t *pixels, int width, int height,
+		unsigned char *out)
+{
+	int cw = (width + 1) / 2, ch = (height + 1) / 2, x, y, x1, i;
+	const color_t *row0, *row1;
+	unsigned char *v = out + (size_t)cw * ch;
+	color_t c[4];
+	long r, g, b;
+
+	for (y = 0; y < ch; y++)
+	{
+		row0 = pixels + (size_t)2 * y * width;
+		row1 = 2 * y + 1 < height ? row0 + width : row0;
+		for (x = 0; x < cw; x++)
+		{
+			x1 = 2 * x + 1 < width ? 2 * x + 1 : 2 * x;
+			c[0] = row0[2 * x];
+			c[1] = row0[x1];
+			c[2] = row1[2 * x];
+			c[3] = row1[x1];
+			r = 0;
+			g = 0;
+			b = 0;
+			for (i = 0; i < 4; i++)
+			{
+				r += c[i] & 0xFF;
+				g += (c[i] >> 8) & 0xFF;
+				b += (c[i] >> 16) & 0xFF;
+			}
+			/* The offset keeps the sums positive before shifting */
+			*out++ = (-43 * r - 85 * g + 128 * b + 4 * 32895) >> 10;
+			*v++ = (128 * r - 107 * g - 21 * b + 4 * 32895) >> 10;
+		}
+	}
+}
+
+/**
+ * capture_write_frame - Encodes and writes one frame of a capture.
+ * @capture: Pointer to the capture_t struct; its scratch buffer is used.
+ * @pixels: The RGBA32 frame, of the size of the capture.
+ * @index: The number of the frame, used to name per-frame files.
+ *
+ * Return: True on success, false on an output error.
+ */
+bool capture_write_frame(capture_t *capture, const color_t *pixels,
+		unsigned long index)
+{
+	size_t count = (size_t)capture->width * capture->height, size;
+	FILE *file = capture->stream;
+	bool ok;
+
+	if (capture->format == CAPTURE_PPM || capture->format == CAPTURE_QOI)
+		file = capture_open_frame_file(capture, index);
+	if (!file)
+		return (false);
+	size = count * 3;
+	if (capture->format == CAPTURE_Y4M)
+	{
+		capture_pack_luma(pixels, count, capture->scratch);
+		capture_pack_chroma(pixels, capture->width, capture->height,
+				capture->scratch + count);
+		size = count + 2 * (size_t)((capture->width + 1) / 2) *
+			((capture->height + 1) / 2);
+		fputs("FRAME\n", file);
+	}
+	else if (capture->format == CAPTURE_QOI)
+		size = capture_encode_qoi(pixels, capture->width,
+				capture->height, capture->scratch);
+	else
+		capture_pack_rgb(pixels, count, capture->scratch);
+	if (capture->format == CAPTURE_PPM)
+		fprintf(file, "P6\n%d %d\n255\n", capture->width,
+				capture->height);
+	ok = fwrite(capture->scratch, 1, size, file) == size;
+	if (file != capture->stream)
+		ok = fclose(file) == 0 && ok;
+	return (ok);
+}
@@ -0,0 +1,75 @@
+#include "../../headers/maze.h"
+#include <limits.h>
+#include <strings.h>
+
+/**
+ * capture_format_from_path - Picks the capture format from a file name.
+ * @path: The output path given to capture_start.
+ * @format: Set to the format matching the extension of @path.
+ *
+ * Return: True if the extension is known, false otherwise.
+ */
+bool capture_format_from_path(const char *path, capture_format_t *format)
+{
+	const char *extension = strrchr(path, '.');
+
+	if (!extension)
+		return (false);
+	if (strcasecmp(extension, ".y4m") == 0)
+		*format = CAPTURE_Y4M;
+	else if (strcasecmp(extension, ".rgb") == 0)
+		*format = CAPTURE_RAW;
+	else if (strcasecmp(extension, ".ppm") == 0)
+		*format = CAPTURE_PPM;
+	else if (strcasecmp(extension, ".qoi") == 0)
+		*format = CAPTURE_QOI;
+	else
+		return (false);
+	return (true);
+}
+
+/**
+ * capture_open_stream - Opens the output stream of a streamed capture.
+ * @capture: Pointer to the capture_t struct with its path and format set.
+ *
+ * Description: Y4M and raw captures write every frame to one stream,
+ * and a Y4M stream starts with its header. Other formats need nothing.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool capture_open_stream(capture_t *capture)
+{
+	if (capture->format != CAPTURE_Y4M && capture->format != CAPTURE_RAW)
+		return (true);
+	capture->stream = fopen(capture->path, "wb");
+	if (!capture->stream)
+		return (false);
+	if (capture->format == CAPTURE_Y4M)
+		return (fprintf(capture->stream,
+				"YUV4MPEG2 W%d H%d F%d:1 Ip A1:1 C420jpeg\n",
+				capture->width, capture->height,
+				capture->fps) > 0);
+	return (true);
+}
+
+/**
+ * capture_open_frame_file - Creates the file of one numbered frame.
+ * @capture: Pointer to the capture_t struct.
+ * @index: The number of the frame.
+ *
+ * Description: The frame number is inserted before the extension of the
+ * capture path, so shot.ppm gives shot-000000.ppm, shot-000001.ppm, ...
+ *
+ * Return: The open file, or NULL on failure.
+ */
+FILE *capture_open_frame_file(const capture_t *capture, unsigned long index)
+{
+	const char *extension = strrchr(capture->path, '.');
+	char name[PATH_MAX];
+
+	if (snprintf(name, sizeof(name), "%.*s-%06lu%s",
+			(int)(extension - capture->path), capture->path,
+			index, extension) >= (int)sizeof(name))
+		return (NULL);
+	return (fopen(name, "wb"));
+}
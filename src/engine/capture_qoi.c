@@ -0,0 +1,126 @@
+#include "../../headers/maze.h"
+
+/**
+ * qoi_put32 - Writes a 32-bit big-endian value.
+ * @out: The buffer to write to.
+ * @value: The value to write.
+ *
+ * Return: Pointer to the byte following the value.
+ */
+static unsigned char *qoi_put32(unsigned char *out, uint32_t value)
+{
+	*out++ = value >> 24;
+	*out++ = (value >> 16) & 0xFF;
+	*out++ = (value >> 8) & 0xFF;
+	*out++ = value & 0xFF;
+	return (out);
+}
+
+/**
+ * qoi_put_diff - Writes a pixel as a difference from the previous one.
+ * @out: The buffer to write to.
+ * @pixel: The pixel to write.
+ * @previous: The previous pixel.
+ *
+ * Description: Uses QOI_OP_DIFF or QOI_OP_LUMA when the difference is
+ * small enough and falls back to QOI_OP_RGB. Alpha is always opaque.
+ *
+ * Return: Pointer to the byte following the chunk.
+ */
+static unsigned char *qoi_put_diff(unsigned char *out, color_t pixel,
+		color_t previous)
+{
+	int dr = (signed char)((pixel & 0xFF) - (previous & 0xFF));
+	int dg = (signed char)(((pixel >> 8) & 0xFF) -
+			((previous >> 8) & 0xFF));
+	int db = (signed char)(((pixel >> 16) & 0xFF) -
+			((previous >> 16) & 0xFF));
+
+	if (dr >= -2 && dr <= 1 && dg >= -2 && dg <= 1 && db >= -2 && db <= 1)
+		*out++ = 0x40 | (dr + 2) << 4 | (dg + 2) << 2 | (db + 2);
+	else if (dg >= -32 && dg <= 31 && dr - dg >= -8 && dr - dg <= 7 &&
+			db - dg >= -8 && db - dg <= 7)
+	{
+		*out++ = 0x80 | (dg + 32);
+		*out++ = (dr - dg + 8) << 4 | (db - dg + 8);
+	}
+	else
+	{
+		*out++ = 0xFE;
+		*out++ = pixel & 0xFF;
+		*out++ = (pixel >> 8) & 0xFF;
+		*out++ = (pixel >> 16) & 0xFF;
+	}
+	return (out);
+}
+
+/**
+ * qoi_encode_rows - Encodes pixels as a sequence of QOI chunks.
+ * @pixels: The first row of the RGBA32 pixels. Alpha is stored as opaque.
+ * @width: The number of pixels per row.
+ * @height: The number of rows.
+ * @pitch: The number of pixels between the starts of two rows.
+ * @out: Buffer of at least 4 * @width * @height bytes.
+ *
+ * Description: The encoder starts from the state a QOI image starts
+ * from, so the chunks decode on their own with qoi_decode_rows().
+ *
+ * Return: Pointer to the byte following the last chunk.
+ */
+unsigned char *qoi_encode_rows(const color_t *pixels, int width, int height,
+		int pitch, unsigned char *out)
+{
+	size_t count = (size_t)width * height, i;
+	color_t index[64], pixel, previous = 0xFF000000;
+	int run = 0, hash, x;
+
+	memset(index, 0, sizeof(index));
+	for (i = 0, x = 0; i < count; i++, x++)
+	{
+		if (x == width)
+			x = 0, pixels += pitch;
+		pixel = pixels[x] | 0xFF000000;
+		if (pixel == previous && ++run < 62 && i + 1 < count)
+			continue;
+		if (run > 0)
+			*out++ = 0xC0 | (run - 1);
+		if (pixel == previous)
+		{
+			run = 0;
+			continue;
+		}
+		run = 0;
+		hash = ((pixel & 0xFF) * 3 + ((pixel >> 8) & 0xFF) * 5 +
+				((pixel >> 16) & 0xFF) * 7 + 255 * 11) % 64;
+		if (index[hash] == pixel)
+			*out++ = hash;
+		else
+			out = qoi_put_diff(out, pixel, previous);
+		index[hash] = pixel;
+		previous = pixel;
+	}
+	return (out);
+}
+
+/**
+ * capture_encode_qoi - Encodes a frame as a QOI image.
+ * @pixels: The RGBA32 frame. Alpha is ignored and stored as opaque RGB.
+ * @width: The width of the frame.
+ * @height: The height of the frame.
+ * @out: Buffer of at least 4 * @width * @height + 22 bytes.
+ *
+ * Return: The size of the encoded image, in bytes.
+ */
+size_t capture_encode_qoi(const color_t *pixels, int width, int height,
+		unsigned char *out)
+{
+	unsigned char *start = out;
+
+	memcpy(out, "qoif", 4);
+	out = qoi_put32(qoi_put32(out + 4, width), height);
+	*out++ = 3;
+	*out++ = 0;
+	out = qoi_encode_rows(pixels, width, height, width, out);
+	memcpy(out, "\0\0\0\0\0\0\0\1", 8);
+	return (out + 8 - start);
+}
@@ -0,0 +1,99 @@
+#include "../../headers/maze.h"
+
+/**
+ * draw_batch_init - Carves an empty draw batch out of a frame arena.
+ * @batch: Pointer to the draw_batch_t struct to initialize.
+ * @arena: Pointer to the frame_arena_t the commands are carved from.
+ * @capacity: The maximum number of primitives the batch holds.
+ *
+ * Return: True on success, false if the arena is too small.
+ */
+bool draw_batch_init(draw_batch_t *batch, frame_arena_t *arena, int capacity)
+{
+	batch->cmds = frame_arena_alloc(arena, sizeof(draw_cmd_t) * capacity);
+	batch->count = 0;
+	batch->capacity = batch->cmds ? capacity : 0;
+	return (batch->cmds != NULL);
+}
+
+/**
+ * draw_batch_line - Queues a line in a draw batch.
+ * @batch: Pointer to the draw_batch_t struct.
+ * @x0: X-coordinate of the start point.
+ * @y0: Y-coordinate of the start point.
+ * @x1: X-coordinate of the end point, which is not drawn.
+ * @y1: Y-coordinate of the end point, which is not drawn.
+ * @color: Color of the line.
+ *
+ * Return: True if the line was queued, false if the batch is full.
+ */
+bool draw_batch_line(draw_batch_t *batch, int x0, int y0, int x1, int y1,
+		color_t color)
+{
+	draw_cmd_t *cmd;
+
+	if (batch->count >= batch->capacity)
+		return (false);
+	cmd = &batch->cmds[batch->count++];
+	cmd->kind = DRAW_LINE;
+	cmd->x0 = x0;
+	cmd->y0 = y0;
+	cmd->x1 = x1;
+	cmd->y1 = y1;
+	cmd->color = color;
+	return (true);
+}
+
+/**
+ * draw_batch_rect - Queues a filled rectangle in a draw batch.
+ * @batch: Pointer to the draw_batch_t struct.
+ * @x: The x-coordinate of the top-left corner of the rectangle.
+ * @y: The y-coordinate of the top-left corner of the rectangle.
+ * @width: The width of the rectangle.
+ * @height: The height of the rectangle.
+ * @color: The color of the rectangle.
+ *
+ * Return: True if the rectangle was queued, false if the batch is full.
+ */
+bool draw_batch_rect(draw_batch_t *batch, int x, int y, int width,
+		int height, color_t color)
+{
+	draw_cmd_t *cmd;
+
+	if (batch->count >= batch->capacity)
+		return (false);
+	cmd = &batch->cmds[batch->count++];
+	cmd->kind = DRAW_RECT;
+	cmd->x0 = x;
+	cmd->y0 = y;
+	cmd->x1 = width;
+	cmd->y1 = height;
+	cmd->color = color;
+	return (true);
+}
+
+/**
+ * draw_batch_flush - Draws every queued primitive and empties the batch.
+ * @batch: Pointer to the draw_batch_t struct.
+ * @frame: Pointer to the framebuffer_t struct the primitives are clipped
+ * to and drawn into.
+ *
+ * Description: Primitives are drawn in submission order, so later ones
+ * are drawn on top of earlier ones.
+ */
+void draw_batch_flush(draw_batch_t *batch, framebuffer_t *frame)
+{
+	const draw_cmd_t *cmd = batch->cmds;
+	const draw_cmd_t *end = batch->cmds + batch->count;
+
+	for (; cmd < end; cmd++)
+	{
+		if (cmd->kind == DRAW_LINE)
+			draw_line(cmd->x0, cmd->y0, cmd->x1, cmd->y1,
+					cmd->color, frame);
+		else
+			draw_rect(cmd->x0, cmd->y0, cmd->x1, cmd->y1,
+					cmd->color, frame);
+	}
+	batch->count = 0;
+}
@@ -0,0 +1,127 @@
+#include "../../headers/maze.h"
+
+#define ENV_CHUNK_SIZE 64
+
+/**
+ * env_batch_init - Creates @count environments sharing a world.
+ * @batch: Pointer to the env_batch_t struct to initialize.
+ * @world: Pointer to the world shared by every environment.
+ * @pool: Pointer to the thread_pool_t used to step, or NULL.
+ * @count: The number of environments.
+ * @width: The number of rays cast per environment and step.
+ * @height: The height of the rendered observations, 0 to never render.
+ *
+ * Description: Every player starts at the center of the map, or the
+ * nearest open cell, facing down.
+ *
+ * Return: True on success, false if an allocation failed.
+ */
+bool env_batch_init(env_batch_t *batch, const world_t *world,
+		thread_pool_t *pool, int count, int width, int height)
+{
+	int i;
+	color_t *pixels;
+	player_t *player;
+	float x = world->map->cols * TILE_SIZE / 2;
+	float y = world->map->rows * TILE_SIZE / 2;
+
+	map_find_open_cell(&x, &y, world->map);
+	memset(batch, 0, sizeof(*batch));
+	batch->world = world;
+	batch->pool = pool;
+	batch->states = calloc(count, sizeof(env_state_t));
+	batch->views = calloc(count, sizeof(view_t));
+	if (height > 0)
+		batch->observations = malloc(
+				sizeof(color_t) * width * height * count);
+	if (!batch->states || !batch->views ||
+			(height > 0 && !batch->observations))
+	{
+		fprintf(stderr, "Unable to allocate memory for environments\n");
+		env_batch_free(batch);
+		return (false);
+	}
+	batch->count = count;
+	for (i = 0; i < count; i++)
+	{
+		player = &batch->states[i].player;
+		player_init(player, x, y);
+		pixels = batch->observations ?
+			batch->observations + (long)width * height * i : NULL;
+		if (!view_init(&batch->views[i], world, player,
+					pixels, width, height))
+		{
+			env_batch_free(batch);
+			return (false);
+		}
+	}
+	return (true);
+}
+
+/**
+ * env_batch_free - Releases the memory owned by a batch of environments.
+ * @batch: Pointer to the env_batch_t struct to release.
+ */
+void env_batch_free(env_batch_t *batch)
+{
+	int i;
+
+	for (i = 0; batch->views && i < batch->count; i++)
+		view_free(&batch->views[i]);
+	free(batch->views);
+	free(batch->states);
+	free(batch->observations);
+	batch->views = NULL;
+	batch->states = NULL;
+	batch->observations = NULL;
+	batch->count = 0;
+}
+
+/**
+ * env_step_job - Steps one chunk of environments.
+ * @arg: Pointer to the env_batch_t struct being stepped.
+ * @chunk: The index of the chunk of ENV_CHUNK_SIZE environments to step.
+ */
+static void env_step_job(void *arg, int chunk)
+{
+	env_batch_t *batch = arg;
+	const map_t *map = batch->world->map;
+	env_state_t *state;
+	int i, end;
+
+	end = (chunk + 1) * ENV_CHUNK_SIZE;
+	end = end > batch->count ? batch->count : end;
+	for (i = chunk * ENV_CHUNK_SIZE; i < end; i++)
+	{
+		state = &batch->states[i];
+		state->player.walk_direction = batch->actions[i].walk_direction;
+		state->player.turn_direction = batch->actions[i].turn_direction;
+		move_player(batch->delta_time, &state->player, map);
+		cast_all_rays(&batch->views[i]);
+		if (batch->render)
+			render_view(&batch->views[i]);
+		state->step_count++;
+	}
+}
+
+/**
+ * env_batch_step - Advances every environment of a batch by one step.
+ * @batch: Pointer to the env_batch_t struct to step.
+ * @actions: Array of one env_action_t per environment.
+ * @delta_time: The simulated time of the step, in seconds.
+ * @render: Whether to render the observations after casting.
+ *
+ * Description: Each environment moves its player with move_player(),
+ * including wall collision, then casts its rays. Environments are split
+ * into chunks stepped in parallel on the batch thread pool.
+ */
+void env_batch_step(env_batch_t *batch, const env_action_t *actions,
+		float delta_time, bool render)
+{
+	batch->actions = actions;
+	batch->delta_time = delta_time;
+	batch->render = render && batch->observations != NULL;
+	thread_pool_run(batch->pool,
+			(batch->count + ENV_CHUNK_SIZE - 1) / ENV_CHUNK_SIZE,
+			env_step_job, batch);
+}
@@ -0,0 +1,31 @@
+#include "../../headers/maze.h"
+
+/**
+ * env_batch_snapshot - Saves the state of one environment.
+ * @batch: Pointer to the env_batch_t struct holding the environment.
+ * @index: The index of the environment to save.
+ * @snapshot: Pointer to the env_state_t struct receiving the state.
+ *
+ * Description: The map and textures are shared and never change, so the
+ * state is a single fixed-size copy, whatever the size of the world.
+ */
+void env_batch_snapshot(const env_batch_t *batch, int index,
+		env_state_t *snapshot)
+{
+	*snapshot = batch->states[index];
+}
+
+/**
+ * env_batch_restore - Puts one environment back into a saved state.
+ * @batch: Pointer to the env_batch_t struct holding the environment.
+ * @index: The index of the environment to restore.
+ * @snapshot: Pointer to the env_state_t struct to restore from.
+ *
+ * Description: The rays of the environment still describe the state it
+ * left; they are cast again by the next env_batch_step().
+ */
+void env_batch_restore(env_batch_t *batch, int index,
+		const env_state_t *snapshot)
+{
+	batch->states[index] = *snapshot;
+}
@@ -0,0 +1,70 @@
+#include "../../headers/maze.h"
+
+/**
+ * frame_arena_init - Allocates the memory of a frame arena.
+ * @arena: Pointer to the frame_arena_t struct to initialize.
+ * @size: The capacity of the arena in bytes.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool frame_arena_init(frame_arena_t *arena, size_t size)
+{
+	void *base;
+
+	arena->base = NULL;
+	arena->size = 0;
+	arena->used = 0;
+	if (posix_memalign(&base, CACHE_LINE_SIZE,
+				size ? size : CACHE_LINE_SIZE) != 0)
+	{
+		fprintf(stderr, "Unable to allocate a frame arena\n");
+		return (false);
+	}
+	arena->base = base;
+	arena->size = size;
+	return (true);
+}
+
+/**
+ * frame_arena_alloc - Carves a cache-line aligned block out of an arena.
+ * @arena: Pointer to the frame_arena_t struct to allocate from.
+ * @size: The size of the block in bytes.
+ *
+ * Return: Pointer to the block, or NULL if the arena is full.
+ */
+void *frame_arena_alloc(frame_arena_t *arena, size_t size)
+{
+	void *block;
+
+	size = (size + CACHE_LINE_SIZE - 1) & ~(size_t)(CACHE_LINE_SIZE - 1);
+	if (size > arena->size - arena->used)
+	{
+		fprintf(stderr, "Frame arena of %lu bytes is full\n",
+				(unsigned long)arena->size);
+		return (NULL);
+	}
+	block = arena->base + arena->used;
+	arena->used += size;
+	return (block);
+}
+
+/**
+ * frame_arena_reset - Releases every block of an arena at once.
+ * @arena: Pointer to the frame_arena_t struct to reset.
+ */
+void frame_arena_reset(frame_arena_t *arena)
+{
+	arena->used = 0;
+}
+
+/**
+ * frame_arena_free - Releases the memory of a frame arena.
+ * @arena: Pointer to the frame_arena_t struct to release.
+ */
+void frame_arena_free(frame_arena_t *arena)
+{
+	free(arena->base);
+	arena->base = NULL;
+	arena->size = 0;
+	arena->used = 0;
+}
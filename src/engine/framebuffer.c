@@ -0,0 +1,40 @@
+#include "../../headers/maze.h"
+
+/**
+ * fill_color_buffer - Fills the color buffer with a specified color.
+ *
+ * @frame: Pointer to the framebuffer_t struct to fill.
+ * @color: The color value to fill the buffer with.
+ *
+ * Description: This function sets each pixel in the color buffer to the
+ * specified color value, effectively clearing the previous contents.
+ * The color buffer represents the color values of each pixel in the
+ * window or screen.
+ */
+void fill_color_buffer(framebuffer_t *frame, color_t color)
+{
+	int i, j;
+	color_t *row;
+
+	for (j = 0; j < frame->height; j++)
+	{
+		row = frame->pixels + (long)j * frame->pitch;
+		for (i = 0; i < frame->width; i++)
+			row[i] = color;
+	}
+}
+
+/**
+ * draw_pixel - Sets the color of a pixel in the color buffer.
+ *
+ * @x: The x-coordinate of the pixel.
+ * @y: The y-coordinate of the pixel.
+ * @color: The color of the pixel.
+ * @frame: Pointer to the framebuffer_t struct to draw into.
+ */
+void draw_pixel(int x, int y, color_t color, framebuffer_t *frame)
+{
+	frame->pixel_calls++;
+	if (x >= 0 && x < frame->width && y >= 0 && y < frame->height)
+		frame->pixels[(long)frame->pitch * y + x] = color;
+}
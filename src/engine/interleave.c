@@ -0,0 +1,173 @@
+#include "../../headers/maze.h"
+
+/**
+ * interleave_moved - Checks if the last frame can be reprojected.
+ * @view: The view starting a frame.
+ *
+ * Return: True if the camera moved or turned too far since the last
+ * frame, or the map changed, so every column has to be cast again.
+ */
+static bool interleave_moved(const view_t *view)
+{
+	const view_history_t *history = &view->history;
+	const player_t *player = view->player;
+	float dx = player->x - history->x, dy = player->y - history->y;
+	float turn = remainder(player->rotation_angle - history->angle,
+			2 * PI), step = INTERLEAVE_MAX_STEP;
+
+	return (!history->valid || history->map != view->world->map ||
+			history->map_version != view->world->map->version ||
+			dx * dx + dy * dy > step * step ||
+			fabs(turn) > INTERLEAVE_MAX_TURN);
+}
+
+/**
+ * interleave_same_face - Checks if a column hits the face of another one.
+ * @rays: The rays of the frame.
+ * @col: The column.
+ * @other: The other column, already cast.
+ *
+ * Return: True if both hit the same grid line from the same side.
+ */
+static bool interleave_same_face(const ray_buffer_t *rays, int col,
+		int other)
+{
+	bool vertical = rays->was_hit_vertical[col];
+	const float *line = vertical ? rays->wall_hit_x : rays->wall_hit_y;
+
+	return (vertical == rays->was_hit_vertical[other] &&
+			fabs(line[col] - line[other]) < 0.5f);
+}
+
+/**
+ * interleave_reproject - Reprojects a column from the last frame.
+ * @view: The view, whose columns @left and @right are cast.
+ * @col: The column, between @left and @right.
+ * @angle: The angle of the ray of @col.
+ * @left: The closest cast column to the left of @col.
+ * @right: The closest cast column to the right of @col.
+ *
+ * Description: The column of the last frame looking the same way hit a
+ * wall face; the new ray of @col is intersected with that face, which
+ * gives its exact hit as long as the face is still what the column sees.
+ * That holds when both cast neighbours hit the same face and the hit
+ * stays on the same wall cell; otherwise the face ends or something
+ * appeared in front of it, and the column has to be cast.
+ *
+ * Return: True if the ray of @col was filled in, false otherwise.
+ */
+static bool interleave_reproject(view_t *view, int col, float angle,
+		int left, int right)
+{
+	view_history_t *history = &view->history;
+	ray_buffer_t *rays = &view->rays;
+	const player_t *player = view->player;
+	int source = floor(view->frame.width / 2 + view->dist_proj_plane *
+			tan(angle - history->angle) + 0.5f);
+	float dx = cos(angle), dy = sin(angle), t, along, old_perp;
+	const float *hit;
+	bool vertical;
+
+	if (source < 0 || source >= view->frame.width)
+		return (false);
+	vertical = history->was_hit_vertical[source];
+	if (fabs(vertical ? dx : dy) < 1e-6f)
+		return (false);
+	t = vertical ? (history->hit_x[source] - player->x) / dx :
+		(history->hit_y[source] - player->y) / dy;
+	rays->wall_hit_x[col] = vertical ? history->hit_x[source] :
+		player->x + t * dx;
+	rays->wall_hit_y[col] = vertical ? player->y + t * dy :
+		history->hit_y[source];
+	rays->was_hit_vertical[col] = vertical;
+	along = vertical ? history->hit_y[source] : history->hit_x[source];
+	hit = vertical ? rays->wall_hit_y : rays->wall_hit_x;
+	if (t <= 0 || floor(along / TILE_SIZE) != floor(hit[col] / TILE_SIZE) ||
+			!interleave_same_face(rays, col, left) ||
+			!interleave_same_face(rays, col, right))
+		return (false);
+	old_perp = (history->hit_x[source] - history->x) *
+		cos(history->angle) + (history->hit_y[source] - history->y) *
+		sin(history->angle);
+	rays->distance[col] = t;
+	rays->texture[col] = history->texture[source];
+	rays->ray_angle[col] = angle;
+	normalize_angle(&rays->ray_angle[col]);
+	history->source[col] = source;
+	history->scale[col] = old_perp / (t * cos(angle -
+				player->rotation_angle));
+	return (true);
+}
+
+/**
+ * interleave_cast - Casts the rays of an interleaved frame.
+ * @view: The view, whose frame has begun.
+ *
+ * Description: One column in @view->interleave is cast, shifting by one
+ * column every frame, so every column is cast again within that many
+ * frames. The columns in between are reprojected from the last frame
+ * when possible and cast otherwise.
+ *
+ * Return: True if the frame was cast, false if interleaving is off or
+ * the camera moved too far, in which case every column has to be cast.
+ */
+bool interleave_cast(view_t *view)
+{
+	view_history_t *history = &view->history;
+	int col, step = view->interleave, width = view->frame.width, phase;
+	int left;
+	float angle;
+
+	history->active = step > 1 && !interleave_moved(view);
+	history->reused = 0;
+	if (!history->active)
+		return (false);
+	phase = history->phase % step;
+	for (col = (step - phase) % step; col < width; col += step)
+		cast_ray(view->player->rotation_angle + atan((col - width / 2) /
+					view->dist_proj_plane), col, view);
+	for (col = 0; col < width; col++)
+	{
+		history->source[col] = -1;
+		left = col - (col + phase) % step;
+		if (left == col)
+			continue;
+		angle = view->player->rotation_angle + atan(
+				(col - width / 2) / view->dist_proj_plane);
+		if (left >= 0 && left + step < width && interleave_reproject(
+					view, col, angle, left, left + step))
+			history->reused++;
+		else
+			cast_ray(angle, col, view);
+	}
+	return (true);
+}
+
+/**
+ * interleave_render_column - Copies a reprojected column into the frame.
+ * @view: The view.
+ * @col: The column, reprojected by interleave_cast().
+ *
+ * Description: The source column is stretched about the horizon by the
+ * ratio of the wall heights, which is exact for the wall and the floor
+ * and ceiling when the camera only turned, and close when it moved by
+ * less than INTERLEAVE_MAX_STEP. Source rows are stepped in 16.16 fixed
+ * point, clamped to the frame.
+ */
+void interleave_render_column(view_t *view, int col)
+{
+	const view_history_t *history = &view->history;
+	int y, height = view->frame.height, half = height / 2;
+	long step = 65536 / history->scale[col], row, last = height - 1;
+	long position = ((long)half << 16) - half * step + 32768;
+	const color_t *source = history->pixels + history->source[col];
+	color_t *pixel = view->frame.pixels + col;
+
+	for (y = 0; y < height; y++, position += step)
+	{
+		row = position < 0 ? 0 : position >> 16;
+		row = row > last ? last : row;
+		pixel[(long)y * view->frame.pitch] =
+			source[row * view->frame.width];
+	}
+}
@@ -0,0 +1,70 @@
+#include "../../headers/maze.h"
+
+/**
+ * latency_record - Adds a latency to a distribution.
+ * @hist: Pointer to the latency_hist_t struct.
+ * @us: The latency, in microseconds.
+ */
+void latency_record(latency_hist_t *hist, uint64_t us)
+{
+	uint64_t bucket = us / LATENCY_BUCKET_US;
+
+	hist->buckets[bucket < LATENCY_BUCKETS ? bucket :
+		LATENCY_BUCKETS - 1]++;
+	hist->count++;
+	hist->total_us += us;
+	if (us > hist->max_us)
+		hist->max_us = us;
+}
+
+/**
+ * latency_percentile - Looks up a percentile of a distribution.
+ * @hist: Pointer to the latency_hist_t struct.
+ * @fraction: The fraction of latencies at or below the result, from 0
+ * to 1.
+ *
+ * Return: The upper end of the bucket holding the percentile, at most
+ * LATENCY_BUCKET_US above it and never above the longest latency, in
+ * microseconds; 0 if nothing was recorded.
+ */
+uint64_t latency_percentile(const latency_hist_t *hist, double fraction)
+{
+	uint64_t rank = ceil(fraction * hist->count), seen = 0, end;
+	int i;
+
+	if (rank < 1)
+		rank = 1;
+	for (i = 0; i < LATENCY_BUCKETS - 1; i++)
+	{
+		seen += hist->buckets[i];
+		if (seen >= rank)
+			break;
+	}
+	end = (uint64_t)(i + 1) * LATENCY_BUCKET_US;
+	return (hist->count == 0 ? 0 : i == LATENCY_BUCKETS - 1 ||
+			end > hist->max_us ? hist->max_us : end);
+}
+
+/**
+ * latency_report - Prints the summary of a distribution.
+ * @hist: Pointer to the latency_hist_t struct.
+ * @what: What the latencies measure, starting the line.
+ * @file: The stream to print to.
+ */
+void latency_report(const latency_hist_t *hist, const char *what,
+		FILE *file)
+{
+	if (hist->count == 0)
+	{
+		fprintf(file, "%s: nothing measured\n", what);
+		return;
+	}
+	fprintf(file, "%s over %lu events: mean %.1f ms, median %.1f ms, "
+			"90%% %.1f ms, 99%% %.1f ms, max %.1f ms\n", what,
+			(unsigned long)hist->count,
+			hist->total_us / 1e3 / hist->count,
+			latency_percentile(hist, 0.5) / 1e3,
+			latency_percentile(hist, 0.9) / 1e3,
+			latency_percentile(hist, 0.99) / 1e3,
+			hist->max_us / 1e3);
+}
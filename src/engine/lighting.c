@@ -0,0 +1,111 @@
+#include "../../headers/maze.h"
+
+/**
+ * lightmap_shade_init - Fills the multiply table of a lightmap.
+ * @lightmap: The lightmap.
+ *
+ * Description: Entry [level][c] is c * level / LIGHT_FULL rounded to the
+ * nearest, so LIGHT_FULL leaves texels unchanged.
+ */
+void lightmap_shade_init(lightmap_t *lightmap)
+{
+	int level, c;
+
+	for (level = 0; level < LIGHT_LEVELS; level++)
+		for (c = 0; c < 256; c++)
+			lightmap->shade[level][c] =
+				(c * level + LIGHT_FULL / 2) / LIGHT_FULL;
+}
+
+/**
+ * lightmap_free - Releases the memory owned by a lightmap.
+ * @lightmap: The lightmap_t struct to release.
+ */
+void lightmap_free(lightmap_t *lightmap)
+{
+	free(lightmap->cells);
+	free(lightmap->corners);
+	free(lightmap->lights);
+	lightmap->cells = NULL;
+	lightmap->corners = NULL;
+	lightmap->lights = NULL;
+	lightmap->num_lights = 0;
+}
+
+/**
+ * lightmap_wall_level - Finds the light level of a wall column.
+ * @lightmap: The lightmap.
+ * @rays: The rays of the frame.
+ * @col: The column, whose ray has already been cast.
+ *
+ * Description: The hit lies on a grid line between two cell corners;
+ * their levels are blended by the position of the hit along the face,
+ * and faces on vertical grid lines are darkened by LIGHT_VERTICAL_SHADE
+ * / 256 so corners stay readable.
+ *
+ * Return: The light level of the column, 0 to LIGHT_FULL.
+ */
+int lightmap_wall_level(const lightmap_t *lightmap, const ray_buffer_t *rays,
+		int col)
+{
+	bool vertical = rays->was_hit_vertical[col];
+	int stride = lightmap->cols + 1, line, along, cell, lines, cells;
+	int first, next, blend, level;
+
+	lines = vertical ? lightmap->cols : lightmap->rows;
+	cells = vertical ? lightmap->rows : lightmap->cols;
+	line = (vertical ? rays->wall_hit_x[col] : rays->wall_hit_y[col]) /
+		TILE_SIZE + 0.5f;
+	line = line < 0 ? 0 : line > lines ? lines : line;
+	along = vertical ? rays->wall_hit_y[col] : rays->wall_hit_x[col];
+	cell = along < 0 ? 0 : along / TILE_SIZE;
+	cell = cell >= cells ? cells - 1 : cell;
+	blend = along - cell * TILE_SIZE;
+	blend = blend < 0 ? 0 : blend > TILE_SIZE ? TILE_SIZE : blend;
+	first = vertical ? cell * stride + line : line * stride + cell;
+	next = first + (vertical ? stride : 1);
+	level = (lightmap->corners[first] * (TILE_SIZE - blend) +
+			lightmap->corners[next] * blend) / TILE_SIZE;
+	return (vertical ? level * LIGHT_VERTICAL_SHADE >> 8 : level);
+}
+
+/**
+ * lightmap_load_lights - Reads point lights from a text file.
+ * @path: The file, with one light per line: x y radius level, where x,
+ * y and radius are in cells and may be fractional, and level is from 0
+ * to LIGHT_FULL.
+ * @lights: Receives the lights, in world units.
+ * @max: The number of lights @lights can hold.
+ *
+ * Return: The number of lights read, 0 if the file does not exist, or -1
+ * if it is malformed, has a level out of range or lists more than @max
+ * lights.
+ */
+int lightmap_load_lights(const char *path, light_t *lights, int max)
+{
+	FILE *file = fopen(path, "r");
+	float x, y, radius;
+	int level, count = 0, read;
+
+	if (!file)
+		return (0);
+	while ((read = fscanf(file, "%f %f %f %d", &x, &y, &radius,
+					&level)) == 4 && count < max &&
+			level >= 0 && level <= LIGHT_FULL)
+	{
+		lights[count].x = x * TILE_SIZE;
+		lights[count].y = y * TILE_SIZE;
+		lights[count].radius = radius * TILE_SIZE;
+		lights[count].level = level;
+		count++;
+	}
+	fclose(file);
+	if (read != EOF)
+	{
+		fprintf(stderr, "%s: expected at most %d lights of 4 numbers, "
+				"with levels from 0 to %d\n", path, max,
+				LIGHT_FULL);
+		return (-1);
+	}
+	return (count);
+}
@@ -0,0 +1,191 @@
+#include "../../headers/maze.h"
+
+/**
+ * lightmap_bake_ambient - Lights the cells of an area with the ambient light.
+ * @lightmap: The lightmap being baked.
+ * @map: The map.
+ * @area: The cells to bake, within the map.
+ *
+ * Description: Each wall among the cell and its eight neighbours
+ * occludes a share of the ambient light, so the floor darkens along the
+ * walls and more so in the corners. Walls get a level too, for the floor
+ * texels rounding into them at the foot of a wall.
+ */
+static void lightmap_bake_ambient(lightmap_t *lightmap, const map_t *map,
+		const map_area_t *area)
+{
+	long i, width = area->right - area->left + 1;
+	long count = width * (area->bottom - area->top + 1);
+	int row, col, r, c, open;
+
+	for (i = 0; i < count; i++)
+	{
+		row = area->top + i / width;
+		col = area->left + i % width;
+		open = 0;
+		for (r = row - 1; r <= row + 1; r++)
+			for (c = col - 1; c <= col + 1; c++)
+				open += r >= 0 && r < map->rows && c >= 0 &&
+					c < map->cols && !get_map_at(r, c, map);
+		lightmap->cells[(long)row * map->cols + col] =
+			lightmap->ambient * (15 + open) / 24;
+	}
+}
+
+/**
+ * lightmap_bake_light - Adds a point light to the cells of an area.
+ * @lightmap: The lightmap being baked.
+ * @map: The map.
+ * @light: The light.
+ * @area: The cells to bake, within the map.
+ *
+ * Description: The light fades linearly to nothing at its radius and
+ * only reaches the cells whose center it sees, so walls cast shadows.
+ * Levels saturate at 0 and LIGHT_FULL, so a negative light darkens the
+ * cells without wrapping around.
+ */
+static void lightmap_bake_light(lightmap_t *lightmap, const map_t *map,
+		const light_t *light, const map_area_t *area)
+{
+	int row = light->y / TILE_SIZE, col = light->x / TILE_SIZE, r, c;
+	int reach = light->radius / TILE_SIZE + 1, level;
+	float dx, dy, distance;
+	unsigned char *cell;
+
+	if (light->x < 0 || light->y < 0 || row >= map->rows ||
+			col >= map->cols || get_map_at(row, col, map))
+		return;
+	for (r = row - reach; r <= row + reach; r++)
+		for (c = col - reach; c <= col + reach; c++)
+		{
+			if (r < area->top || r > area->bottom ||
+					c < area->left || c > area->right)
+				continue;
+			dx = (c + 0.5f) * TILE_SIZE - light->x;
+			dy = (r + 0.5f) * TILE_SIZE - light->y;
+			distance = sqrt(dx * dx + dy * dy);
+			cell = &lightmap->cells[(long)r * map->cols + c];
+			if (distance >= light->radius ||
+					!map_line_of_sight(map, row, col, r, c))
+				continue;
+			level = *cell + light->level *
+				(1 - distance / light->radius);
+			*cell = level < 0 ? 0 : level > LIGHT_FULL ?
+				LIGHT_FULL : level;
+		}
+}
+
+/**
+ * lightmap_bake_corners - Blends the cell levels at the corners of an area.
+ * @lightmap: The lightmap being baked.
+ * @map: The map.
+ * @area: The cells whose corners are baked, within the map.
+ *
+ * Description: A corner takes the mean level of the open cells around
+ * it, occluded by the walls around it: a corner in a straight wall is
+ * slightly darker than a free one, and the inner corner of two walls
+ * darker still, which shades the wall faces meeting there.
+ */
+static void lightmap_bake_corners(lightmap_t *lightmap, const map_t *map,
+		const map_area_t *area)
+{
+	static const int occlusion[5] = {0, 150, 220, 255, 255};
+	long i, width = area->right - area->left + 2;
+	long count = width * (area->bottom - area->top + 2);
+	int row, col, r, c, open, sum;
+
+	for (i = 0; i < count; i++)
+	{
+		row = area->top + i / width;
+		col = area->left + i % width;
+		open = sum = 0;
+		for (r = row - 1; r <= row; r++)
+			for (c = col - 1; c <= col; c++)
+				if (r >= 0 && r < map->rows && c >= 0 &&
+						c < map->cols &&
+						!get_map_at(r, c, map))
+				{
+					open++;
+					sum += lightmap->cells[
+						(long)r * map->cols + c];
+				}
+		lightmap->corners[(long)row * (map->cols + 1) + col] =
+			open ? sum * occlusion[open] / (open * 255) : 0;
+	}
+}
+
+/**
+ * lightmap_bake - Bakes the lighting of an area of a map.
+ * @lightmap: The lightmap, built for @map.
+ * @map: The map.
+ * @area: The cells to bake; it is clipped to the map.
+ *
+ * Description: The cells of @area and the corners around them are baked
+ * from scratch, the rest of the lightmap is left as it is. A change to
+ * the map must rebake the cells around it and the reach of every light
+ * that may see through it, as lightmap_update() does.
+ */
+void lightmap_bake(lightmap_t *lightmap, const map_t *map,
+		const map_area_t *area)
+{
+	map_area_t clipped = *area;
+	int i;
+
+	clipped.top = clipped.top < 0 ? 0 : clipped.top;
+	clipped.left = clipped.left < 0 ? 0 : clipped.left;
+	if (clipped.bottom >= map->rows)
+		clipped.bottom = map->rows - 1;
+	if (clipped.right >= map->cols)
+		clipped.right = map->cols - 1;
+	if (clipped.top > clipped.bottom || clipped.left > clipped.right)
+		return;
+	lightmap_bake_ambient(lightmap, map, &clipped);
+	for (i = 0; i < lightmap->num_lights; i++)
+		lightmap_bake_light(lightmap, map, &lightmap->lights[i],
+				&clipped);
+	lightmap_bake_corners(lightmap, map, &clipped);
+}
+
+/**
+ * lightmap_build - Bakes the static lighting of a map.
+ * @lightmap: The lightmap_t struct to initialize.
+ * @map: The map.
+ * @lights: The point lights, or NULL if @count is 0.
+ * @count: The number of lights.
+ * @ambient: The level of the ambient light, up to LIGHT_FULL, such as
+ * LIGHT_AMBIENT.
+ *
+ * Description: The cost grows with the size of the map and the area of
+ * the lights, so lighting is baked when a map is loaded, and only the
+ * parts a change affects are rebaked afterwards.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool lightmap_build(lightmap_t *lightmap, const map_t *map,
+		const light_t *lights, int count, int ambient)
+{
+	map_area_t area = {0, 0, 0, 0};
+
+	memset(lightmap, 0, sizeof(*lightmap));
+	lightmap->rows = map->rows;
+	lightmap->cols = map->cols;
+	lightmap->map_version = map->version;
+	lightmap->cells = malloc((size_t)map->rows * map->cols);
+	lightmap->corners = malloc((size_t)(map->rows + 1) * (map->cols + 1));
+	lightmap->lights = malloc(sizeof(light_t) * (count > 0 ? count : 1));
+	if (!lightmap->cells || !lightmap->corners || !lightmap->lights)
+	{
+		lightmap_free(lightmap);
+		return (false);
+	}
+	if (count > 0)
+		memcpy(lightmap->lights, lights, sizeof(light_t) * count);
+	lightmap->num_lights = count > 0 ? count : 0;
+	ambient = ambient < 0 ? 0 : ambient;
+	lightmap->ambient = ambient > LIGHT_FULL ? LIGHT_FULL : ambient;
+	lightmap_shade_init(lightmap);
+	area.bottom = map->rows - 1;
+	area.right = map->cols - 1;
+	lightmap_bake(lightmap, map, &area);
+	return (true);
+}
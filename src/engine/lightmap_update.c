@@ -0,0 +1,96 @@
+#include "../../headers/maze.h"
+
+/**
+ * lightmap_update_area - Rebakes the lighting around changed cells.
+ * @lightmap: The lightmap.
+ * @map: The changed map.
+ * @changed: The smallest area holding the changed cells.
+ *
+ * Description: The ambient level of a cell depends on its neighbours,
+ * so the area grows by one cell, and the light a cell receives depends
+ * on the cells between it and the light, so the area also grows to the
+ * reach of every light that reaches into @changed.
+ */
+static void lightmap_update_area(lightmap_t *lightmap, const map_t *map,
+		const map_area_t *changed)
+{
+	map_area_t area;
+	const light_t *light;
+	int i, row, col, reach;
+
+	area.top = changed->top - 1;
+	area.left = changed->left - 1;
+	area.bottom = changed->bottom + 1;
+	area.right = changed->right + 1;
+	for (i = 0; i < lightmap->num_lights; i++)
+	{
+		light = &lightmap->lights[i];
+		row = light->y / TILE_SIZE;
+		col = light->x / TILE_SIZE;
+		reach = light->radius / TILE_SIZE + 1;
+		if (row + reach < changed->top ||
+				row - reach > changed->bottom ||
+				col + reach < changed->left ||
+				col - reach > changed->right)
+			continue;
+		area.top = row - reach < area.top ? row - reach : area.top;
+		area.left = col - reach < area.left ? col - reach : area.left;
+		if (row + reach > area.bottom)
+			area.bottom = row + reach;
+		if (col + reach > area.right)
+			area.right = col + reach;
+	}
+	lightmap_bake(lightmap, map, &area);
+}
+
+/**
+ * lightmap_update - Rebakes the lighting of the changed cells of a map.
+ * @lightmap: The lightmap, baked for an earlier version of @map.
+ * @map: The map, whose size has not changed.
+ * @cells: The indices of the cells that changed.
+ * @count: The number of changed cells.
+ *
+ * Description: Changes less than LIGHT_MERGE_CELLS apart are rebaked
+ * together, so an edited block of cells rebakes the lights around it
+ * once, while edits far apart on a large map do not rebake everything
+ * between them. The result is the same as lightmap_build() gives.
+ *
+ * Return: True on success, false if the size of @map changed, in which
+ * case the lightmap must be built again.
+ */
+bool lightmap_update(lightmap_t *lightmap, const map_t *map,
+		const int *cells, int count)
+{
+	map_area_t area = {0, 0, -1, -1};
+	int i, row, col;
+
+	if (map->rows != lightmap->rows || map->cols != lightmap->cols)
+		return (false);
+	for (i = 0; i < count; i++)
+	{
+		row = cells[i] / map->cols;
+		col = cells[i] % map->cols;
+		if (area.bottom >= area.top &&
+				(row > area.bottom + LIGHT_MERGE_CELLS ||
+				 row < area.top - LIGHT_MERGE_CELLS ||
+				 col > area.right + LIGHT_MERGE_CELLS ||
+				 col < area.left - LIGHT_MERGE_CELLS))
+		{
+			lightmap_update_area(lightmap, map, &area);
+			area.bottom = -1;
+		}
+		if (area.bottom < area.top)
+		{
+			area.top = area.bottom = row;
+			area.left = area.right = col;
+		}
+		area.top = row < area.top ? row : area.top;
+		area.bottom = row > area.bottom ? row : area.bottom;
+		area.left = col < area.left ? col : area.left;
+		area.right = col > area.right ? col : area.right;
+	}
+	if (area.bottom >= area.top)
+		lightmap_update_area(lightmap, map, &area);
+	lightmap->map_version = map->version;
+	return (true);
+}
@@ -0,0 +1,106 @@
+#include "../../headers/maze.h"
+
+/**
+ * is_inside_map - Checks if a given coordinate is inside the map boundaries.
+ *
+ * @x: The x-coordinate of the point.
+ * @y: The y-coordinate of the point.
+ * @map_data: An instance of the map_t struct representing map data.
+ *
+ * Return: Returns 1 if the point is inside the map, 0 otherwise.
+ */
+bool is_inside_map(float x, float y, const map_t *map_data)
+{
+	/* Check if the point is within the map boundaries */
+	return (x > 0 && x <= map_data->cols * TILE_SIZE && y >= 0 && y <=
+			map_data->rows * TILE_SIZE);
+}
+
+/**
+ * map_has_wall_at - Checks if there is a wall at the specified coordinates.
+ *
+ * @x: The x-coordinate to check.
+ * @y: The y-coordinate to check.
+ * @map_data: An instance of the map_t struct representing map data.
+ *
+ * Return: True if there is a wall at the specified coordinates, false
+ * otherwise.
+ */
+bool map_has_wall_at(float x, float y, const map_t *map_data)
+{
+	int map_grid_index_x, map_grid_index_y;
+
+	if (x < 0 || x >= map_data->cols * TILE_SIZE || y < 0 || y >=
+	    map_data->rows * TILE_SIZE)
+		return (true);
+	map_grid_index_x = floor(x / TILE_SIZE);
+	map_grid_index_y = floor(y / TILE_SIZE);
+
+	return (map_data->cells[(long)map_grid_index_y * map_data->cols +
+			map_grid_index_x] != 0);
+}
+
+/**
+ * get_map_at - Retrieves the value at the specified indices in the map array.
+ * @i: The row index in the map array.
+ * @j: The column index in the map array.
+ * @map_data: An instance of the map_t struct representing map data.
+ *
+ * Return: The value at the specified position in the map array.
+ */
+int get_map_at(int i, int j, const map_t *map_data)
+{
+	return (map_data->cells[(long)i * map_data->cols + j]);
+}
+
+/**
+ * get_tile_color - Retrieves the color for a given tile in the map.
+ * @row: The row index of the tile in the map grid.
+ * @col: The column index of the tile in the map grid.
+ * @map_data: An instance of the map_t struct representing map data.
+ *
+ * Return: The color (color_t) assigned to the tile.
+ */
+color_t get_tile_color(int row, int col, const map_t *map_data)
+{
+	return (map_data->cells[(long)row * map_data->cols + col] != 0 ?
+			0xFFFFFFFF : 0x00000000);
+}
+
+/**
+ * map_find_open_cell - Moves a point out of the walls.
+ * @x: Pointer to the x-coordinate of the point.
+ * @y: Pointer to the y-coordinate of the point.
+ * @map_data: An instance of the map_t struct representing map data.
+ *
+ * Description: A point in open space is left alone. Otherwise it moves
+ * to the center of the nearest open cell, searched in square rings of
+ * growing radius, so a player can spawn anywhere in a generated map.
+ *
+ * Return: True if the point is in open space, false if the map has none.
+ */
+bool map_find_open_cell(float *x, float *y, const map_t *map_data)
+{
+	int row = floor(*y / TILE_SIZE), col = floor(*x / TILE_SIZE);
+	int radius, r, c, step, size = map_data->rows > map_data->cols ?
+		map_data->rows : map_data->cols;
+
+	if (!map_has_wall_at(*x, *y, map_data))
+		return (true);
+	for (radius = 1; radius <= 2 * size; radius++)
+		for (r = row - radius; r <= row + radius; r++)
+		{
+			step = r == row - radius || r == row + radius ?
+				1 : 2 * radius;
+			for (c = col - radius; c <= col + radius; c += step)
+				if (r >= 0 && r < map_data->rows && c >= 0 &&
+						c < map_data->cols &&
+						get_map_at(r, c, map_data) == 0)
+				{
+					*x = (c + 0.5f) * TILE_SIZE;
+					*y = (r + 0.5f) * TILE_SIZE;
+					return (true);
+				}
+		}
+	return (false);
+}
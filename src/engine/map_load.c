@@ -0,0 +1,160 @@
+#include "../../headers/maze.h"
+
+/**
+ * map_reader_push - Appends the number being read to the map.
+ * @reader: Pointer to the map_reader_t struct holding the number.
+ *
+ * Description: The cells grow by doubling, so a map of any size is read
+ * with a logarithmic number of copies.
+ *
+ * Return: True on success, false if the number is not a texture ID, the
+ * line is too long or memory runs out.
+ */
+static bool map_reader_push(map_reader_t *reader)
+{
+	unsigned char *cells;
+	size_t capacity;
+
+	if (reader->value > TEXTURE_MAX_IDS ||
+			++reader->row_cols > MAP_MAX_SIZE)
+		return (false);
+	if (reader->count == reader->capacity)
+	{
+		capacity = reader->capacity ? reader->capacity * 2 : 1024;
+		cells = realloc(reader->map->cells, capacity);
+		if (!cells)
+			return (false);
+		reader->map->cells = cells;
+		reader->capacity = capacity;
+	}
+	reader->map->cells[reader->count++] = reader->value;
+	reader->value = -1;
+	return (true);
+}
+
+/**
+ * map_reader_end_row - Closes the current line of the map.
+ * @reader: Pointer to the map_reader_t struct reading the map.
+ *
+ * Description: The first line sets the number of columns; blank lines
+ * are skipped.
+ *
+ * Return: True on success, false if the line has a different number of
+ * cells than the first one or the map has too many rows.
+ */
+static bool map_reader_end_row(map_reader_t *reader)
+{
+	map_t *map = reader->map;
+
+	if (reader->value >= 0 && !map_reader_push(reader))
+		return (false);
+	if (reader->row_cols == 0)
+		return (true);
+	if (map->rows == 0)
+		map->cols = reader->row_cols;
+	if (reader->row_cols != map->cols || ++map->rows > MAP_MAX_SIZE)
+		return (false);
+	reader->row_cols = 0;
+	return (true);
+}
+
+/**
+ * map_reader_feed - Parses a chunk of a map file.
+ * @reader: Pointer to the map_reader_t struct reading the map.
+ * @chunk: The bytes read from the file.
+ * @size: The number of bytes in @chunk.
+ *
+ * Return: True on success, false on a malformed map.
+ */
+static bool map_reader_feed(map_reader_t *reader, const char *chunk,
+		size_t size)
+{
+	size_t i;
+	char c;
+
+	for (i = 0; i < size; i++)
+	{
+		c = chunk[i];
+		if (c >= '0' && c <= '9')
+		{
+			reader->value = (reader->value < 0 ? 0 :
+					reader->value * 10) + (c - '0');
+			if (reader->value > TEXTURE_MAX_IDS)
+				reader->value = TEXTURE_MAX_IDS + 1;
+		}
+		else if (c == '\n')
+		{
+			if (!map_reader_end_row(reader))
+				return (false);
+			reader->line++;
+		}
+		else if (c != ' ' && c != '\t' && c != '\r')
+			return (false);
+		else if (reader->value >= 0 && !map_reader_push(reader))
+			return (false);
+	}
+	return (true);
+}
+
+/**
+ * parse_map_from_file - Parses map data from a file and stores it in
+ * a map_t struct.
+ *
+ * @file_path: The path to the file containing the map data.
+ * @map_data: A pointer to a map_t struct to store the parsed map data.
+ *
+ * Description: The file holds one line of texture IDs per row of the map,
+ * separated by spaces, and its size is taken from the file. It is read in
+ * chunks, so maps of up to MAP_MAX_SIZE x MAP_MAX_SIZE cells load without
+ * holding the text in memory. On failure @map_data is left unchanged.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool parse_map_from_file(const char *file_path, map_t *map_data)
+{
+	map_t parsed = {NULL, 0, 0, 0};
+	map_reader_t reader = {NULL, 0, 0, 0, 1, -1};
+	FILE *file = fopen(file_path, "r");
+	char *chunk = malloc(MAP_READ_CHUNK);
+	bool valid = file && chunk;
+	size_t size;
+
+	reader.map = &parsed;
+	while (valid && (size = fread(chunk, 1, MAP_READ_CHUNK, file)) > 0)
+		valid = map_reader_feed(&reader, chunk, size);
+	valid = valid && !ferror(file) && map_reader_end_row(&reader) &&
+		parsed.rows > 0;
+	if (!file)
+		fprintf(stderr, "Unable to open file: %s\n", file_path);
+	else if (!valid)
+		fprintf(stderr, "Invalid map %s at line %d\n", file_path,
+				reader.line);
+	free(chunk);
+	if (file)
+		fclose(file);
+	if (!valid)
+	{
+		free(parsed.cells);
+		return (false);
+	}
+	free(map_data->cells);
+	parsed.version = map_data->version + 1;
+	*map_data = parsed;
+	return (true);
+}
+
+/**
+ * map_free - Releases the cells of a map.
+ * @map_data: Pointer to the map_t struct to release.
+ *
+ * Description: The map is left empty, with a new version, so data derived
+ * from it is rebuilt if it is parsed again.
+ */
+void map_free(map_t *map_data)
+{
+	free(map_data->cells);
+	map_data->cells = NULL;
+	map_data->rows = 0;
+	map_data->cols = 0;
+	map_data->version++;
+}
@@ -0,0 +1,158 @@
+#include "../../headers/maze.h"
+
+/**
+ * map_reload_diff - Lists the cells the map read differs in.
+ * @reload: The reload, whose map has the size of the live map.
+ *
+ * Description: Blocks of MAP_READ_CHUNK cells are compared at once and
+ * only the blocks that differ are scanned cell by cell, so comparing an
+ * unchanged region costs a memcmp().
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+static bool map_reload_diff(map_reload_t *reload)
+{
+	const unsigned char *live = reload->live->cells;
+	const unsigned char *parsed = reload->parsed.cells;
+	long size = (long)reload->live->rows * reload->live->cols;
+	long start, cell, end;
+	int *changed, capacity;
+
+	for (start = 0; start < size; start += MAP_READ_CHUNK)
+	{
+		end = size - start < MAP_READ_CHUNK ? size :
+			start + MAP_READ_CHUNK;
+		if (memcmp(live + start, parsed + start, end - start) == 0)
+			continue;
+		for (cell = start; cell < end; cell++)
+		{
+			if (live[cell] == parsed[cell])
+				continue;
+			if (reload->count == reload->capacity)
+			{
+				capacity = reload->capacity ?
+					reload->capacity * 2 : 1024;
+				changed = realloc(reload->changed,
+						sizeof(int) * capacity);
+				if (!changed)
+					return (false);
+				reload->changed = changed;
+				reload->capacity = capacity;
+			}
+			reload->changed[reload->count++] = cell;
+		}
+	}
+	return (true);
+}
+
+/**
+ * map_reload_run - The main function of the reload thread.
+ * @arg: Pointer to the map_reload_t struct being reloaded.
+ *
+ * Description: When the size of the map changed, or the cells that
+ * differ cannot be listed, the whole map is to be replaced.
+ *
+ * Return: Always NULL.
+ */
+static void *map_reload_run(void *arg)
+{
+	map_reload_t *reload = arg;
+
+	reload->count = 0;
+	reload->valid = parse_map_from_file(reload->path, &reload->parsed);
+	if (!reload->valid || reload->parsed.rows != reload->live->rows ||
+			reload->parsed.cols != reload->live->cols ||
+			!map_reload_diff(reload))
+		reload->count = -1;
+	pthread_mutex_lock(&reload->lock);
+	reload->done = true;
+	pthread_mutex_unlock(&reload->lock);
+	return (NULL);
+}
+
+/**
+ * map_reload_start - Starts reading a map file again in the background.
+ * @reload: Pointer to a map_reload_t struct, zeroed before its first use.
+ * @path: The map file; the string must outlive the reload.
+ * @live: Pointer to the map in use, which must not change until
+ * map_reload_poll() applies the reload.
+ *
+ * Return: True if the reload started, false if one is still running or
+ * the thread could not be started.
+ */
+bool map_reload_start(map_reload_t *reload, const char *path,
+		const map_t *live)
+{
+	if (reload->running || pthread_mutex_init(&reload->lock, NULL) != 0)
+		return (false);
+	reload->path = path;
+	reload->live = live;
+	reload->count = 0;
+	reload->valid = false;
+	reload->done = false;
+	reload->running = pthread_create(&reload->thread, NULL,
+			map_reload_run, reload) == 0;
+	if (!reload->running)
+		pthread_mutex_destroy(&reload->lock);
+	return (reload->running);
+}
+
+/**
+ * map_reload_poll - Applies a finished reload to the map in use.
+ * @reload: The reload.
+ * @live: Pointer to the map given to map_reload_start().
+ *
+ * Description: This never blocks, so it can be called between two
+ * frames. Only the changed cells are copied into @live; a map of another
+ * size replaces @live whole. Either way the version of @live changes and
+ * @reload->changed and @reload->count tell what changed, with a count of
+ * -1 for a replaced map. A map that fails to read leaves @live as it is.
+ *
+ * Return: True if @live changed, false otherwise.
+ */
+bool map_reload_poll(map_reload_t *reload, map_t *live)
+{
+	bool done;
+	int i;
+
+	if (!reload->running)
+		return (false);
+	pthread_mutex_lock(&reload->lock);
+	done = reload->done;
+	pthread_mutex_unlock(&reload->lock);
+	if (!done)
+		return (false);
+	pthread_join(reload->thread, NULL);
+	pthread_mutex_destroy(&reload->lock);
+	reload->running = false;
+	if (reload->valid && reload->count < 0)
+	{
+		free(live->cells);
+		reload->parsed.version = live->version + 1;
+		*live = reload->parsed;
+		reload->parsed.cells = NULL;
+		return (true);
+	}
+	for (i = 0; i < reload->count; i++)
+		live->cells[reload->changed[i]] =
+			reload->parsed.cells[reload->changed[i]];
+	live->version += reload->count > 0;
+	map_free(&reload->parsed);
+	return (reload->valid && reload->count > 0);
+}
+
+/**
+ * map_reload_free - Waits for a reload and releases its memory.
+ * @reload: The reload, which is zeroed again.
+ */
+void map_reload_free(map_reload_t *reload)
+{
+	if (reload->running)
+	{
+		pthread_join(reload->thread, NULL);
+		pthread_mutex_destroy(&reload->lock);
+	}
+	map_free(&reload->parsed);
+	free(reload->changed);
+	memset(reload, 0, sizeof(*reload));
+}
@@ -0,0 +1,44 @@
+#include "../../headers/maze.h"
+
+/**
+ * map_line_of_sight - Checks if the centers of two cells see each other.
+ * @map: The map.
+ * @r0: The row of the first cell.
+ * @c0: The column of the first cell.
+ * @r1: The row of the second cell.
+ * @c1: The column of the second cell.
+ *
+ * Description: The segment is walked one crossed cell at a time with
+ * integer arithmetic only. Where it passes exactly through a corner, it
+ * is blocked only when both cells beside the corner are walls, which
+ * keeps the test symmetric. Both cells must lie inside the map.
+ *
+ * Return: True if every cell strictly between the two is open.
+ */
+bool map_line_of_sight(const map_t *map, int r0, int c0, int r1, int c1)
+{
+	long nc = abs(c1 - c0), nr = abs(r1 - r0), ic = 0, ir = 0, decision;
+	int sc = c1 > c0 ? 1 : -1, sr = r1 > r0 ? 1 : -1;
+	const unsigned char *cell = map->cells + (long)r0 * map->cols + c0;
+	long step_row = sr * (long)map->cols;
+
+	while (ic < nc || ir < nr)
+	{
+		decision = (1 + 2 * ic) * nr - (1 + 2 * ir) * nc;
+		if (decision == 0 && cell[sc] && cell[step_row])
+			return (false);
+		if (decision <= 0)
+		{
+			cell += sc;
+			ic++;
+		}
+		if (decision >= 0)
+		{
+			cell += step_row;
+			ir++;
+		}
+		if ((ic < nc || ir < nr) && *cell)
+			return (false);
+	}
+	return (true);
+}
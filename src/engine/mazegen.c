@@ -0,0 +1,108 @@
+#include "../../headers/maze.h"
+
+/**
+ * mazegen_hash - Hashes a seed and a pair of coordinates.
+ * @seed: The seed of the map.
+ * @a: The first coordinate.
+ * @b: The second coordinate.
+ *
+ * Description: This is the splitmix64 finalizer. Any cell can draw its
+ * own random number in any order, so rows are generated independently.
+ *
+ * Return: A well mixed 64-bit number.
+ */
+uint64_t mazegen_hash(uint64_t seed, int a, int b)
+{
+	uint64_t x = seed * UINT64_C(0xD1342543DE82EF95);
+
+	x ^= (uint64_t)(unsigned int)a << 32 | (unsigned int)b;
+	x += UINT64_C(0x9E3779B97F4A7C15);
+	x = (x ^ (x >> 30)) * UINT64_C(0xBF58476D1CE4E5B9);
+	x = (x ^ (x >> 27)) * UINT64_C(0x94D049BB133111EB);
+	return (x ^ (x >> 31));
+}
+
+/**
+ * mazegen_texture - Picks the texture ID of a wall cell.
+ * @gen: The parameters of the map.
+ * @row: The row of the cell.
+ * @col: The column of the cell.
+ *
+ * Description: Walls share a texture over blocks of 8x8 cells, so the
+ * map shows areas of matching walls rather than noise.
+ *
+ * Return: A texture ID between 1 and NUM_TEXTURES.
+ */
+static int mazegen_texture(const mazegen_t *gen, int row, int col)
+{
+	return (1 + mazegen_hash(~gen->seed, row >> 3, col >> 3) %
+			NUM_TEXTURES);
+}
+
+/**
+ * mazegen_emit_row - Writes one row of a generated map.
+ * @file: The file receiving the map.
+ * @gen: The parameters of the map.
+ * @row: The index of the row.
+ * @walls: One flag per column, nonzero for walls.
+ * @line: A buffer of 2 * @gen->cols characters for the text of the row.
+ *
+ * Return: True on success, false if the row could not be written.
+ */
+bool mazegen_emit_row(FILE *file, const mazegen_t *gen, int row,
+		const unsigned char *walls, char *line)
+{
+	int col, texture = 0;
+
+	for (col = 0; col < gen->cols; col++)
+	{
+		if ((col & 7) == 0)
+			texture = mazegen_texture(gen, row, col);
+		line[2 * col] = walls[col] ? '0' + texture : '0';
+		line[2 * col + 1] = ' ';
+	}
+	line[2 * gen->cols - 1] = '\n';
+	return (fwrite(line, 1, 2 * gen->cols, file) ==
+			(size_t)(2 * gen->cols));
+}
+
+/**
+ * mazegen_write - Generates a map straight into a file.
+ * @file: The file receiving the map, in the format parse_map_from_file()
+ * reads.
+ * @gen: The parameters of the map, between 3 and MAP_MAX_SIZE cells on
+ * each side.
+ *
+ * Description: Rows are written as soon as they are generated, so the
+ * memory used depends on the width of the map alone. The map is walled
+ * in and cell (1, 1) is always open.
+ *
+ * Return: True on success, false on invalid parameters or a write error.
+ */
+bool mazegen_write(FILE *file, const mazegen_t *gen)
+{
+	unsigned char *walls;
+	char *line;
+	long *noise;
+	bool written;
+	int row;
+
+	if (gen->rows < 3 || gen->cols < 3 || gen->rows > MAP_MAX_SIZE ||
+			gen->cols > MAP_MAX_SIZE)
+		return (false);
+	if (gen->layout == MAZE_PERFECT || gen->layout == MAZE_BRAIDED)
+		return (mazegen_write_maze(file, gen));
+	walls = malloc(gen->cols);
+	line = malloc(2 * gen->cols);
+	noise = malloc(sizeof(long) * gen->cols);
+	written = walls && line && noise;
+	for (row = 0; written && row < gen->rows; row++)
+	{
+		mazegen_field_row(gen, row, walls, noise);
+		written = mazegen_emit_row(file, gen, row, walls, line);
+	}
+	free(walls);
+	free(line);
+	free(noise);
+	return (written);
+}
@@ -0,0 +1,102 @@
+#include "../../headers/maze.h"
+
+/**
+ * maze_find - Finds the set of a cell of the current row.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @cell: The index of the cell.
+ *
+ * Description: Paths are halved on the way, so the sets stay shallow.
+ *
+ * Return: The index of the cell representing the set.
+ */
+static int maze_find(maze_rows_t *rows, int cell)
+{
+	while (rows->parent[cell] != cell)
+	{
+		rows->parent[cell] = rows->parent[rows->parent[cell]];
+		cell = rows->parent[cell];
+	}
+	return (cell);
+}
+
+/**
+ * maze_coin - Flips a coin.
+ * @rows: Pointer to the maze_rows_t struct holding the generator.
+ *
+ * Return: True or false with the same probability.
+ */
+static bool maze_coin(maze_rows_t *rows)
+{
+	rows->rng ^= rows->rng << 13;
+	rows->rng ^= rows->rng >> 7;
+	rows->rng ^= rows->rng << 17;
+	return (rows->rng >> 63);
+}
+
+/**
+ * maze_link_east - Randomly joins neighbouring cells of different sets.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @last: True for the last row, where every set must be joined.
+ */
+static void maze_link_east(maze_rows_t *rows, bool last)
+{
+	int cell, a, b;
+
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		rows->east[cell] = 0;
+		if (cell + 1 == rows->width)
+			break;
+		a = maze_find(rows, cell);
+		b = maze_find(rows, cell + 1);
+		if (a != b && (last || maze_coin(rows)))
+		{
+			rows->east[cell] = 1;
+			rows->parent[b] = a;
+		}
+	}
+}
+
+/**
+ * maze_link_south - Randomly opens cells into the next row.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @last: True for the last row, which opens nothing.
+ *
+ * Description: Every set opens at least once, in its last cell if no
+ * coin flip did earlier, so no part of the maze is cut off.
+ */
+static void maze_link_south(maze_rows_t *rows, bool last)
+{
+	int cell, root;
+
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		rows->count[cell] = 0;
+		rows->scratch[cell] = 0;
+	}
+	for (cell = 0; cell < rows->width; cell++)
+		rows->count[maze_find(rows, cell)]++;
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		root = maze_find(rows, cell);
+		rows->south[cell] = !last && maze_coin(rows);
+		if (!last && --rows->count[root] == 0 && !rows->scratch[root])
+			rows->south[cell] = 1;
+		rows->scratch[root] |= rows->south[cell];
+	}
+}
+
+/**
+ * maze_rows_link - Carves the passages of the current row of a maze.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @last: True for the last row of the maze.
+ *
+ * Description: This is one step of Eller's algorithm: cells of different
+ * sets are randomly joined, then each set opens into the next row. The
+ * last row joins every set left, which makes the maze perfect.
+ */
+void maze_rows_link(maze_rows_t *rows, bool last)
+{
+	maze_link_east(rows, last);
+	maze_link_south(rows, last);
+}
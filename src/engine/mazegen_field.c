@@ -0,0 +1,88 @@
+#include "../../headers/maze.h"
+
+/**
+ * mazegen_smooth - Eases a lattice fraction with a smoothstep.
+ * @t: The fraction, between 0 and 255.
+ *
+ * Return: 3t^2 - 2t^3 on the same scale.
+ */
+static long mazegen_smooth(long t)
+{
+	return (t * t * (768 - 2 * t) / 65536);
+}
+
+/**
+ * mazegen_noise_row - Adds one row of smooth value noise.
+ * @seed: The seed of the noise.
+ * @row: The index of the row.
+ * @period: The distance between lattice points, in cells.
+ * @weight: The weight of this octave.
+ * @noise: One value per column, each increased by up to 65535 * @weight.
+ * @cols: The number of columns.
+ *
+ * Description: Random values on a lattice are blended with a smoothstep,
+ * in integers only so a seed gives the same map on every machine. The
+ * lattice values are drawn once per @period columns.
+ */
+static void mazegen_noise_row(uint64_t seed, int row, int period,
+		int weight, long *noise, int cols)
+{
+	long fr = mazegen_smooth((row % period) * 256 / period), fc;
+	long v00 = 0, v01 = 0, v10 = 0, v11 = 0, top, bottom;
+	int r = row / period, c = 0, col, k = 0;
+
+	for (col = 0; col < cols; col++, k++)
+	{
+		if (col == 0 || k == period)
+		{
+			k = 0;
+			c = col / period;
+			v00 = mazegen_hash(seed, r, c) >> 48;
+			v01 = mazegen_hash(seed, r, c + 1) >> 48;
+			v10 = mazegen_hash(seed, r + 1, c) >> 48;
+			v11 = mazegen_hash(seed, r + 1, c + 1) >> 48;
+		}
+		fc = mazegen_smooth(k * 256 / period);
+		top = v00 + (v01 - v00) * fc / 256;
+		bottom = v10 + (v11 - v10) * fc / 256;
+		noise[col] += weight * (top + (bottom - top) * fr / 256);
+	}
+}
+
+/**
+ * mazegen_field_row - Computes one row of a cave or hall map.
+ * @gen: The parameters of the map.
+ * @row: The index of the row.
+ * @walls: Receives one flag per column, nonzero for walls.
+ * @noise: Scratch space for one value per column.
+ *
+ * Description: Every cell only depends on the seed and its position.
+ * Caves mix two octaves of noise; halls place a 2x2 pillar in three
+ * blocks of 8x8 cells out of four. Caves keep the 3x3 cells next to the
+ * top left corner open.
+ */
+void mazegen_field_row(const mazegen_t *gen, int row, unsigned char *walls,
+		long *noise)
+{
+	bool border = row == 0 || row == gen->rows - 1;
+	int col;
+
+	if (gen->layout == MAZE_CAVE)
+	{
+		memset(noise, 0, sizeof(long) * gen->cols);
+		mazegen_noise_row(gen->seed, row, 12, 3, noise, gen->cols);
+		mazegen_noise_row(~gen->seed, row, 4, 1, noise, gen->cols);
+	}
+	for (col = 0; col < gen->cols; col++)
+	{
+		if (border || col == 0 || col == gen->cols - 1)
+			walls[col] = 1;
+		else if (gen->layout == MAZE_HALL)
+			walls[col] = (row % 8 == 3 || row % 8 == 4) &&
+				(col % 8 == 3 || col % 8 == 4) &&
+				(mazegen_hash(gen->seed, row / 8, col / 8) & 3);
+		else
+			walls[col] = noise[col] > 4 * 35000L &&
+				(row > 3 || col > 3);
+	}
+}
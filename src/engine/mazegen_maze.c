@@ -0,0 +1,71 @@
+#include "../../headers/maze.h"
+
+/**
+ * maze_emit - Writes the map rows of one row of a maze.
+ * @file: The file receiving the map.
+ * @gen: The parameters of the map.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @row: The index of the row in the maze.
+ *
+ * Description: Maze cell (r, c) is map cell (2r + 1, 2c + 1). The map row
+ * above it holds the openings to the previous row; the map row of the
+ * cells holds the openings between neighbours.
+ *
+ * Return: True on success, false if a row could not be written.
+ */
+static bool maze_emit(FILE *file, const mazegen_t *gen,
+		const maze_rows_t *rows, int row)
+{
+	int cell;
+
+	memset(rows->walls, 1, gen->cols);
+	for (cell = 0; cell < rows->width; cell++)
+		rows->walls[2 * cell + 1] = !rows->north[cell];
+	if (!mazegen_emit_row(file, gen, 2 * row, rows->walls, rows->line))
+		return (false);
+	memset(rows->walls, 1, gen->cols);
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		rows->walls[2 * cell + 1] = 0;
+		rows->walls[2 * cell + 2] = !rows->east[cell];
+	}
+	return (mazegen_emit_row(file, gen, 2 * row + 1, rows->walls,
+				rows->line));
+}
+
+/**
+ * mazegen_write_maze - Generates a perfect or braided maze into a file.
+ * @file: The file receiving the map.
+ * @gen: The parameters of the map.
+ *
+ * Description: Eller's algorithm builds the maze one row at a time, and
+ * each row is written once it can no longer change, so a maze of any
+ * height takes memory for a few rows only. An even number of map rows or
+ * columns leaves a second wall along the bottom or right edge.
+ *
+ * Return: True on success, false on an allocation or write error.
+ */
+bool mazegen_write_maze(FILE *file, const mazegen_t *gen)
+{
+	int height = (gen->rows - 1) / 2, row;
+	maze_rows_t rows;
+	bool written;
+
+	written = maze_rows_init(&rows, gen);
+	for (row = 0; written && row < height; row++)
+	{
+		maze_rows_link(&rows, row + 1 == height);
+		if (gen->layout == MAZE_BRAIDED)
+			maze_rows_braid(&rows, row == 0, row + 1 == height);
+		written = maze_emit(file, gen, &rows, row);
+		maze_rows_next(&rows);
+	}
+	for (row = 2 * height; written && row < gen->rows; row++)
+	{
+		memset(rows.walls, 1, gen->cols);
+		written = mazegen_emit_row(file, gen, row, rows.walls,
+				rows.line);
+	}
+	maze_rows_free(&rows);
+	return (written);
+}
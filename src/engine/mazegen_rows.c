@@ -0,0 +1,112 @@
+#include "../../headers/maze.h"
+
+/**
+ * maze_rows_init - Allocates the row state of Eller's algorithm.
+ * @rows: Pointer to the maze_rows_t struct to initialize.
+ * @gen: The parameters of the map; each maze cell takes two map cells.
+ *
+ * Return: True on success, false if an allocation failed; the state must
+ * then still be released with maze_rows_free().
+ */
+bool maze_rows_init(maze_rows_t *rows, const mazegen_t *gen)
+{
+	int cell;
+
+	rows->width = (gen->cols - 1) / 2;
+	rows->parent = malloc(sizeof(int) * rows->width);
+	rows->scratch = malloc(sizeof(int) * rows->width);
+	rows->count = malloc(sizeof(int) * rows->width);
+	rows->east = calloc(rows->width, 1);
+	rows->south = calloc(rows->width, 1);
+	rows->north = calloc(rows->width, 1);
+	rows->walls = malloc(gen->cols);
+	rows->line = malloc(2 * gen->cols);
+	rows->rng = mazegen_hash(gen->seed, -1, -1) | 1;
+	if (!rows->parent || !rows->scratch || !rows->count || !rows->east ||
+			!rows->south || !rows->north || !rows->walls ||
+			!rows->line)
+		return (false);
+	for (cell = 0; cell < rows->width; cell++)
+		rows->parent[cell] = cell;
+	return (true);
+}
+
+/**
+ * maze_rows_free - Releases the row state of Eller's algorithm.
+ * @rows: Pointer to the maze_rows_t struct to release.
+ */
+void maze_rows_free(maze_rows_t *rows)
+{
+	free(rows->parent);
+	free(rows->scratch);
+	free(rows->count);
+	free(rows->east);
+	free(rows->south);
+	free(rows->north);
+	free(rows->walls);
+	free(rows->line);
+}
+
+/**
+ * maze_rows_braid - Opens the dead ends of the current row.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ * @first: True for the first row of the maze.
+ * @last: True for the last row of the maze.
+ *
+ * Description: A cell with a single exit gets a second one, sideways if
+ * possible, else down or up. The row above has not been written yet, so
+ * it can still be opened.
+ */
+void maze_rows_braid(maze_rows_t *rows, bool first, bool last)
+{
+	int cell, exits;
+
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		exits = rows->east[cell] + rows->south[cell] +
+			rows->north[cell] + (cell > 0 && rows->east[cell - 1]);
+		if (exits > 1)
+			continue;
+		if (cell + 1 < rows->width && !rows->east[cell])
+			rows->east[cell] = 1;
+		else if (cell > 0 && !rows->east[cell - 1])
+			rows->east[cell - 1] = 1;
+		else if (!last && !rows->south[cell])
+			rows->south[cell] = 1;
+		else if (!first)
+			rows->north[cell] = 1;
+	}
+}
+
+/**
+ * maze_rows_next - Moves the row state down to the next row.
+ * @rows: Pointer to the maze_rows_t struct holding the row.
+ *
+ * Description: A cell below an opening joins the set of the cell above;
+ * the others start sets of their own.
+ */
+void maze_rows_next(maze_rows_t *rows)
+{
+	int cell, root;
+
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		root = cell;
+		while (rows->parent[root] != root)
+			root = rows->parent[root];
+		rows->count[cell] = root;
+		rows->scratch[cell] = -1;
+	}
+	for (cell = 0; cell < rows->width; cell++)
+	{
+		root = rows->count[cell];
+		rows->parent[cell] = cell;
+		if (rows->south[cell])
+		{
+			if (rows->scratch[root] < 0)
+				rows->scratch[root] = cell;
+			rows->parent[cell] = rows->scratch[root];
+		}
+		rows->north[cell] = rows->south[cell];
+	}
+}
@@ -0,0 +1,135 @@
+#include "../../headers/maze.h"
+
+/**
+ * minimap_cell_to_px - Converts a map cell index to a minimap coordinate.
+ * @cell: The row or column index; the number of rows or columns of the
+ * map gives the size of the whole map.
+ * @scale: Minimap pixels per world unit.
+ *
+ * Return: The first minimap pixel covered by @cell.
+ */
+int minimap_cell_to_px(int cell, float scale)
+{
+	return ((int)floor((double)cell * TILE_SIZE * scale));
+}
+
+/**
+ * minimap_place_window - Centers the window of the minimap on the player.
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: The window is as large as the map allows up to
+ * MINIMAP_MAX_WIDTH x MINIMAP_MAX_HEIGHT, and is clamped to the map so
+ * it never shows anything past its edges.
+ */
+static void minimap_place_window(view_t *view)
+{
+	minimap_t *minimap = &view->minimap;
+	const map_t *map = view->world->map;
+	int map_width = minimap_cell_to_px(map->cols, minimap->scale);
+	int map_height = minimap_cell_to_px(map->rows, minimap->scale);
+	int max_x, max_y;
+
+	minimap->width = map_width < MINIMAP_MAX_WIDTH ?
+		map_width : MINIMAP_MAX_WIDTH;
+	minimap->height = map_height < MINIMAP_MAX_HEIGHT ?
+		map_height : MINIMAP_MAX_HEIGHT;
+	if (minimap->width > view->frame.width)
+		minimap->width = view->frame.width;
+	if (minimap->height > view->frame.height)
+		minimap->height = view->frame.height;
+	max_x = map_width - minimap->width;
+	max_y = map_height - minimap->height;
+	minimap->origin_x = (int)(view->player->x * minimap->scale) -
+		minimap->width / 2;
+	minimap->origin_y = (int)(view->player->y * minimap->scale) -
+		minimap->height / 2;
+	minimap->origin_x = minimap->origin_x < 0 ? 0 :
+		minimap->origin_x > max_x ? max_x : minimap->origin_x;
+	minimap->origin_y = minimap->origin_y < 0 ? 0 :
+		minimap->origin_y > max_y ? max_y : minimap->origin_y;
+}
+
+/**
+ * render_minimap - Draws the minimap in the top left corner of the view.
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: The tiles are copied from the cached layer, then the rays
+ * and the player are queued in the overlay batch and drawn on top in one
+ * pass, clipped to the window of the minimap.
+ */
+void render_minimap(view_t *view)
+{
+	framebuffer_t window;
+
+	minimap_place_window(view);
+	if (view->minimap.width <= 0 || view->minimap.height <= 0 ||
+			!minimap_layer_update(&view->minimap, view->world->map))
+		return;
+	window.pixels = view->frame.pixels;
+	window.width = view->minimap.width;
+	window.height = view->minimap.height;
+	window.pitch = view->frame.pitch;
+	window.pixel_calls = 0;
+	minimap_layer_blit(&view->minimap, &window);
+	render_minimap_rays(view, &view->overlay);
+	render_player_on_minimap(view, &view->overlay);
+	draw_batch_flush(&view->overlay, &window);
+}
+
+/**
+ * render_minimap_rays - Renders a subset of rays on the minimap.
+ *
+ * @view: Pointer to the view_t struct being rendered.
+ * @batch: Pointer to the draw_batch_t struct the lines are queued in,
+ * in the coordinates of the minimap window.
+ *
+ * Description: This function renders a subset of rays on the minimap by
+ * queueing lines from the player's position to the wall hit position
+ * of each ray.
+ * It increments the loop index by 50 to draw only a few rays.
+ */
+void render_minimap_rays(view_t *view, draw_batch_t *batch)
+{
+	const minimap_t *minimap = &view->minimap;
+	int i;
+
+	for (i = 0; i < view->frame.width; i += 50)
+	{
+		draw_batch_line(
+			batch,
+			view->player->x * minimap->scale - minimap->origin_x,
+			view->player->y * minimap->scale - minimap->origin_y,
+			view->rays.wall_hit_x[i] * minimap->scale - minimap->origin_x,
+			view->rays.wall_hit_y[i] * minimap->scale - minimap->origin_y,
+			0xFF0000FF
+			);
+	}
+}
+
+/**
+ * render_player_on_minimap - Renders the player's position on the minimap.
+ *
+ * @view: Pointer to the view_t struct being rendered.
+ * @batch: Pointer to the draw_batch_t struct the rectangle is queued in,
+ * in the coordinates of the minimap window.
+ *
+ * Description: This function renders the player's position on the minimap as
+ * a rectangle, queued with the player's position, width, height, and a
+ * specified color. The rectangle is at least one pixel wide and tall, so
+ * a thin player still shows at small scales.
+ */
+void render_player_on_minimap(view_t *view, draw_batch_t *batch)
+{
+	const minimap_t *minimap = &view->minimap;
+	int width = view->player->width * minimap->scale;
+	int height = view->player->height * minimap->scale;
+
+	draw_batch_rect(
+		batch,
+		view->player->x * minimap->scale - minimap->origin_x,
+		view->player->y * minimap->scale - minimap->origin_y,
+		width > 1 ? width : 1,
+		height > 1 ? height : 1,
+		0xFFFFFFFF
+		);
+}
@@ -0,0 +1,156 @@
+#include "../../headers/maze.h"
+
+/**
+ * minimap_layer_fill - Fills the part of a cell that lies inside the layer.
+ * @minimap: Pointer to the minimap_t struct owning the layer.
+ * @x0: Left edge of the cell, in minimap pixels.
+ * @y0: Top edge of the cell, in minimap pixels.
+ * @x1: Right edge of the cell, exclusive.
+ * @y1: Bottom edge of the cell, exclusive.
+ * @color: The color of the cell.
+ */
+static void minimap_layer_fill(minimap_t *minimap, int x0, int y0,
+		int x1, int y1, color_t color)
+{
+	color_t *row;
+	int x, y;
+
+	x0 = x0 > minimap->layer_x ? x0 - minimap->layer_x : 0;
+	y0 = y0 > minimap->layer_y ? y0 - minimap->layer_y : 0;
+	x1 -= minimap->layer_x;
+	y1 -= minimap->layer_y;
+	if (x1 > minimap->layer_width)
+		x1 = minimap->layer_width;
+	if (y1 > minimap->layer_height)
+		y1 = minimap->layer_height;
+	for (y = y0; y < y1; y++)
+	{
+		row = minimap->layer + (size_t)y * minimap->layer_width;
+		for (x = x0; x < x1; x++)
+			row[x] = color;
+	}
+}
+
+/**
+ * minimap_layer_rasterize - Draws the tiles covered by the layer.
+ * @minimap: Pointer to the minimap_t struct whose layer is drawn.
+ * @map: Pointer to the map_t struct the tiles come from.
+ *
+ * Description: Cell c covers the pixels [px(c), px(c + 1)), so adjacent
+ * tiles neither overlap nor leave gaps at fractional scales.
+ */
+static void minimap_layer_rasterize(minimap_t *minimap, const map_t *map)
+{
+	float cell = TILE_SIZE * minimap->scale;
+	float scale = minimap->scale;
+	int row, col, first_col;
+
+	row = (int)(minimap->layer_y / cell);
+	first_col = (int)(minimap->layer_x / cell);
+	for (; row < map->rows; row++)
+	{
+		if (minimap_cell_to_px(row, scale) >=
+				minimap->layer_y + minimap->layer_height)
+			break;
+		for (col = first_col; col < map->cols; col++)
+		{
+			if (minimap_cell_to_px(col, scale) >=
+					minimap->layer_x + minimap->layer_width)
+				break;
+			minimap_layer_fill(minimap,
+					minimap_cell_to_px(col, scale),
+					minimap_cell_to_px(row, scale),
+					minimap_cell_to_px(col + 1, scale),
+					minimap_cell_to_px(row + 1, scale),
+					get_tile_color(row, col, map));
+		}
+	}
+}
+
+/**
+ * minimap_layer_update - Redraws the cached layer if it is out of date.
+ * @minimap: Pointer to the minimap_t struct with its window already set.
+ * @map: Pointer to the map_t struct shown by the minimap.
+ *
+ * Description: The layer is kept while the map, its version and the scale
+ * are unchanged and the window stays inside it. A rebuilt layer extends
+ * half a window past each side, so a moving player rarely triggers one.
+ *
+ * Return: True if the layer is usable, false if it could not be allocated.
+ */
+bool minimap_layer_update(minimap_t *minimap, const map_t *map)
+{
+	int map_width = minimap_cell_to_px(map->cols, minimap->scale);
+	int map_height = minimap_cell_to_px(map->rows, minimap->scale);
+	size_t needed;
+	color_t *layer;
+
+	if (minimap->layer && minimap->layer_map == map &&
+			minimap->layer_version == map->version &&
+			minimap->layer_scale == minimap->scale &&
+			minimap->origin_x >= minimap->layer_x &&
+			minimap->origin_y >= minimap->layer_y &&
+			minimap->origin_x + minimap->width <=
+			minimap->layer_x + minimap->layer_width &&
+			minimap->origin_y + minimap->height <=
+			minimap->layer_y + minimap->layer_height)
+		return (true);
+	minimap->layer_x = minimap->origin_x - minimap->width / 2;
+	minimap->layer_y = minimap->origin_y - minimap->height / 2;
+	minimap->layer_x = minimap->layer_x > 0 ? minimap->layer_x : 0;
+	minimap->layer_y = minimap->layer_y > 0 ? minimap->layer_y : 0;
+	minimap->layer_width = minimap->width * 2;
+	minimap->layer_height = minimap->height * 2;
+	if (minimap->layer_x + minimap->layer_width > map_width)
+		minimap->layer_width = map_width - minimap->layer_x;
+	if (minimap->layer_y + minimap->layer_height > map_height)
+		minimap->layer_height = map_height - minimap->layer_y;
+	needed = (size_t)minimap->layer_width * minimap->layer_height;
+	if (needed > minimap->layer_capacity)
+	{
+		layer = realloc(minimap->layer, needed * sizeof(color_t));
+		if (!layer)
+			return (false);
+		minimap->layer = layer;
+		minimap->layer_capacity = needed;
+	}
+	minimap_layer_rasterize(minimap, map);
+	minimap->layer_map = map;
+	minimap->layer_version = map->version;
+	minimap->layer_scale = minimap->scale;
+	return (true);
+}
+
+/**
+ * minimap_layer_blit - Copies the visible window of the layer to a frame.
+ * @minimap: Pointer to the minimap_t struct with an up to date layer.
+ * @frame: Pointer to the framebuffer_t struct, at least as large as the
+ * window of the minimap.
+ */
+void minimap_layer_blit(const minimap_t *minimap, framebuffer_t *frame)
+{
+	const color_t *src;
+	int y;
+
+	src = minimap->layer +
+		(size_t)(minimap->origin_y - minimap->layer_y) *
+		minimap->layer_width + (minimap->origin_x - minimap->layer_x);
+	for (y = 0; y < minimap->height; y++)
+	{
+		memcpy(frame->pixels + (size_t)y * frame->pitch, src,
+				minimap->width * sizeof(color_t));
+		src += minimap->layer_width;
+	}
+}
+
+/**
+ * minimap_free - Frees the cached layer of a minimap.
+ * @minimap: Pointer to the minimap_t struct to free.
+ */
+void minimap_free(minimap_t *minimap)
+{
+	free(minimap->layer);
+	minimap->layer = NULL;
+	minimap->layer_capacity = 0;
+	minimap->layer_map = NULL;
+}
@@ -0,0 +1,103 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_field_init - Allocates a flow field for a goal.
+ * @field: The flow field to initialize.
+ * @map: The map the field covers; it must outlive the field.
+ * @goal: The index of the goal cell, row * cols + col.
+ *
+ * Description: The field is not computed yet; see nav_field_compute().
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_field_init(nav_field_t *field, const map_t *map, int goal)
+{
+	long size = (long)map->rows * map->cols;
+
+	field->map = map;
+	field->goal = goal;
+	field->valid = false;
+	field->cost = malloc(sizeof(uint32_t) * size);
+	field->direction = malloc(size);
+	if (!field->cost || !field->direction)
+	{
+		nav_field_free(field);
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * nav_field_free - Frees the memory of a flow field.
+ * @field: The flow field.
+ */
+void nav_field_free(nav_field_t *field)
+{
+	free(field->cost);
+	free(field->direction);
+	field->cost = NULL;
+	field->direction = NULL;
+	field->valid = false;
+}
+
+/**
+ * nav_field_compute - Computes a flow field from scratch.
+ * @field: The flow field.
+ *
+ * Description: Every cell costs O(1), so the whole field takes time
+ * linear in the size of the map. A goal inside a wall leaves every cell
+ * unreachable.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_field_compute(nav_field_t *field)
+{
+	long size = (long)field->map->rows * field->map->cols;
+	nav_seed_t goal;
+
+	memset(field->cost, 0xFF, sizeof(uint32_t) * size);
+	memset(field->direction, NAV_NONE, size);
+	goal.cell = field->goal;
+	goal.cost = 0;
+	if (field->map->cells[goal.cell] != 0)
+	{
+		field->valid = true;
+		return (true);
+	}
+	field->cost[goal.cell] = 0;
+	field->valid = nav_field_propagate(field, &goal, 1);
+	return (field->valid);
+}
+
+/**
+ * nav_field_job - Computes one flow field of a batch.
+ * @arg: The array of nav_field_t structs.
+ * @index: The index of the field to compute.
+ */
+static void nav_field_job(void *arg, int index)
+{
+	nav_field_compute((nav_field_t *)arg + index);
+}
+
+/**
+ * nav_fields_compute - Computes many flow fields at once.
+ * @pool: Pointer to the thread pool running the fields, or NULL.
+ * @fields: The flow fields, each initialized with its goal.
+ * @count: The number of fields.
+ *
+ * Description: A single field is a serial propagation, so the fields
+ * themselves are spread over the pool, one per task. Each field is only
+ * written by its own task, so no locking is needed.
+ *
+ * Return: True if every field was computed, false otherwise.
+ */
+bool nav_fields_compute(thread_pool_t *pool, nav_field_t *fields, int count)
+{
+	int i;
+
+	thread_pool_run(pool, count, nav_field_job, fields);
+	for (i = 0; i < count; i++)
+		if (!fields[i].valid)
+			return (false);
+	return (true);
+}
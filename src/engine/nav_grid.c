@@ -0,0 +1,100 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_neighbor - Finds the cell one step away in a direction.
+ * @map: The map being searched.
+ * @cell: The index of the cell, row * cols + col.
+ * @d: The direction, 0 (east) to 7 (north-east) clockwise.
+ *
+ * Description: Diagonal steps may not cut the corner of a wall, so both
+ * straight cells next to the step must be open as well.
+ *
+ * Return: The index of the neighbour, or -1 if it is outside the map, a
+ * wall, or only reachable by cutting a corner.
+ */
+int nav_neighbor(const map_t *map, int cell, int d)
+{
+	static const int drow[] = {0, 1, 1, 1, 0, -1, -1, -1};
+	static const int dcol[] = {1, 1, 0, -1, -1, -1, 0, 1};
+	int row = cell / map->cols + drow[d], col = cell % map->cols + dcol[d];
+
+	if (row < 0 || row >= map->rows || col < 0 || col >= map->cols)
+		return (-1);
+	if (map->cells[(long)row * map->cols + col] != 0)
+		return (-1);
+	if ((d & 1) && (map->cells[(long)(row - drow[d]) * map->cols + col] ||
+			map->cells[(long)row * map->cols + col - dcol[d]]))
+		return (-1);
+	return (row * map->cols + col);
+}
+
+/**
+ * nav_octile - Estimates the cost between two cells.
+ * @map: The map the cells are in.
+ * @a: The index of the first cell.
+ * @b: The index of the second cell.
+ *
+ * Description: This is the cost of the path on an empty map, so it never
+ * overestimates and A* stays optimal.
+ *
+ * Return: The octile distance between @a and @b.
+ */
+uint32_t nav_octile(const map_t *map, int a, int b)
+{
+	int dr = abs(a / map->cols - b / map->cols);
+	int dc = abs(a % map->cols - b % map->cols);
+	int low = dr < dc ? dr : dc, high = dr < dc ? dc : dr;
+
+	return ((uint32_t)(NAV_STRAIGHT_COST * (high - low) +
+				NAV_DIAGONAL_COST * low));
+}
+
+/**
+ * nav_field_steer - Looks up where an agent should head.
+ * @field: The flow field to the goal of the agent.
+ * @x: The x-coordinate of the agent, in pixels.
+ * @y: The y-coordinate of the agent, in pixels.
+ * @angle: Receives the angle to head at, with the conventions of
+ * player_t: 0 is east and angles grow clockwise.
+ *
+ * Return: True if the agent can reach the goal and is not on it, false
+ * otherwise.
+ */
+bool nav_field_steer(const nav_field_t *field, float x, float y,
+		float *angle)
+{
+	int row = floor(y / TILE_SIZE), col = floor(x / TILE_SIZE);
+	unsigned char d;
+
+	if (!field->valid || row < 0 || row >= field->map->rows || col < 0 ||
+			col >= field->map->cols)
+		return (false);
+	d = field->direction[(long)row * field->map->cols + col];
+	if (d == NAV_NONE)
+		return (false);
+	*angle = d * PI / 4;
+	return (true);
+}
+
+/**
+ * nav_list_push_around - Adds a cell and its open neighbours to a list.
+ * @list: The list.
+ * @map: The map the cell is in.
+ * @cell: The index of the cell.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_list_push_around(nav_list_t *list, const map_t *map, int cell)
+{
+	int d, next;
+
+	if (!nav_list_push(list, cell))
+		return (false);
+	for (d = 0; d < 8; d++)
+	{
+		next = nav_neighbor(map, cell, d);
+		if (next >= 0 && !nav_list_push(list, next))
+			return (false);
+	}
+	return (true);
+}
@@ -0,0 +1,136 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_jump_straight - Runs along a row or column to the next jump point.
+ * @map: The map.
+ * @cell: The index of the cell the run starts from.
+ * @d: The direction of the run: 0, 2, 4 or 6.
+ * @goal: The index of the goal cell.
+ *
+ * Description: A cell is a jump point when it is the goal or has a
+ * forced neighbour: an open cell beside it whose cell just behind is a
+ * wall, so the only best path to it turns here. Runs cross whole maps,
+ * so they walk the cells by index; whether the sides of the run at the
+ * lower and upper index exist is settled once for the whole run.
+ *
+ * Return: The index of the jump point, or -1 if the run hits a wall.
+ */
+static int nav_jump_straight(const map_t *map, int cell, int d, int goal)
+{
+	const unsigned char *cells = map->cells;
+	int row = cell / map->cols, col = cell % map->cols, lower, upper, n;
+	int step = d == 0 ? 1 : d == 4 ? -1 : d == 2 ? map->cols : -map->cols;
+	int side = d & 2 ? 1 : map->cols;
+
+	lower = d & 2 ? col > 0 : row > 0;
+	upper = d & 2 ? col < map->cols - 1 : row < map->rows - 1;
+	n = d == 0 ? map->cols - 1 - col : d == 4 ? col :
+		d == 2 ? map->rows - 1 - row : row;
+	for (; n > 0; n--)
+	{
+		cell += step;
+		if (cells[cell] != 0)
+			return (-1);
+		if (cell == goal || (lower && !cells[cell - side] &&
+					cells[cell - side - step]) ||
+				(upper && !cells[cell + side] &&
+				 cells[cell + side - step]))
+			return (cell);
+	}
+	return (-1);
+}
+
+/**
+ * nav_jump - Runs in a direction to the next jump point.
+ * @map: The map.
+ * @cell: The index of the cell the run starts from.
+ * @d: The direction of the run, 0 (east) to 7 (north-east) clockwise.
+ * @goal: The index of the goal cell.
+ *
+ * Description: A diagonal run stops at every cell from which one of its
+ * two straight components reaches a jump point.
+ *
+ * Return: The index of the jump point, or -1 if there is none.
+ */
+static int nav_jump(const map_t *map, int cell, int d, int goal)
+{
+	int left = (d + 7) & 7, right = (d + 1) & 7;
+
+	if (!(d & 1))
+		return (nav_jump_straight(map, cell, d, goal));
+	while ((cell = nav_neighbor(map, cell, d)) >= 0)
+		if (cell == goal ||
+				nav_jump_straight(map, cell, left, goal) >= 0 ||
+				nav_jump_straight(map, cell, right, goal) >= 0)
+			return (cell);
+	return (-1);
+}
+
+/**
+ * nav_travel_direction - Finds the direction a node was entered from.
+ * @map: The map.
+ * @from: The index of the parent cell.
+ * @to: The index of the cell.
+ *
+ * Return: The direction from @from towards @to, 0 (east) to 7
+ * (north-east) clockwise, or NAV_NONE if they are the same cell.
+ */
+static int nav_travel_direction(const map_t *map, int from, int to)
+{
+	static const int directions[3][3] = {
+		{5, 6, 7}, {4, NAV_NONE, 0}, {3, 2, 1}
+	};
+	int dr = to / map->cols - from / map->cols;
+	int dc = to % map->cols - from % map->cols;
+
+	return (directions[(dr > 0) - (dr < 0) + 1][(dc > 0) - (dc < 0) + 1]);
+}
+
+/**
+ * nav_jps_expand - Adds the jump points reachable from a node.
+ * @search: The search.
+ * @map: The map.
+ * @node: The index of the node being expanded.
+ * @goal: The index of the goal cell.
+ *
+ * Description: Past the start, a node entered diagonally only looks on
+ * along that diagonal and its two components; one entered straight also
+ * looks sideways and along the two diagonals around its heading. Every
+ * run is checked with nav_neighbor(), so no path cuts a corner.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_jps_expand(nav_search_t *search, const map_t *map, int node,
+		int goal)
+{
+	int cell = search->nodes[node].cell, parent;
+	int d = NAV_NONE, k, first = 0, last = 7, jump, next;
+	uint32_t g;
+
+	parent = search->nodes[node].parent;
+	if (parent >= 0)
+		d = nav_travel_direction(map, search->nodes[parent].cell, cell);
+	if (d != NAV_NONE)
+	{
+		first = d - (d & 1 ? 1 : 2);
+		last = d + (d & 1 ? 1 : 2);
+	}
+	for (k = first; k <= last; k++)
+	{
+		jump = nav_jump(map, cell, (k + 8) & 7, goal);
+		if (jump < 0)
+			continue;
+		next = nav_search_node(search, jump);
+		if (next < 0)
+			return (false);
+		g = search->nodes[node].g + nav_octile(map, cell, jump);
+		if (search->nodes[next].closed || g >= search->nodes[next].g)
+			continue;
+		search->nodes[next].g = g;
+		search->nodes[next].parent = node;
+		if (!nav_heap_push(search, next, g,
+					nav_octile(map, jump, goal)))
+			return (false);
+	}
+	return (true);
+}
@@ -0,0 +1,79 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_build_path - Stores the path ending at a node.
+ * @search: The search.
+ * @node: The index of the node of the goal.
+ *
+ * Return: The number of cells in the path, or 0 if memory allocation
+ * failed.
+ */
+static int nav_build_path(nav_search_t *search, int node)
+{
+	int count = 0, i, *path;
+
+	for (i = node; i >= 0; i = search->nodes[i].parent)
+		count++;
+	if (count > search->path_capacity)
+	{
+		path = realloc(search->path, sizeof(int) * count);
+		if (!path)
+			return (0);
+		search->path = path;
+		search->path_capacity = count;
+	}
+	search->path_count = count;
+	for (i = node; i >= 0; i = search->nodes[i].parent)
+		search->path[--count] = search->nodes[i].cell;
+	return (search->path_count);
+}
+
+/**
+ * nav_find_path - Finds a shortest path between two cells.
+ * @search: The memory of the search, reused from one call to the next.
+ * @map: The map.
+ * @start: The index of the start cell, row * cols + col.
+ * @goal: The index of the goal cell.
+ *
+ * Description: This is A* with jump point search: runs along straight
+ * lines and diagonals skip the cells in between, which on open maps
+ * leaves only the corners of walls in the open list. The path has the
+ * same cost as the flow field to @goal gives @start, and only goes
+ * straight or diagonally between consecutive cells.
+ *
+ * Return: The number of cells in @search->path, from @start to @goal,
+ * or 0 if there is no path or memory allocation failed.
+ */
+int nav_find_path(nav_search_t *search, const map_t *map, int start,
+		int goal)
+{
+	long size = (long)map->rows * map->cols;
+	int node;
+
+	search->node_count = 0;
+	search->heap_count = 0;
+	search->path_count = 0;
+	if (search->table)
+		memset(search->table, 0xFF,
+				sizeof(int) * search->table_capacity);
+	if (start < 0 || start >= size || goal < 0 || goal >= size ||
+			map->cells[start] != 0 || map->cells[goal] != 0)
+		return (0);
+	node = nav_search_node(search, start);
+	if (node < 0)
+		return (0);
+	search->nodes[node].g = 0;
+	if (!nav_heap_push(search, node, 0, nav_octile(map, start, goal)))
+		return (0);
+	while ((node = nav_heap_pop(search)) >= 0)
+	{
+		if (search->nodes[node].closed)
+			continue;
+		search->nodes[node].closed = true;
+		if (search->nodes[node].cell == goal)
+			return (nav_build_path(search, node));
+		if (!nav_jps_expand(search, map, node, goal))
+			return (0);
+	}
+	return (0);
+}
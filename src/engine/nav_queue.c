@@ -0,0 +1,157 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_list_push - Appends a cell to a list.
+ * @list: The list.
+ * @cell: The index of the cell.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_list_push(nav_list_t *list, int cell)
+{
+	int capacity, *cells;
+
+	if (list->count == list->capacity)
+	{
+		capacity = list->capacity ? 2 * list->capacity : 256;
+		cells = realloc(list->cells, sizeof(int) * capacity);
+		if (!cells)
+			return (false);
+		list->cells = cells;
+		list->capacity = capacity;
+	}
+	list->cells[list->count++] = cell;
+	return (true);
+}
+
+/**
+ * nav_queue_push - Queues a cell at a cost.
+ * @queue: The queue.
+ * @cell: The index of the cell.
+ * @cost: The cost of the cell, at most NAV_DIAGONAL_COST more than the
+ * cost being popped.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_queue_push(nav_queue_t *queue, int cell, uint32_t cost)
+{
+	int bucket = cost % NAV_BUCKETS, capacity;
+	int *cells;
+
+	if (queue->count[bucket] == queue->capacity[bucket])
+	{
+		capacity = queue->capacity[bucket] ? 2 * queue->capacity[bucket]
+			: 256;
+		cells = realloc(queue->cells[bucket], sizeof(int) * capacity);
+		if (!cells)
+			return (false);
+		queue->cells[bucket] = cells;
+		queue->capacity[bucket] = capacity;
+	}
+	queue->cells[bucket][queue->count[bucket]++] = cell;
+	queue->size++;
+	return (true);
+}
+
+/**
+ * nav_queue_pop - Takes a cell of the lowest cost out of the queue.
+ * @queue: The queue.
+ * @cell: Receives the index of the cell.
+ * @cost: Receives the cost the cell was queued at.
+ *
+ * Description: The seeds are merged in as the cost popped reaches them,
+ * and the queue skips straight to the next seed when it runs empty, so
+ * seeds far apart in cost do not cost a bucket scan each.
+ *
+ * Return: True if a cell was popped, false if the queue is empty.
+ */
+bool nav_queue_pop(nav_queue_t *queue, int *cell, uint32_t *cost)
+{
+	int bucket;
+
+	while (true)
+	{
+		if (queue->next_seed < queue->seed_count && queue->current >=
+				queue->seeds[queue->next_seed].cost)
+		{
+			*cell = queue->seeds[queue->next_seed].cell;
+			*cost = queue->seeds[queue->next_seed++].cost;
+			return (true);
+		}
+		bucket = queue->current % NAV_BUCKETS;
+		if (queue->count[bucket] > 0)
+		{
+			*cell = queue->cells[bucket][--queue->count[bucket]];
+			*cost = queue->current;
+			queue->size--;
+			return (true);
+		}
+		if (queue->size > 0)
+			queue->current++;
+		else if (queue->next_seed < queue->seed_count)
+			queue->current = queue->seeds[queue->next_seed].cost;
+		else
+			return (false);
+	}
+}
+
+/**
+ * nav_queue_free - Frees the memory of a queue.
+ * @queue: The queue.
+ */
+void nav_queue_free(nav_queue_t *queue)
+{
+	int bucket;
+
+	for (bucket = 0; bucket < NAV_BUCKETS; bucket++)
+	{
+		free(queue->cells[bucket]);
+		queue->cells[bucket] = NULL;
+		queue->count[bucket] = 0;
+		queue->capacity[bucket] = 0;
+	}
+	queue->size = 0;
+}
+
+/**
+ * nav_field_propagate - Spreads costs from seed cells over a flow field.
+ * @field: The flow field, with the cost of every seed already stored.
+ * @seeds: The seed cells, sorted by cost.
+ * @count: The number of seeds.
+ *
+ * Description: This is Dijkstra's algorithm on a bucket queue. A cell
+ * can be queued more than once; the stale copies are recognised because
+ * their cost no longer matches the field and are skipped.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_field_propagate(nav_field_t *field, const nav_seed_t *seeds,
+		int count)
+{
+	nav_queue_t queue;
+	uint32_t cost, step;
+	int cell, next, d;
+	bool pushed = true;
+
+	memset(&queue, 0, sizeof(queue));
+	queue.seeds = seeds;
+	queue.seed_count = count;
+	while (pushed && nav_queue_pop(&queue, &cell, &cost))
+	{
+		if (cost != field->cost[cell])
+			continue;
+		for (d = 0; pushed && d < 8; d++)
+		{
+			next = nav_neighbor(field->map, cell, d);
+			step = cost + (d & 1 ? NAV_DIAGONAL_COST :
+					NAV_STRAIGHT_COST);
+			if (next < 0 || step >= field->cost[next])
+				continue;
+			field->cost[next] = step;
+			field->direction[next] = (d + 4) & 7;
+			pushed = nav_queue_push(&queue, next, step);
+		}
+	}
+	nav_queue_free(&queue);
+	return (pushed);
+}
@@ -0,0 +1,156 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_search_grow - Doubles the hash table of a search.
+ * @search: The search.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+static bool nav_search_grow(nav_search_t *search)
+{
+	int capacity = search->table_capacity ? 2 * search->table_capacity
+		: 1024;
+	int *table = malloc(sizeof(int) * capacity), node;
+	unsigned int slot;
+
+	if (!table)
+		return (false);
+	memset(table, 0xFF, sizeof(int) * capacity);
+	for (node = 0; node < search->node_count; node++)
+	{
+		slot = ((unsigned int)search->nodes[node].cell * 2654435761u) &
+			(capacity - 1);
+		while (table[slot] >= 0)
+			slot = (slot + 1) & (capacity - 1);
+		table[slot] = node;
+	}
+	free(search->table);
+	search->table = table;
+	search->table_capacity = capacity;
+	return (true);
+}
+
+/**
+ * nav_search_node - Finds or creates the node of a cell.
+ * @search: The search.
+ * @cell: The index of the cell.
+ *
+ * Description: The table is kept at most half full, so a lookup probes
+ * a couple of slots on average.
+ *
+ * Return: The index of the node in @search->nodes, or -1 if memory
+ * allocation failed.
+ */
+int nav_search_node(nav_search_t *search, int cell)
+{
+	unsigned int slot;
+	nav_node_t *nodes;
+	int node, capacity;
+
+	if (2 * (search->node_count + 1) > search->table_capacity &&
+			!nav_search_grow(search))
+		return (-1);
+	slot = ((unsigned int)cell * 2654435761u) &
+		(search->table_capacity - 1);
+	for (; (node = search->table[slot]) >= 0;
+			slot = (slot + 1) & (search->table_capacity - 1))
+		if (search->nodes[node].cell == cell)
+			return (node);
+	if (search->node_count == search->node_capacity)
+	{
+		capacity = search->node_capacity ? 2 * search->node_capacity
+			: 256;
+		nodes = realloc(search->nodes, sizeof(nav_node_t) * capacity);
+		if (!nodes)
+			return (-1);
+		search->nodes = nodes;
+		search->node_capacity = capacity;
+	}
+	node = search->node_count++;
+	search->nodes[node].cell = cell;
+	search->nodes[node].parent = -1;
+	search->nodes[node].g = NAV_UNREACHABLE;
+	search->nodes[node].closed = false;
+	search->table[slot] = node;
+	return (node);
+}
+
+/**
+ * nav_heap_push - Adds a node to the open list.
+ * @search: The search.
+ * @node: The index of the node.
+ * @g: The cost of the path to the node.
+ * @h: The estimated cost from the node to the goal.
+ *
+ * Description: Among nodes of equal estimated cost, the one closest to
+ * the goal comes out first, so on open maps the search dives for the
+ * goal instead of widening every tied path.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool nav_heap_push(nav_search_t *search, int node, uint32_t g, uint32_t h)
+{
+	nav_open_t *heap, entry;
+	int i = search->heap_count, parent, capacity;
+
+	if (search->heap_count == search->heap_capacity)
+	{
+		capacity = search->heap_capacity ? 2 * search->heap_capacity
+			: 256;
+		heap = realloc(search->heap, sizeof(nav_open_t) * capacity);
+		if (!heap)
+			return (false);
+		search->heap = heap;
+		search->heap_capacity = capacity;
+	}
+	entry.key = (uint64_t)(g + h) << 32 | h;
+	entry.node = node;
+	for (; i > 0 && search->heap[(parent = (i - 1) / 2)].key > entry.key;
+			i = parent)
+		search->heap[i] = search->heap[parent];
+	search->heap[i] = entry;
+	search->heap_count++;
+	return (true);
+}
+
+/**
+ * nav_heap_pop - Takes the node of the lowest estimate off the open list.
+ * @search: The search.
+ *
+ * Return: The index of the node, or -1 if the open list is empty.
+ */
+int nav_heap_pop(nav_search_t *search)
+{
+	nav_open_t last, *heap = search->heap;
+	int node, i = 0, child;
+
+	if (search->heap_count == 0)
+		return (-1);
+	node = heap[0].node;
+	last = heap[--search->heap_count];
+	while ((child = 2 * i + 1) < search->heap_count)
+	{
+		if (child + 1 < search->heap_count &&
+				heap[child + 1].key < heap[child].key)
+			child++;
+		if (heap[child].key >= last.key)
+			break;
+		heap[i] = heap[child];
+		i = child;
+	}
+	heap[i] = last;
+	return (node);
+}
+
+/**
+ * nav_search_free - Frees the memory of a search.
+ * @search: The search, left ready for reuse.
+ */
+void nav_search_free(nav_search_t *search)
+{
+	free(search->nodes);
+	free(search->table);
+	free(search->heap);
+	free(search->path);
+	memset(search, 0, sizeof(*search));
+}
@@ -0,0 +1,163 @@
+#include "../../headers/maze.h"
+
+/**
+ * nav_update_stale - Checks if the cost of a cell no longer holds.
+ * @field: The flow field.
+ * @cell: The index of the cell.
+ *
+ * Return: True if @cell has a cost but became a wall, or its step is now
+ * blocked, or leads to a cell that lost its cost; false otherwise.
+ */
+static bool nav_update_stale(const nav_field_t *field, int cell)
+{
+	int next;
+
+	if (field->cost[cell] == NAV_UNREACHABLE)
+		return (false);
+	if (field->map->cells[cell] != 0)
+		return (true);
+	if (cell == field->goal)
+		return (false);
+	if (field->direction[cell] == NAV_NONE)
+		return (true);
+	next = nav_neighbor(field->map, cell, field->direction[cell]);
+	return (next < 0 || field->cost[next] == NAV_UNREACHABLE);
+}
+
+/**
+ * nav_update_raise - Clears the cells whose path went through a change.
+ * @field: The flow field.
+ * @cells: The indices of the cells that changed.
+ * @count: The number of changed cells.
+ * @cleared: Receives the cells that were cleared.
+ *
+ * Description: Clearing a cell can break the cells stepping into it, so
+ * the check spreads from the changes until the paths left are intact.
+ * Only the cells whose path went through a new wall are visited.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+static bool nav_update_raise(nav_field_t *field, const int *cells,
+		int count, nav_list_t *cleared)
+{
+	nav_list_t stack = {NULL, 0, 0};
+	bool pushed = true;
+	int i, cell;
+
+	for (i = 0; pushed && i < count; i++)
+		pushed = nav_list_push_around(&stack, field->map, cells[i]);
+	while (pushed && stack.count > 0)
+	{
+		cell = stack.cells[--stack.count];
+		if (!nav_update_stale(field, cell))
+			continue;
+		field->cost[cell] = NAV_UNREACHABLE;
+		field->direction[cell] = NAV_NONE;
+		pushed = nav_list_push(cleared, cell) &&
+			nav_list_push_around(&stack, field->map, cell);
+	}
+	free(stack.cells);
+	return (pushed);
+}
+
+/**
+ * nav_update_best - Gives a cell the best cost its neighbours offer.
+ * @field: The flow field.
+ * @cell: The index of the cell.
+ *
+ * Return: True if the cost of @cell went down, false otherwise.
+ */
+static bool nav_update_best(nav_field_t *field, int cell)
+{
+	uint32_t step;
+	int d, next;
+	bool improved = false;
+
+	if (field->map->cells[cell] != 0)
+		return (false);
+	if (cell == field->goal)
+	{
+		improved = field->cost[cell] != 0;
+		field->cost[cell] = 0;
+		field->direction[cell] = NAV_NONE;
+		return (improved);
+	}
+	for (d = 0; d < 8; d++)
+	{
+		next = nav_neighbor(field->map, cell, d);
+		if (next < 0 || field->cost[next] == NAV_UNREACHABLE)
+			continue;
+		step = field->cost[next] + (d & 1 ? NAV_DIAGONAL_COST :
+				NAV_STRAIGHT_COST);
+		if (step < field->cost[cell])
+		{
+			field->cost[cell] = step;
+			field->direction[cell] = d;
+			improved = true;
+		}
+	}
+	return (improved);
+}
+
+/**
+ * nav_compare_seeds - Orders seeds by cost for qsort().
+ * @a: Pointer to the first nav_seed_t.
+ * @b: Pointer to the second nav_seed_t.
+ *
+ * Return: A negative, zero or positive number as @a is cheaper than, as
+ * costly as or costlier than @b.
+ */
+static int nav_compare_seeds(const void *a, const void *b)
+{
+	uint32_t x = ((const nav_seed_t *)a)->cost;
+	uint32_t y = ((const nav_seed_t *)b)->cost;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * nav_field_update - Repairs a flow field after cells of its map changed.
+ * @field: The computed flow field.
+ * @cells: The indices of the cells that turned into walls or open space.
+ * @count: The number of changed cells.
+ *
+ * Description: Cells whose path crossed a new wall are cleared, then the
+ * cleared cells and the cells around the changes take the best cost of
+ * their neighbours and the costs spread from there. The result matches
+ * nav_field_compute() in cost, while a door opening or closing only
+ * touches the part of the field that depends on it.
+ *
+ * Return: True on success, false if memory allocation failed, in which
+ * case the field is no longer valid.
+ */
+bool nav_field_update(nav_field_t *field, const int *cells, int count)
+{
+	nav_list_t candidates = {NULL, 0, 0};
+	nav_seed_t *seeds = NULL;
+	int i, seed_count = 0;
+	bool updated;
+
+	updated = nav_update_raise(field, cells, count, &candidates);
+	for (i = 0; updated && i < count; i++)
+		updated = nav_list_push_around(&candidates, field->map,
+				cells[i]);
+	if (updated)
+		seeds = malloc(sizeof(nav_seed_t) * (candidates.count + 1));
+	updated = updated && seeds;
+	for (i = 0; updated && i < candidates.count; i++)
+		if (nav_update_best(field, candidates.cells[i]))
+		{
+			seeds[seed_count].cell = candidates.cells[i];
+			seeds[seed_count++].cost =
+				field->cost[candidates.cells[i]];
+		}
+	if (updated)
+	{
+		qsort(seeds, seed_count, sizeof(nav_seed_t), nav_compare_seeds);
+		updated = nav_field_propagate(field, seeds, seed_count);
+	}
+	free(candidates.cells);
+	free(seeds);
+	field->valid = field->valid && updated;
+	return (updated);
+}
@@ -0,0 +1,172 @@
+#include "../../headers/maze.h"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+/**
+ * net_client_init - Opens a client of a server.
+ * @client: Pointer to the net_client_t struct to initialize.
+ * @host: The IPv4 address of the server, in dotted form.
+ * @port: The UDP port of the server.
+ * @tick_rate: The tick rate of the server.
+ *
+ * Description: The server learns of the client from its first input.
+ *
+ * Return: True on success, false if @host is not an address or no
+ * socket can be opened.
+ */
+bool net_client_init(net_client_t *client, const char *host, int port,
+		float tick_rate)
+{
+	memset(client, 0, sizeof(*client));
+	client->link.fd = -1;
+	client->tick_rate = tick_rate;
+	client->slot = -1;
+	client->server.sin_family = AF_INET;
+	client->server.sin_port = htons(port);
+	if (inet_pton(AF_INET, host, &client->server.sin_addr) != 1)
+		return (false);
+	return (net_link_open(&client->link, 0));
+}
+
+/**
+ * net_client_send - Sends the input of the local player to the server.
+ * @client: The client.
+ * @action: The walk and turn directions of the player.
+ * @now: The current time, in seconds.
+ *
+ * Description: The input also acknowledges the newest snapshot received,
+ * which the server then sends the next ones as deltas of.
+ *
+ * Return: True if the input was sent or queued, false if it was lost.
+ */
+bool net_client_send(net_client_t *client, const env_action_t *action,
+		double now)
+{
+	unsigned char data[11];
+	uint32_t seq = ++client->input_seq, acked = client->latest;
+	bool sent;
+	int i;
+
+	data[0] = NET_MSG_INPUT;
+	for (i = 0; i < 4; i++)
+	{
+		data[1 + i] = seq >> (8 * i) & 0xFF;
+		data[5 + i] = acked >> (8 * i) & 0xFF;
+	}
+	data[9] = (signed char)action->walk_direction;
+	data[10] = (signed char)action->turn_direction;
+	sent = net_link_send(&client->link, &client->server, data, 11, now);
+	net_link_flush(&client->link, now);
+	return (sent);
+}
+
+/**
+ * net_client_poll - Reads the snapshots the server sent.
+ * @client: The client.
+ * @now: The current time, in seconds.
+ *
+ * Description: Snapshots older than @client->history, or whose baseline
+ * has already left it, are dropped; the server sends a whole one once
+ * the acknowledgments catch up.
+ *
+ * Return: The number of snapshots read, or -1 if the server stopped.
+ */
+int net_client_poll(net_client_t *client, double now)
+{
+	unsigned char data[NET_MAX_PACKET];
+	struct sockaddr_in from;
+	net_snapshot_t snapshot;
+	int size, slot, count = 0;
+
+	net_link_flush(&client->link, now);
+	while ((size = net_link_receive(&client->link, data, &from)) > 0)
+	{
+		if (from.sin_addr.s_addr != client->server.sin_addr.s_addr ||
+				from.sin_port != client->server.sin_port)
+			continue;
+		if (data[0] == NET_MSG_BYE)
+			return (-1);
+		if (!net_snapshot_decode(data, size, client->history, &snapshot,
+					&slot) ||
+				snapshot.tick + NET_HISTORY <= client->latest)
+			continue;
+		client->history[snapshot.tick % NET_HISTORY] = snapshot;
+		client->received_bytes += size;
+		client->slot = slot;
+		if (snapshot.tick > client->latest)
+		{
+			client->latest = snapshot.tick;
+			client->latest_time = now;
+		}
+		count++;
+	}
+	return (count);
+}
+
+/**
+ * net_client_interpolate - Finds where a player is drawn at a time.
+ * @client: The client.
+ * @slot: The slot of the player, @client->slot for the local one.
+ * @now: The current time, in seconds.
+ * @player: Receives the position and rotation angle of the player.
+ *
+ * Description: Players are drawn NET_INTERP_TICKS ticks in the past, so
+ * that the two snapshots around that time have usually both arrived;
+ * the pose is blended between them, the angle along the shorter arc.
+ * Missing snapshots are skipped over, and past the newest one the player
+ * stays where it was.
+ *
+ * Return: True on success, false if the slot is empty at that time.
+ */
+bool net_client_interpolate(const net_client_t *client, int slot,
+		double now, player_t *player)
+{
+	const net_snapshot_t *from = NULL, *to = NULL, *snapshot;
+	const net_entity_t *a, *b;
+	double tick, blend;
+	uint32_t t;
+
+	tick = client->latest + (now - client->latest_time) * client->tick_rate
+		- NET_INTERP_TICKS;
+	for (t = client->latest; t > 0 && t + NET_HISTORY > client->latest; t--)
+	{
+		snapshot = &client->history[t % NET_HISTORY];
+		if (snapshot->tick != t)
+			continue;
+		if (t <= tick)
+		{
+			from = snapshot;
+			break;
+		}
+		to = snapshot;
+	}
+	from = from ? from : to, to = to ? to : from;
+	if (!from || slot < 0 || slot >= NET_MAX_PLAYERS)
+		return (false);
+	a = &from->entities[slot], b = &to->entities[slot];
+	if (!a->active || !b->active)
+		return (false);
+	blend = to == from ? 0 : (tick - from->tick) / (to->tick - from->tick);
+	blend = blend < 0 ? 0 : blend > 1 ? 1 : blend;
+	player->x = (a->x + ((double)b->x - a->x) * blend) / NET_POSITION_SCALE;
+	player->y = (a->y + ((double)b->y - a->y) * blend) / NET_POSITION_SCALE;
+	player->rotation_angle = (a->angle + (int16_t)(b->angle - a->angle) *
+			blend) * (2 * PI / 65536);
+	normalize_angle(&player->rotation_angle);
+	return (true);
+}
+
+/**
+ * net_client_free - Tells the server the client leaves and closes it.
+ * @client: The client.
+ */
+void net_client_free(net_client_t *client)
+{
+	unsigned char bye = NET_MSG_BYE;
+
+	if (client->link.fd >= 0)
+		sendto(client->link.fd, &bye, 1, 0,
+				(const struct sockaddr *)&client->server,
+				sizeof(client->server));
+	net_link_close(&client->link);
+}
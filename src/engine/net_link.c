@@ -0,0 +1,145 @@
+#include "../../headers/maze.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+/**
+ * net_link_open - Opens a non-blocking UDP socket.
+ * @link: Pointer to the net_link_t struct to initialize.
+ * @port: The port to listen on, or 0 for any free port.
+ *
+ * Description: The link starts as a perfect network; set @link->loss,
+ * @link->latency and @link->jitter afterwards to make it a bad one.
+ *
+ * Return: True on success, false if the socket cannot be opened.
+ */
+bool net_link_open(net_link_t *link, int port)
+{
+	struct sockaddr_in addr;
+
+	memset(link, 0, sizeof(*link));
+	link->seed = 0x9E3779B9u;
+	link->fd = socket(AF_INET, SOCK_DGRAM, 0);
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family = AF_INET;
+	addr.sin_addr.s_addr = htonl(INADDR_ANY);
+	addr.sin_port = htons(port);
+	if (link->fd < 0 || fcntl(link->fd, F_SETFL, O_NONBLOCK) != 0 ||
+			bind(link->fd, (struct sockaddr *)&addr,
+				sizeof(addr)) != 0)
+	{
+		net_link_close(link);
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * net_link_send - Sends a datagram through the simulated network.
+ * @link: The link.
+ * @to: The address to send to.
+ * @data: The datagram.
+ * @size: The number of bytes of @data, at most NET_MAX_PACKET.
+ * @now: The current time, in seconds.
+ *
+ * Description: The datagram is dropped with probability @link->loss,
+ * otherwise it is queued until @link->latency plus up to @link->jitter
+ * seconds have passed; net_link_flush() sends it then.
+ *
+ * Return: True if the datagram was sent or queued, false if it was lost.
+ */
+bool net_link_send(net_link_t *link, const struct sockaddr_in *to,
+		const unsigned char *data, int size, double now)
+{
+	net_packet_t *packet;
+	uint32_t roll;
+
+	link->seed ^= link->seed << 13; /* xorshift32 */
+	link->seed ^= link->seed >> 17;
+	link->seed ^= link->seed << 5;
+	roll = link->seed;
+	if (link->loss > 0 && (roll >> 8) < link->loss * (1 << 24))
+		return (link->dropped++, false);
+	if (link->latency <= 0 && link->jitter <= 0)
+	{
+		link->sent_bytes += size;
+		link->sent_packets++;
+		return (sendto(link->fd, data, size, 0,
+					(const struct sockaddr *)to,
+					sizeof(*to)) == size);
+	}
+	if (!link->queue)
+		link->queue = malloc(sizeof(net_packet_t) * NET_LINK_QUEUE);
+	if (!link->queue || link->queued == NET_LINK_QUEUE)
+		return (link->dropped++, false);
+	packet = &link->queue[link->queued++];
+	packet->due = now + link->latency + link->jitter * (roll & 0xFF) / 255;
+	packet->to = *to;
+	packet->size = size;
+	memcpy(packet->data, data, size);
+	return (true);
+}
+
+/**
+ * net_link_flush - Sends the queued datagrams whose time has come.
+ * @link: The link.
+ * @now: The current time, in seconds.
+ */
+void net_link_flush(net_link_t *link, double now)
+{
+	net_packet_t *packet;
+	int i = 0;
+
+	while (i < link->queued)
+	{
+		packet = &link->queue[i];
+		if (packet->due > now)
+		{
+			i++;
+			continue;
+		}
+		sendto(link->fd, packet->data, packet->size, 0,
+				(const struct sockaddr *)&packet->to,
+				sizeof(packet->to));
+		link->sent_bytes += packet->size;
+		link->sent_packets++;
+		*packet = link->queue[--link->queued];
+	}
+}
+
+/**
+ * net_link_receive - Reads the next datagram waiting on a link.
+ * @link: The link.
+ * @data: Receives the datagram, NET_MAX_PACKET bytes at most.
+ * @from: Receives the address of the sender.
+ *
+ * Return: The size of the datagram, 0 if none is waiting, or -1 on error.
+ */
+int net_link_receive(net_link_t *link, unsigned char *data,
+		struct sockaddr_in *from)
+{
+	socklen_t length = sizeof(*from);
+	ssize_t size;
+
+	size = recvfrom(link->fd, data, NET_MAX_PACKET, 0,
+			(struct sockaddr *)from, &length);
+	if (size < 0)
+		return (errno == EAGAIN || errno == EWOULDBLOCK ? 0 : -1);
+	return (size);
+}
+
+/**
+ * net_link_close - Closes a link and drops the datagrams it still holds.
+ * @link: The link.
+ */
+void net_link_close(net_link_t *link)
+{
+	if (link->fd >= 0)
+		close(link->fd);
+	link->fd = -1;
+	free(link->queue);
+	link->queue = NULL;
+	link->queued = 0;
+}
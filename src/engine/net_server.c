@@ -0,0 +1,193 @@
+#include "../../headers/maze.h"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+
+/**
+ * net_server_init - Opens a server on a port.
+ * @server: Pointer to the net_server_t struct to initialize.
+ * @map: The map the players move in.
+ * @port: The UDP port to listen on.
+ * @tick_rate: The number of ticks per second.
+ *
+ * Description: Players start at the center of the map, or in the
+ * nearest open cell, like the player of the game.
+ *
+ * Return: True on success, false if the port cannot be opened.
+ */
+bool net_server_init(net_server_t *server, const map_t *map, int port,
+		float tick_rate)
+{
+	memset(server->peers, 0, sizeof(server->peers));
+	memset(server->history, 0, sizeof(server->history));
+	server->map = map;
+	server->tick_rate = tick_rate;
+	server->tick = 0;
+	server->spawn_x = map->cols * TILE_SIZE / 2;
+	server->spawn_y = map->rows * TILE_SIZE / 2;
+	map_find_open_cell(&server->spawn_x, &server->spawn_y, map);
+	return (net_link_open(&server->link, port));
+}
+
+/**
+ * net_server_peer - Finds the slot of the client a datagram came from.
+ * @server: The server.
+ * @from: The address of the client.
+ * @now: The current time, in seconds.
+ * @join: Whether an unknown address may join.
+ *
+ * Description: An unknown address that joins takes the first free slot
+ * and a new player at the spawn point.
+ *
+ * Return: The slot, or -1 if the server is full or the address is
+ * unknown and may not join.
+ */
+static int net_server_peer(net_server_t *server,
+		const struct sockaddr_in *from, double now, bool join)
+{
+	net_peer_t *peer;
+	int i, free_slot = -1;
+
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		peer = &server->peers[i];
+		if (peer->connected && peer->addr.sin_port == from->sin_port
+				&& peer->addr.sin_addr.s_addr ==
+				from->sin_addr.s_addr)
+			return (i);
+		if (!peer->connected && free_slot < 0)
+			free_slot = i;
+	}
+	if (free_slot < 0 || !join)
+		return (-1);
+	peer = &server->peers[free_slot];
+	memset(peer, 0, sizeof(*peer));
+	peer->addr = *from;
+	peer->connected = true;
+	peer->heard = now;
+	player_init(&server->players[free_slot], server->spawn_x,
+			server->spawn_y);
+	return (free_slot);
+}
+
+/**
+ * net_server_receive - Applies the datagrams the clients sent.
+ * @server: The server.
+ * @now: The current time, in seconds.
+ *
+ * Description: An input datagram holds its sequence number, the newest
+ * snapshot tick the client has and its walk and turn directions, which
+ * are kept to -1, 0 or 1; older inputs overtaken by a newer one are
+ * ignored. A bye frees the slot of a known client; one from an unknown
+ * address is ignored, so it takes no slot.
+ */
+static void net_server_receive(net_server_t *server, double now)
+{
+	unsigned char data[NET_MAX_PACKET];
+	struct sockaddr_in from;
+	uint32_t seq, acked;
+	int size, slot;
+	net_peer_t *peer;
+
+	while ((size = net_link_receive(&server->link, data, &from)) > 0)
+	{
+		if ((data[0] != NET_MSG_INPUT || size != 11) &&
+				data[0] != NET_MSG_BYE)
+			continue;
+		slot = net_server_peer(server, &from, now,
+				data[0] == NET_MSG_INPUT);
+		if (slot < 0)
+			continue;
+		peer = &server->peers[slot];
+		peer->heard = now;
+		if (data[0] == NET_MSG_BYE)
+		{
+			peer->connected = false;
+			continue;
+		}
+		seq = data[1] | data[2] << 8 | data[3] << 16 |
+			(uint32_t)data[4] << 24;
+		acked = data[5] | data[6] << 8 | data[7] << 16 |
+			(uint32_t)data[8] << 24;
+		if (acked > peer->acked && acked <= server->tick)
+			peer->acked = acked;
+		if (seq <= peer->input_seq)
+			continue;
+		peer->input_seq = seq;
+		server->players[slot].walk_direction = (data[9] == 1) -
+			(data[9] == 0xFF);
+		server->players[slot].turn_direction = (data[10] == 1) -
+			(data[10] == 0xFF);
+	}
+}
+
+/**
+ * net_server_tick - Runs one tick of the simulation.
+ * @server: The server.
+ * @now: The current time, in seconds.
+ *
+ * Description: The inputs received are applied, clients not heard from
+ * for NET_TIMEOUT seconds are dropped, every player moves by one tick
+ * with collisions, and each client is sent the quantized snapshot.
+ */
+void net_server_tick(net_server_t *server, double now)
+{
+	net_snapshot_t *snapshot, *base;
+	unsigned char data[NET_MAX_PACKET];
+	net_entity_t *entity;
+	player_t *player;
+	int i, size;
+
+	net_server_receive(server, now);
+	snapshot = &server->history[++server->tick % NET_HISTORY];
+	memset(snapshot, 0, sizeof(*snapshot));
+	snapshot->tick = server->tick;
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		if (server->peers[i].connected && now - server->peers[i].heard >
+				NET_TIMEOUT)
+			server->peers[i].connected = false;
+		if (!server->peers[i].connected)
+			continue;
+		player = &server->players[i], entity = &snapshot->entities[i];
+		move_player(1 / server->tick_rate, player, server->map);
+		entity->active = true;
+		entity->x = player->x * NET_POSITION_SCALE + 0.5f;
+		entity->y = player->y * NET_POSITION_SCALE + 0.5f;
+		entity->angle = (long)(player->rotation_angle / (2 * PI) *
+				65536 + 0.5) & 0xFFFF;
+	}
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		if (!server->peers[i].connected)
+			continue;
+		base = &server->history[server->peers[i].acked % NET_HISTORY];
+		base = server->peers[i].acked && base->tick ==
+			server->peers[i].acked ? base : NULL;
+		size = net_snapshot_encode(snapshot, base, i, data);
+		server->peers[i].sent_bytes += size;
+		net_link_send(&server->link, &server->peers[i].addr, data, size,
+				now);
+	}
+	net_link_flush(&server->link, now);
+}
+
+/**
+ * net_server_free - Tells the clients the server stops and closes it.
+ * @server: The server.
+ */
+void net_server_free(net_server_t *server)
+{
+	unsigned char bye = NET_MSG_BYE;
+	const struct sockaddr_in *to;
+	int i;
+
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		to = &server->peers[i].addr;
+		if (server->peers[i].connected)
+			sendto(server->link.fd, &bye, 1, 0,
+					(const struct sockaddr *)to,
+					sizeof(*to));
+	}
+	net_link_close(&server->link);
+}
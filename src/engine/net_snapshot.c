@@ -0,0 +1,172 @@
+#include "../../headers/maze.h"
+
+/**
+ * net_put_u32 - Writes a 32-bit value, least significant byte first.
+ * @data: The buffer.
+ * @pos: The offset to write at, advanced past the value.
+ * @value: The value.
+ * @varint: A flag to write @value zigzag encoded, 7 bits per byte,
+ * which makes small deltas of either sign one or two bytes long.
+ */
+static void net_put_u32(unsigned char *data, int *pos, uint32_t value,
+		bool varint)
+{
+	int i;
+
+	if (!varint)
+	{
+		for (i = 0; i < 4; i++)
+			data[(*pos)++] = value >> (8 * i) & 0xFF;
+		return;
+	}
+	value = value << 1 ^ (uint32_t)-(int32_t)(value >> 31);
+	while (value >= 0x80)
+	{
+		data[(*pos)++] = (value & 0x7F) | 0x80;
+		value >>= 7;
+	}
+	data[(*pos)++] = value;
+}
+
+/**
+ * net_get_u32 - Reads a value written by net_put_u32().
+ * @data: The buffer.
+ * @size: The number of bytes of @data.
+ * @pos: The offset to read at, advanced past the value.
+ * @value: Receives the value.
+ * @varint: A flag to read a zigzag encoded value.
+ *
+ * Return: True on success, false if @data ends first.
+ */
+static bool net_get_u32(const unsigned char *data, int size, int *pos,
+		uint32_t *value, bool varint)
+{
+	int shift, count = varint ? 5 : 4;
+
+	*value = 0;
+	for (shift = 0; count-- > 0; shift += varint ? 7 : 8)
+	{
+		if (*pos >= size)
+			return (false);
+		*value |= (uint32_t)(data[*pos] & (varint ? 0x7F : 0xFF)) <<
+			shift;
+		if (varint && !(data[(*pos)++] & 0x80))
+			break;
+		if (!varint)
+			(*pos)++;
+	}
+	if (varint)
+		*value = *value >> 1 ^ (uint32_t)-(int32_t)(*value & 1);
+	return (true);
+}
+
+/**
+ * net_snapshot_encode - Writes a snapshot as a delta from a baseline.
+ * @snapshot: The snapshot.
+ * @base: A snapshot the client holds, or NULL to send @snapshot whole.
+ * @slot: The slot of the client the datagram is for.
+ * @data: Receives the datagram, NET_MAX_PACKET bytes at most.
+ *
+ * Description: After the message type, the tick, the tick of @base (0
+ * for none) and @slot, a bitmask lists the slots that differ from
+ * @base. Each of them has a byte of flags: active, then which of x, y
+ * and angle changed, followed by the zigzag varint delta of each changed
+ * field. A client standing still costs nothing past the header.
+ *
+ * Return: The size of the datagram.
+ */
+int net_snapshot_encode(const net_snapshot_t *snapshot,
+		const net_snapshot_t *base, int slot, unsigned char *data)
+{
+	static const net_snapshot_t none;
+	const net_entity_t *now, *old;
+	uint32_t mask[NET_MAX_PLAYERS / 32] = {0};
+	int i, pos = 0, flags[NET_MAX_PLAYERS];
+
+	data[pos++] = NET_MSG_SNAPSHOT;
+	net_put_u32(data, &pos, snapshot->tick, false);
+	net_put_u32(data, &pos, base ? base->tick : 0, false);
+	data[pos++] = slot;
+	base = base ? base : &none;
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		now = &snapshot->entities[i], old = &base->entities[i];
+		flags[i] = now->active | (now->x != old->x) << 1 |
+			(now->y != old->y) << 2 |
+			(now->angle != old->angle) << 3;
+		if (now->active != old->active || (now->active && flags[i] > 1))
+			mask[i / 32] |= (uint32_t)1 << i % 32;
+	}
+	for (i = 0; i < NET_MAX_PLAYERS / 32; i++)
+		net_put_u32(data, &pos, mask[i], false);
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		if (!(mask[i / 32] >> i % 32 & 1))
+			continue;
+		now = &snapshot->entities[i], old = &base->entities[i];
+		data[pos++] = now->active ? flags[i] : 0;
+		if (now->active && flags[i] & 2)
+			net_put_u32(data, &pos, now->x - old->x, true);
+		if (now->active && flags[i] & 4)
+			net_put_u32(data, &pos, now->y - old->y, true);
+		if (now->active && flags[i] & 8)
+			net_put_u32(data, &pos, (int16_t)(now->angle -
+						old->angle), true);
+	}
+	return (pos);
+}
+
+/**
+ * net_snapshot_decode - Reads a datagram written by net_snapshot_encode().
+ * @data: The datagram.
+ * @size: The number of bytes of @data.
+ * @history: The NET_HISTORY snapshots already received, by tick %
+ * NET_HISTORY, where the baseline of the datagram is looked up.
+ * @snapshot: Receives the snapshot.
+ * @slot: Receives the slot of the client.
+ *
+ * Return: True on success, false if the datagram is malformed or its
+ * baseline is no longer in @history.
+ */
+bool net_snapshot_decode(const unsigned char *data, int size,
+		const net_snapshot_t *history, net_snapshot_t *snapshot,
+		int *slot)
+{
+	static const net_snapshot_t none;
+	uint32_t tick, baseline, mask[NET_MAX_PLAYERS / 32], delta[3];
+	net_entity_t *entity;
+	int i, pos = 1, flags, bit;
+	const net_snapshot_t *base = &none;
+
+	if (size < 10 || data[0] != NET_MSG_SNAPSHOT)
+		return (false);
+	net_get_u32(data, size, &pos, &tick, false);
+	net_get_u32(data, size, &pos, &baseline, false);
+	*slot = data[pos++];
+	if (baseline && history[baseline % NET_HISTORY].tick != baseline)
+		return (false);
+	base = baseline ? &history[baseline % NET_HISTORY] : base;
+	for (i = 0; i < NET_MAX_PLAYERS / 32; i++)
+		if (!net_get_u32(data, size, &pos, &mask[i], false))
+			return (false);
+	*snapshot = *base;
+	snapshot->tick = tick;
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+	{
+		if (!(mask[i / 32] >> i % 32 & 1))
+			continue;
+		if (pos >= size)
+			return (false);
+		flags = data[pos++], entity = &snapshot->entities[i];
+		delta[0] = delta[1] = delta[2] = 0;
+		for (bit = 0; bit < 3; bit++)
+			if (flags & 2 << bit && !net_get_u32(data, size, &pos,
+						&delta[bit], true))
+				return (false);
+		*entity = flags & 1 ? *entity : none.entities[i];
+		entity->active = flags & 1;
+		entity->x += delta[0], entity->y += delta[1];
+		entity->angle += delta[2];
+	}
+	return (*slot < NET_MAX_PLAYERS);
+}
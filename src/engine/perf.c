@@ -0,0 +1,152 @@
+#include "../../headers/maze.h"
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/**
+ * perf_open_event - Opens a counter of the calling thread.
+ * @event: The perf_event_t to count.
+ * @group: The counter leading the group, or -1 to open a new group,
+ * which starts disabled.
+ *
+ * Description: Only user space is counted, which unprivileged processes
+ * are allowed to do with the default perf_event_paranoid setting.
+ *
+ * Return: The file descriptor of the counter, or -1 with errno set.
+ */
+static int perf_open_event(int event, int group)
+{
+	static const uint32_t types[PERF_EVENTS] = {PERF_TYPE_SOFTWARE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE, PERF_TYPE_HW_CACHE,
+		PERF_TYPE_HARDWARE, PERF_TYPE_HARDWARE};
+	static const uint64_t configs[PERF_EVENTS] = {PERF_COUNT_SW_TASK_CLOCK,
+		PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+		PERF_COUNT_HW_CACHE_L1D | PERF_COUNT_HW_CACHE_OP_READ << 8 |
+			PERF_COUNT_HW_CACHE_RESULT_MISS << 16,
+		PERF_COUNT_HW_CACHE_MISSES, PERF_COUNT_HW_BRANCH_MISSES};
+	struct perf_event_attr attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = types[event];
+	attr.size = sizeof(attr);
+	attr.config = configs[event];
+	attr.disabled = group < 0;
+	attr.exclude_kernel = 1;
+	attr.exclude_hv = 1;
+	attr.read_format = PERF_FORMAT_GROUP |
+		PERF_FORMAT_TOTAL_TIME_ENABLED | PERF_FORMAT_TOTAL_TIME_RUNNING;
+	return (syscall(SYS_perf_event_open, &attr, 0, -1, group, 0));
+}
+
+/**
+ * perf_read - Reads every counter of the group at once.
+ * @perf: Pointer to the perf_counters_t struct, which is active.
+ * @values: Receives the count of each event, scaled up by the time the
+ * group was not scheduled, or 0 for events that are not open.
+ *
+ * Return: True on success, false if the group could not be read.
+ */
+static bool perf_read(const perf_counters_t *perf, uint64_t *values)
+{
+	uint64_t data[3 + PERF_EVENTS];
+	ssize_t size = read(perf->fds[0], data, sizeof(data));
+	double scale;
+	int event;
+
+	if (size < (ssize_t)(sizeof(uint64_t) * (3 + perf->count)))
+		return (false);
+	/* The group was enabled data[1] ns and running data[2] ns */
+	scale = data[2] ? (double)data[1] / data[2] : 0;
+	for (event = 0; event < PERF_EVENTS; event++)
+		values[event] = perf->slots[event] < 0 ? 0 :
+			(uint64_t)(data[3 + perf->slots[event]] * scale);
+	return (true);
+}
+
+/**
+ * perf_init - Starts counting the events of the calling thread.
+ * @perf: Pointer to the perf_counters_t struct to initialize.
+ *
+ * Description: Each hardware event the processor, kernel or container
+ * does not offer is left out and reported as unavailable; the task
+ * clock alone still times every stage.
+ *
+ * Return: True if the counters run, false if not even the task clock
+ * can be opened, in which case @error tells why and every mark is a
+ * no-op.
+ */
+bool perf_init(perf_counters_t *perf)
+{
+	int event;
+
+	memset(perf, 0, sizeof(*perf));
+	for (event = 0; event < PERF_EVENTS; event++)
+		perf->fds[event] = perf->slots[event] = -1;
+	for (event = 0; event < PERF_EVENTS; event++)
+	{
+		perf->fds[event] = perf_open_event(event,
+				event ? perf->fds[0] : -1);
+		if (perf->fds[event] >= 0)
+			perf->slots[event] = perf->count++;
+		else if (event == 0)
+		{
+			perf->error = errno;
+			return (false);
+		}
+	}
+	if (ioctl(perf->fds[0], PERF_EVENT_IOC_ENABLE,
+				PERF_IOC_FLAG_GROUP) < 0 ||
+			!perf_read(perf, perf->last))
+	{
+		perf->error = errno;
+		perf_close(perf);
+		return (false);
+	}
+	perf->active = true;
+	return (true);
+}
+
+/**
+ * perf_mark - Ends a stage, charging it what was counted since the last
+ * mark.
+ * @perf: Pointer to the perf_counters_t struct, or NULL.
+ * @stage: The stage that just ended.
+ *
+ * Description: Does nothing without active counters, so marks can stay
+ * in place whether or not the counters run. Scaled counts may step back
+ * a little when the group is multiplexed; that is not charged twice.
+ */
+void perf_mark(perf_counters_t *perf, perf_stage_t stage)
+{
+	uint64_t now[PERF_EVENTS];
+	int event;
+
+	if (!perf || !perf->active || !perf_read(perf, now))
+		return;
+	for (event = 0; event < PERF_EVENTS; event++)
+		if (now[event] > perf->last[event])
+		{
+			perf->frame[stage][event] += now[event] -
+				perf->last[event];
+			perf->last[event] = now[event];
+		}
+}
+
+/**
+ * perf_close - Stops counting.
+ * @perf: Pointer to the perf_counters_t struct, whose counts are kept
+ * for perf_report().
+ */
+void perf_close(perf_counters_t *perf)
+{
+	int event;
+
+	for (event = PERF_EVENTS - 1; event >= 0; event--)
+		if (perf->fds[event] >= 0)
+			close(perf->fds[event]);
+	for (event = 0; event < PERF_EVENTS; event++)
+		perf->fds[event] = -1;
+	perf->active = false;
+}
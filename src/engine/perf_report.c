@@ -0,0 +1,132 @@
+#include "../../headers/maze.h"
+#include <errno.h>
+
+/**
+ * perf_stage_name - Names a stage of a frame.
+ * @stage: The stage.
+ *
+ * Return: The name of @stage, as the reports print it.
+ */
+const char *perf_stage_name(perf_stage_t stage)
+{
+	static const char * const names[PERF_STAGES] = {"input", "move",
+		"cast", "floor", "ceiling", "walls", "minimap", "present"};
+
+	return (stage < PERF_STAGES ? names[stage] : "?");
+}
+
+/**
+ * perf_log_frame - Writes the counts of the current frame as CSV rows.
+ * @perf: Pointer to the perf_counters_t struct.
+ * @log: The file to write to.
+ *
+ * Description: One row per stage, after a header before the first
+ * frame. The fields of events that are not available are left empty.
+ */
+static void perf_log_frame(const perf_counters_t *perf, FILE *log)
+{
+	int stage, event;
+
+	if (perf->frames == 0)
+		fprintf(log, "frame,stage,task_clock_ns,cycles,instructions,"
+				"l1d_read_misses,llc_misses,branch_misses\n");
+	for (stage = 0; stage < PERF_STAGES; stage++)
+	{
+		fprintf(log, "%lu,%s", (unsigned long)perf->frames,
+				perf_stage_name(stage));
+		for (event = 0; event < PERF_EVENTS; event++)
+			if (perf->slots[event] < 0)
+				fputc(',', log);
+			else
+				fprintf(log, ",%lu", (unsigned long)
+						perf->frame[stage][event]);
+		fputc('\n', log);
+	}
+}
+
+/**
+ * perf_frame_end - Adds the counts of a frame to the totals.
+ * @perf: Pointer to the perf_counters_t struct, or NULL.
+ * @log: The file the counts of every frame are written to, or NULL.
+ *
+ * Description: The last stage of the frame has to be marked first. Does
+ * nothing without active counters.
+ */
+void perf_frame_end(perf_counters_t *perf, FILE *log)
+{
+	int stage, event;
+
+	if (!perf || !perf->active)
+		return;
+	if (log)
+		perf_log_frame(perf, log);
+	for (stage = 0; stage < PERF_STAGES; stage++)
+		for (event = 0; event < PERF_EVENTS; event++)
+			perf->total[stage][event] += perf->frame[stage][event];
+	memset(perf->frame, 0, sizeof(perf->frame));
+	perf->frames++;
+}
+
+/**
+ * perf_report_row - Prints the counts of a stage per frame.
+ * @perf: Pointer to the perf_counters_t struct.
+ * @name: The name of the row.
+ * @counts: The counts of each event, summed over every frame.
+ * @file: The stream to print to.
+ */
+static void perf_report_row(const perf_counters_t *perf, const char *name,
+		const uint64_t *counts, FILE *file)
+{
+	double frames = perf->frames ? perf->frames : 1;
+	int event;
+
+	fprintf(file, "%-8s %9.1f", name, counts[PERF_TASK_CLOCK] / 1e3 /
+			frames);
+	for (event = PERF_CYCLES; event < PERF_EVENTS; event++)
+		if (perf->slots[event] < 0)
+			fprintf(file, " %12s", "n/a");
+		else
+			fprintf(file, " %12.0f", counts[event] / frames);
+	if (perf->slots[PERF_CYCLES] < 0 || !counts[PERF_CYCLES] ||
+			perf->slots[PERF_INSTRUCTIONS] < 0)
+		fprintf(file, " %5s\n", "n/a");
+	else
+		fprintf(file, " %5.2f\n", (double)counts[PERF_INSTRUCTIONS] /
+				counts[PERF_CYCLES]);
+}
+
+/**
+ * perf_report - Prints the counts of each stage per frame.
+ * @perf: Pointer to the perf_counters_t struct, from perf_init().
+ * @file: The stream to print to.
+ *
+ * Description: Events that could not be counted show n/a; counters that
+ * could not be opened at all print why instead.
+ */
+void perf_report(const perf_counters_t *perf, FILE *file)
+{
+	uint64_t sum[PERF_EVENTS] = {0};
+	int stage, event;
+
+	if (perf->slots[PERF_TASK_CLOCK] < 0)
+	{
+		fprintf(file, "Performance counters unavailable: %s%s\n",
+				strerror(perf->error), perf->error == EACCES ||
+				perf->error == EPERM ? " (see /proc/sys/kernel/"
+				"perf_event_paranoid)" : "");
+		return;
+	}
+	fprintf(file, "Performance counters over %lu frames, per frame:\n"
+			"%-8s %9s %12s %12s %12s %12s %12s %5s\n",
+			(unsigned long)perf->frames, "stage", "time us",
+			"cycles", "instructions", "L1D misses", "LLC misses",
+			"br misses", "IPC");
+	for (stage = 0; stage < PERF_STAGES; stage++)
+	{
+		perf_report_row(perf, perf_stage_name(stage),
+				perf->total[stage], file);
+		for (event = 0; event < PERF_EVENTS; event++)
+			sum[event] += perf->total[stage][event];
+	}
+	perf_report_row(perf, "frame", sum, file);
+}
@@ -0,0 +1,161 @@
+#include "../../headers/maze.h"
+
+/**
+ * render_plane_64 - Renders a floor or ceiling span with a 64x64 texture.
+ * @first_row: The first screen row of the span.
+ * @last_row: The screen row after the last one of the span.
+ * @plane: Pointer to the per-column constants of the span.
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: The wrapping masks and row shift are constants here, which
+ * is the case of every texture shipped with the game.
+ */
+static void render_plane_64(int first_row, int last_row,
+		const plane_column_t *plane, view_t *view)
+{
+	int row, offset_x, offset_y,
+	    half_height = view->frame.height / 2;
+	float distance, ratio;
+	const player_t *player = view->player;
+	const color_t *texels = plane->texture->texture_buffer;
+
+	for (row = first_row; row < last_row; row++)
+	{
+		ratio = player->height / (row - half_height);
+		distance = (ratio * view->dist_proj_plane) /
+			plane->cos_correction;
+		offset_y = floor((distance * plane->sin_angle) + player->y);
+		offset_x = floor((distance * plane->cos_angle) + player->x);
+		draw_pixel(plane->column, row,
+			texels[((offset_y & 63) << 6) | (offset_x & 63)],
+			&view->frame);
+	}
+}
+
+/**
+ * render_plane_any - Renders a floor or ceiling span with any atlas tile.
+ * @first_row: The first screen row of the span.
+ * @last_row: The screen row after the last one of the span.
+ * @plane: Pointer to the per-column constants of the span.
+ * @view: Pointer to the view_t struct being rendered.
+ */
+static void render_plane_any(int first_row, int last_row,
+		const plane_column_t *plane, view_t *view)
+{
+	int row, offset_x, offset_y,
+	    half_height = view->frame.height / 2,
+	    mask_x = plane->texture->width - 1,
+	    mask_y = plane->texture->height - 1,
+	    shift = plane->texture->width_shift;
+	float distance, ratio;
+	const player_t *player = view->player;
+	const color_t *texels = plane->texture->texture_buffer;
+
+	for (row = first_row; row < last_row; row++)
+	{
+		ratio = player->height / (row - half_height);
+		distance = (ratio * view->dist_proj_plane) /
+			plane->cos_correction;
+		offset_y = floor((distance * plane->sin_angle) + player->y);
+		offset_x = floor((distance * plane->cos_angle) + player->x);
+		draw_pixel(plane->column, row, texels[
+				((offset_y & mask_y) << shift) |
+				(offset_x & mask_x)], &view->frame);
+	}
+}
+
+/**
+ * render_plane_lit - Renders a floor or ceiling span shaded by a lightmap.
+ * @first_row: The first screen row of the span.
+ * @last_row: The screen row after the last one of the span.
+ * @plane: Pointer to the per-column constants of the span.
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: The span crosses few cells, so the level and its row of
+ * the multiply table are only looked up again once the texel leaves the
+ * cell of the last lookup, like walls look their level up per column.
+ * Texels off the map keep the level of the last cell.
+ */
+static void render_plane_lit(int first_row, int last_row,
+		const plane_column_t *plane, view_t *view)
+{
+	int row, offset_x, offset_y, cols = view->world->map->cols,
+	    half_height = view->frame.height / 2,
+	    mask_x = plane->texture->width - 1,
+	    mask_y = plane->texture->height - 1,
+	    shift = plane->texture->width_shift;
+	unsigned int width = cols * TILE_SIZE,
+		     height = view->world->map->rows * TILE_SIZE,
+		     cell_x = width, cell_y = height;
+	const player_t *player = view->player;
+	const lightmap_t *lightmap = view->world->lightmap;
+	const color_t *texels = plane->texture->texture_buffer;
+	const unsigned char *shade = lightmap->shade[lightmap->cells[
+		(long)(player->y / TILE_SIZE) * cols +
+		(long)(player->x / TILE_SIZE)]];
+	float distance;
+	color_t texel;
+
+	for (row = first_row; row < last_row; row++)
+	{
+		distance = (player->height / (row - half_height) *
+				view->dist_proj_plane) / plane->cos_correction;
+		offset_y = floor((distance * plane->sin_angle) + player->y);
+		offset_x = floor((distance * plane->cos_angle) + player->x);
+		if ((offset_x - cell_x >= TILE_SIZE ||
+					offset_y - cell_y >= TILE_SIZE) &&
+				(unsigned int)offset_x < width &&
+				(unsigned int)offset_y < height)
+		{
+			cell_x = offset_x & -TILE_SIZE;
+			cell_y = offset_y & -TILE_SIZE;
+			shade = lightmap->shade[lightmap->cells[cell_y /
+				TILE_SIZE * (long)cols + cell_x / TILE_SIZE]];
+		}
+		texel = texels[((offset_y & mask_y) << shift) |
+			(offset_x & mask_x)];
+		draw_pixel(plane->column, row, (texel & 0xFF000000) |
+				shade[texel >> 16 & 0xFF] << 16 |
+				shade[texel >> 8 & 0xFF] << 8 |
+				shade[texel & 0xFF], &view->frame);
+	}
+}
+
+/**
+ * render_plane - Renders the floor or the ceiling of one screen column.
+ * @first_row: The first screen row to render.
+ * @last_row: The screen row after the last one to render.
+ * @direction: 1 for the floor, -1 for the ceiling.
+ * @texture: Pointer to the atlas tile mapped on the plane.
+ * @column: The screen column to render.
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: The trigonometry of the ray is computed once per column,
+ * and the texture coordinates wrap with masks, which works for negative
+ * coordinates as well since atlas tiles are powers of two.
+ */
+void render_plane(int first_row, int last_row, float direction,
+		const texture_t *texture, int column, view_t *view)
+{
+	plane_column_t plane;
+	float ray_angle = view->rays.ray_angle[column];
+	int rows;
+
+	plane.texture = texture;
+	plane.column = column;
+	plane.cos_angle = direction * cos(ray_angle);
+	plane.sin_angle = direction * sin(ray_angle);
+	plane.cos_correction = cos(ray_angle - view->player->rotation_angle);
+	rows = last_row > first_row ? last_row - first_row : 0;
+	view->stats.texel_fetches += rows;
+	if (direction > 0)
+		view->stats.floor_pixels += rows;
+	else
+		view->stats.ceiling_pixels += rows;
+	if (view->world->lightmap)
+		render_plane_lit(first_row, last_row, &plane, view);
+	else if (texture->width == 64 && texture->height == 64)
+		render_plane_64(first_row, last_row, &plane, view);
+	else
+		render_plane_any(first_row, last_row, &plane, view);
+}
@@ -1,4 +1,23 @@
-#include "../headers/headers.h"
+#include "../../headers/maze.h"
+
+/**
+ * player_init - Places a player at a position with the default settings.
+ * @player: Pointer to the player_t struct to initialize.
+ * @x: The x-coordinate of the player's position.
+ * @y: The y-coordinate of the player's position.
+ */
+void player_init(player_t *player, float x, float y)
+{
+	player->x = x;
+	player->y = y;
+	player->width = 1;
+	player->height = 30;
+	player->turn_direction = 0;
+	player->walk_direction = 0;
+	player->rotation_angle = PI / 2;
+	player->walk_speed = 100;
+	player->turn_speed = 45 * (PI / 180);
+}
 
 /**
  * normalize_angle - Normalizes the angle to be within the range of -π to π.
@@ -18,7 +37,7 @@ void normalize_angle(float *angle)
  * @player: Pointer to the player_t struct.
  * @map: An instance of the map_t struct representing map data.
  */
-void move_player(float delta_time, player_t *player, map_t *map)
+void move_player(float delta_time, player_t *player, const map_t *map)
 {
 	float move_step, new_player_x, new_player_y;
 
@@ -58,7 +77,7 @@ void move_player(float delta_time, player_t *player, map_t *map)
  * @map: An instance of the map_t struct representing map data.
  *
  */
-void handle_wall_collision(player_t *player, map_t *map)
+void handle_wall_collision(player_t *player, const map_t *map)
 {
 	float slide_x, slide_y, slide_step;
 
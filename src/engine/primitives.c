@@ -0,0 +1,143 @@
+#include "../../headers/maze.h"
+
+/**
+ * struct line_axis_s - One axis of a line being rasterized.
+ *
+ * @start: The coordinate of the first point on this axis.
+ * @sign: The direction the line moves along this axis, -1, 0 or 1.
+ * @limit: The size of the framebuffer along this axis.
+ * @length: The absolute distance covered along this axis.
+ */
+typedef struct line_axis_s
+{
+	long start;
+	int sign;
+	int limit;
+	long length;
+} line_axis_t;
+
+/**
+ * ceil_div - Divides rounding towards positive infinity.
+ * @a: The dividend.
+ * @b: The divisor, which must be positive.
+ *
+ * Return: The smallest integer not less than @a / @b.
+ */
+static long ceil_div(long a, long b)
+{
+	return (a >= 0 ? (a + b - 1) / b : -(-a / b));
+}
+
+/**
+ * line_clip - Finds the steps of a line that land inside the framebuffer.
+ * @major: The axis the line advances by one pixel every step.
+ * @minor: The other axis, advanced by Bresenham's error term.
+ * @first: Set to the first visible step.
+ * @last: Set to the last visible step.
+ *
+ * Description: Step i lands at offset m(i) = floor((2 i minor + major) /
+ * (2 major)) on the minor axis, so the visible steps are found by solving
+ * for i once per line instead of testing each pixel.
+ *
+ * Return: True if at least one step is visible, false otherwise.
+ */
+static bool line_clip(const line_axis_t *major, const line_axis_t *minor,
+		long *first, long *last)
+{
+	long lo, hi;
+
+	lo = major->sign > 0 ? -major->start : major->start - major->limit + 1;
+	hi = major->sign > 0 ? major->limit - 1 - major->start : major->start;
+	*first = lo > 0 ? lo : 0;
+	*last = hi < major->length - 1 ? hi : major->length - 1;
+	lo = minor->sign >= 0 ? -minor->start : minor->start - minor->limit + 1;
+	hi = minor->sign >= 0 ? minor->limit - 1 - minor->start : minor->start;
+	if (minor->length == 0)
+		return (lo <= 0 && hi >= 0 && *first <= *last);
+	lo = ceil_div((2 * lo - 1) * major->length, 2 * minor->length);
+	hi = ceil_div((2 * hi + 1) * major->length, 2 * minor->length) - 1;
+	*first = lo > *first ? lo : *first;
+	*last = hi < *last ? hi : *last;
+	return (*first <= *last);
+}
+
+/**
+ * draw_line - Draw a line between two points using Bresenham's algorithm
+ * @x0: X-coordinate of the start point
+ * @y0: Y-coordinate of the start point
+ * @x1: X-coordinate of the end point, which is not drawn
+ * @y1: Y-coordinate of the end point, which is not drawn
+ * @color: Color of the line
+ * @frame: Pointer to the framebuffer_t struct to draw into.
+ *
+ * Description: The line is clipped once against the framebuffer, then
+ * walked with an integer error term writing straight to the pixels.
+ */
+void draw_line(
+	int x0, int y0, int x1, int y1,
+	color_t color, framebuffer_t *frame)
+{
+	line_axis_t ax, ay;
+	const line_axis_t *major, *minor;
+	long first, last, error, two_major, two_minor, step_major, step_minor;
+	color_t *pixel;
+
+	ax.start = x0, ax.limit = frame->width;
+	ax.sign = x1 > x0 ? 1 : x1 < x0 ? -1 : 0, ax.length = labs(x1 - x0);
+	ay.start = y0, ay.limit = frame->height;
+	ay.sign = y1 > y0 ? 1 : y1 < y0 ? -1 : 0, ay.length = labs(y1 - y0);
+	major = ax.length >= ay.length ? &ax : &ay;
+	minor = major == &ax ? &ay : &ax;
+	if (!line_clip(major, minor, &first, &last))
+		return;
+	two_major = 2 * major->length;
+	two_minor = 2 * minor->length;
+	error = first * two_minor + major->length;
+	step_major = major == &ax ? ax.sign : (long)ay.sign * frame->pitch;
+	step_minor = major == &ax ? (long)ay.sign * frame->pitch : ax.sign;
+	pixel = frame->pixels + (major->start + major->sign * first) *
+		(major == &ax ? 1 : frame->pitch) +
+		(minor->start + minor->sign * (error / two_major)) *
+		(major == &ax ? frame->pitch : 1);
+	for (error %= two_major; first <= last; first++)
+	{
+		*pixel = color;
+		pixel += step_major;
+		error += two_minor;
+		if (error >= two_major)
+		{
+			error -= two_major;
+			pixel += step_minor;
+		}
+	}
+}
+
+/**
+ * draw_rect - Draws a rectangle on the screen.
+ * @x: The x-coordinate of the top-left corner of the rectangle.
+ * @y: The y-coordinate of the top-left corner of the rectangle.
+ * @width: The width of the rectangle.
+ * @height: The height of the rectangle.
+ * @color: The color to be used for the rectangle.
+ * @frame: Pointer to the framebuffer_t struct to draw into.
+ *
+ * Description: The rectangle is clipped once, then filled one row span
+ * at a time.
+ */
+void draw_rect(
+	int x, int y, int width, int height,
+	color_t color, framebuffer_t *frame)
+{
+	int x0 = x > 0 ? x : 0, y0 = y > 0 ? y : 0;
+	int x1 = x + width < frame->width ? x + width : frame->width;
+	int y1 = y + height < frame->height ? y + height : frame->height;
+	color_t *row;
+	int i;
+
+	for (; y0 < y1; y0++)
+	{
+		row = frame->pixels + (long)frame->pitch * y0;
+		for (i = x0; i < x1; i++)
+			row[i] = color;
+	}
+}
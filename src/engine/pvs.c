@@ -0,0 +1,147 @@
+#include "../../headers/maze.h"
+
+/**
+ * pvs_seeable - Flags the cells a line of sight can reach.
+ * @map: The map.
+ *
+ * Description: A segment only reaches a wall from an open cell next to
+ * it, so walls buried among other walls are never tested.
+ *
+ * Return: One byte per cell: 2 for open cells, 1 for walls touching an
+ * open cell and 0 for the other walls, or NULL if memory allocation
+ * failed.
+ */
+static unsigned char *pvs_seeable(const map_t *map)
+{
+	unsigned char *seeable = malloc((size_t)map->rows * map->cols);
+	long cell, size = (long)map->rows * map->cols;
+	int row, col, r, c;
+
+	if (!seeable)
+		return (NULL);
+	for (cell = 0; cell < size; cell++)
+	{
+		row = cell / map->cols;
+		col = cell % map->cols;
+		seeable[cell] = map->cells[cell] ? 0 : 2;
+		for (r = row - 1; r <= row + 1 && !seeable[cell]; r++)
+			for (c = col - 1; c <= col + 1; c++)
+				if (r >= 0 && r < map->rows && c >= 0 &&
+						c < map->cols &&
+						!get_map_at(r, c, map))
+					seeable[cell] = 1;
+	}
+	return (seeable);
+}
+
+/**
+ * pvs_pair_visible - Checks if two clusters see each other.
+ * @pvs: The set being built.
+ * @map: The map.
+ * @seeable: The cells a line of sight can reach.
+ * @a: The index of the first cluster.
+ * @b: The index of the second cluster.
+ *
+ * Return: True if a cell of @a and a cell of @b, one of them open, see
+ * each other, false otherwise.
+ */
+static bool pvs_pair_visible(const pvs_t *pvs, const map_t *map,
+		const unsigned char *seeable, int a, int b)
+{
+	int side = 1 << pvs->shift, i, j, r0, c0, r1, c1, from, to;
+	int ar = a / pvs->cluster_cols << pvs->shift;
+	int ac = a % pvs->cluster_cols << pvs->shift;
+	int br = b / pvs->cluster_cols << pvs->shift;
+	int bc = b % pvs->cluster_cols << pvs->shift;
+
+	for (i = 0; i < side * side; i++)
+	{
+		r0 = ar + (i >> pvs->shift);
+		c0 = ac + (i & (side - 1));
+		from = r0 < map->rows && c0 < map->cols ?
+			seeable[(long)r0 * map->cols + c0] : 0;
+		for (j = 0; from && j < side * side; j++)
+		{
+			r1 = br + (j >> pvs->shift);
+			c1 = bc + (j & (side - 1));
+			to = r1 < map->rows && c1 < map->cols ?
+				seeable[(long)r1 * map->cols + c1] : 0;
+			if (to && (from == 2 || to == 2) &&
+					map_line_of_sight(map, r0, c0, r1, c1))
+				return (true);
+		}
+	}
+	return (false);
+}
+
+/**
+ * pvs_build_row - Finds the clusters visible from one cluster.
+ * @pvs: The set being built.
+ * @map: The map.
+ * @seeable: The cells a line of sight can reach.
+ * @a: The index of the cluster.
+ *
+ * Description: Visibility is symmetric, so only the clusters after @a
+ * are tested, and each visible pair sets the bits of both clusters.
+ */
+static void pvs_build_row(pvs_t *pvs, const map_t *map,
+		const unsigned char *seeable, int a)
+{
+	int ar = a / pvs->cluster_cols, ac = a % pvs->cluster_cols;
+	int radius = pvs->radius, window = pvs->window, dr, dc, b, bit;
+	size_t stride = pvs->row_bytes;
+
+	for (dr = 0; dr <= radius; dr++)
+		for (dc = dr ? -radius : 0; dc <= radius; dc++)
+		{
+			if (ar + dr >= pvs->cluster_rows || ac + dc < 0 ||
+					ac + dc >= pvs->cluster_cols)
+				continue;
+			b = a + dr * pvs->cluster_cols + dc;
+			if (!pvs_pair_visible(pvs, map, seeable, a, b))
+				continue;
+			bit = (dr + radius) * window + dc + radius;
+			pvs->bits[a * stride + bit / 8] |= 1 << (bit & 7);
+			bit = window * window - 1 - bit;
+			pvs->bits[b * stride + bit / 8] |= 1 << (bit & 7);
+		}
+}
+
+/**
+ * pvs_build - Computes which clusters of a map see each other.
+ * @pvs: The pvs_t struct to initialize.
+ * @map: The map.
+ * @shift: Clusters are squares of 1 << @shift cells on a side.
+ * @radius: How far visibility is kept, in clusters.
+ *
+ * Description: Pairs of clusters are tested cell against cell and stop
+ * at the first line of sight, so open areas are quick; closed ones cost
+ * up to (1 << @shift) ^ 4 traces per pair. Small maps afford @shift 0;
+ * large ones are better built once with pvs_open(), which keeps the
+ * result in a file next to the map.
+ *
+ * Return: True on success, false on invalid parameters or if memory
+ * allocation failed.
+ */
+bool pvs_build(pvs_t *pvs, const map_t *map, int shift, int radius)
+{
+	unsigned char *seeable;
+	int a;
+
+	memset(pvs, 0, sizeof(*pvs));
+	if (!pvs_layout(pvs, map, shift, radius))
+		return (false);
+	pvs->map_hash = pvs_map_hash(map);
+	pvs->bits = calloc((size_t)pvs->cluster_rows * pvs->cluster_cols,
+			pvs->row_bytes);
+	seeable = pvs->bits ? pvs_seeable(map) : NULL;
+	if (!seeable)
+	{
+		pvs_free(pvs);
+		return (false);
+	}
+	for (a = 0; a < pvs->cluster_rows * pvs->cluster_cols; a++)
+		pvs_build_row(pvs, map, seeable, a);
+	free(seeable);
+	return (true);
+}
@@ -0,0 +1,132 @@
+#include "../../headers/maze.h"
+#include <unistd.h>
+
+/**
+ * pvs_map_hash - Hashes the size and cells of a map.
+ * @map: The map.
+ *
+ * Description: This is 64-bit FNV-1a. Walls only count as walls, so
+ * changing a texture keeps a visibility file valid.
+ *
+ * Return: The hash.
+ */
+uint64_t pvs_map_hash(const map_t *map)
+{
+	uint64_t hash = UINT64_C(0xCBF29CE484222325);
+	long i, size = (long)map->rows * map->cols;
+
+	hash = (hash ^ (uint32_t)map->rows) * UINT64_C(0x100000001B3);
+	hash = (hash ^ (uint32_t)map->cols) * UINT64_C(0x100000001B3);
+	for (i = 0; i < size; i++)
+		hash = (hash ^ (map->cells[i] != 0)) * UINT64_C(0x100000001B3);
+	return (hash);
+}
+
+/**
+ * pvs_save - Writes a visibility set to a file.
+ * @pvs: The visibility set.
+ * @path: The path of the file.
+ *
+ * Description: The file is written next to @path and renamed over it, so
+ * a reader never sees half a file.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool pvs_save(const pvs_t *pvs, const char *path)
+{
+	size_t count = (size_t)pvs->cluster_rows * pvs->cluster_cols;
+	pvs_header_t header;
+	char tmp_path[4096];
+	FILE *file;
+	bool ok;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, PVS_MAGIC, sizeof(PVS_MAGIC));
+	header.version = PVS_VERSION;
+	header.shift = pvs->shift;
+	header.radius = pvs->radius;
+	header.rows = pvs->rows;
+	header.cols = pvs->cols;
+	header.map_hash = pvs->map_hash;
+	sprintf(tmp_path, "%.4000s.%d.tmp", path, (int)getpid());
+	file = fopen(tmp_path, "wb");
+	if (!file)
+		return (false);
+	ok = fwrite(&header, sizeof(header), 1, file) == 1 &&
+		fwrite(pvs->bits, pvs->row_bytes, count, file) == count;
+	ok = fclose(file) == 0 && ok;
+	if (ok && rename(tmp_path, path) == 0)
+		return (true);
+	remove(tmp_path);
+	return (false);
+}
+
+/**
+ * pvs_load - Reads a visibility set written by pvs_save().
+ * @pvs: The pvs_t struct to initialize.
+ * @path: The path of the file.
+ * @map: The map the set must have been built from.
+ *
+ * Return: True on success, false if the file is missing, of another
+ * version, truncated, or was built from a different map.
+ */
+bool pvs_load(pvs_t *pvs, const char *path, const map_t *map)
+{
+	pvs_header_t header;
+	FILE *file = fopen(path, "rb");
+	size_t count = 0;
+	bool ok;
+
+	memset(pvs, 0, sizeof(*pvs));
+	if (!file)
+		return (false);
+	ok = fread(&header, sizeof(header), 1, file) == 1 &&
+		memcmp(header.magic, PVS_MAGIC, sizeof(PVS_MAGIC)) == 0 &&
+		header.version == PVS_VERSION &&
+		header.rows == (uint32_t)map->rows &&
+		header.cols == (uint32_t)map->cols &&
+		header.map_hash == pvs_map_hash(map) &&
+		pvs_layout(pvs, map, header.shift, header.radius);
+	if (ok)
+	{
+		pvs->map_hash = header.map_hash;
+		count = (size_t)pvs->cluster_rows * pvs->cluster_cols;
+		pvs->bits = malloc(pvs->row_bytes * count);
+		ok = pvs->bits && fread(pvs->bits, pvs->row_bytes, count,
+				file) == count;
+	}
+	fclose(file);
+	if (!ok)
+		pvs_free(pvs);
+	return (ok);
+}
+
+/**
+ * pvs_open - Loads the visibility set of a map, building it if needed.
+ * @pvs: The pvs_t struct to initialize.
+ * @path: The path of the visibility file, usually the map file followed
+ * by ".pvs".
+ * @map: The map.
+ * @shift: Clusters are squares of 1 << @shift cells on a side.
+ * @radius: How far visibility is kept, in clusters.
+ *
+ * Description: A file built from another map or with other parameters is
+ * rebuilt and replaced. Failing to write the file is not an error; the
+ * set is simply built again next time.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool pvs_open(pvs_t *pvs, const char *path, const map_t *map, int shift,
+		int radius)
+{
+	if (pvs_load(pvs, path, map))
+	{
+		if (pvs->shift == shift && pvs->radius == radius)
+			return (true);
+		pvs_free(pvs);
+	}
+	if (!pvs_build(pvs, map, shift, radius))
+		return (false);
+	pvs_save(pvs, path);
+	return (true);
+}
@@ -0,0 +1,103 @@
+#include "../../headers/maze.h"
+
+/**
+ * pvs_visible - Checks if a cell can potentially see another.
+ * @pvs: The visibility set.
+ * @a: The index of the first cell, row * cols + col.
+ * @b: The index of the second cell.
+ *
+ * Description: This is one bit lookup, in place of walking the line of
+ * sight through the map. Cells in the same cluster share their answer,
+ * so with clusters larger than a cell it can be true for cells that do
+ * not see each other, but never false for cells that do. The set keeps
+ * no bits past its radius, so clusters farther away count as visible.
+ *
+ * Return: False if the cluster of @b is within the radius of the set and
+ * not visible from the cluster of @a, true otherwise.
+ */
+bool pvs_visible(const pvs_t *pvs, int a, int b)
+{
+	int dr = (b / pvs->cols >> pvs->shift) - (a / pvs->cols >> pvs->shift);
+	int dc = (b % pvs->cols >> pvs->shift) - (a % pvs->cols >> pvs->shift);
+	long cluster = (long)(a / pvs->cols >> pvs->shift) * pvs->cluster_cols +
+		(a % pvs->cols >> pvs->shift);
+	int bit;
+
+	if (dr < -pvs->radius || dr > pvs->radius || dc < -pvs->radius ||
+			dc > pvs->radius)
+		return (true);
+	bit = (dr + pvs->radius) * pvs->window + dc + pvs->radius;
+	return ((pvs->bits[cluster * pvs->row_bytes + bit / 8] >> (bit & 7)) &
+			1);
+}
+
+/**
+ * pvs_list - Lists the clusters a cell can potentially see.
+ * @pvs: The visibility set.
+ * @cell: The index of the cell, row * cols + col.
+ * @clusters: Receives the indices of the visible clusters, row * @pvs->
+ * cluster_cols + col; it must hold @pvs->window * @pvs->window entries.
+ *
+ * Description: Cluster i covers the cells of rows (i / cluster_cols) <<
+ * shift and columns (i % cluster_cols) << shift, 1 << shift of each.
+ * Whole bytes of invisible clusters are skipped at once.
+ *
+ * Return: The number of clusters written to @clusters.
+ */
+int pvs_list(const pvs_t *pvs, int cell, int *clusters)
+{
+	int ar = cell / pvs->cols >> pvs->shift;
+	int ac = cell % pvs->cols >> pvs->shift;
+	const unsigned char *row = pvs->bits + ((long)ar * pvs->cluster_cols +
+			ac) * pvs->row_bytes;
+	int bit, count = 0, r, c, size = pvs->window * pvs->window;
+
+	for (bit = 0; bit < size; bit++)
+	{
+		if (row[bit / 8] == 0)
+		{
+			bit |= 7;
+			continue;
+		}
+		if (!((row[bit / 8] >> (bit & 7)) & 1))
+			continue;
+		r = ar + bit / pvs->window - pvs->radius;
+		c = ac + bit % pvs->window - pvs->radius;
+		clusters[count++] = r * pvs->cluster_cols + c;
+	}
+	return (count);
+}
+
+/**
+ * pvs_layout - Sets the sizes of a visibility set.
+ * @pvs: The pvs_t struct, zeroed.
+ * @map: The map the set covers.
+ * @shift: Clusters are squares of 1 << @shift cells on a side.
+ * @radius: How far visibility is kept, in clusters.
+ *
+ * Return: True if the parameters are valid, false otherwise.
+ */
+bool pvs_layout(pvs_t *pvs, const map_t *map, int shift, int radius)
+{
+	if (shift < 0 || shift > 8 || radius < 0 || radius > 255)
+		return (false);
+	pvs->rows = map->rows;
+	pvs->cols = map->cols;
+	pvs->shift = shift;
+	pvs->radius = radius;
+	pvs->cluster_rows = (map->rows + (1 << shift) - 1) >> shift;
+	pvs->cluster_cols = (map->cols + (1 << shift) - 1) >> shift;
+	pvs->window = 2 * radius + 1;
+	pvs->row_bytes = (pvs->window * pvs->window + 7) / 8;
+	return (true);
+}
+
+/**
+ * pvs_free - Frees the bits of a visibility set.
+ * @pvs: The set.
+ */
+void pvs_free(pvs_t *pvs)
+{
+	free(pvs->bits);
+	pvs->bits = NULL;
+}
@@ -0,0 +1,91 @@
+#include "../../headers/maze.h"
+
+/**
+ * qoi_chunk - Decodes one QOI chunk.
+ * @data: The chunks.
+ * @size: The number of bytes of @data.
+ * @pos: The position of the chunk in @data, moved past it.
+ * @pixel: The previous pixel, replaced with the pixel of the chunk.
+ * @index: The 64 pixels seen last, by hash, updated with the new pixel.
+ *
+ * Description: QOI_OP_RGBA is never written by qoi_encode_rows(), as
+ * frames are opaque, and is rejected.
+ *
+ * Return: The number of pixels the chunk stands for, 0 if it is invalid.
+ */
+static int qoi_chunk(const unsigned char *data, size_t size, size_t *pos,
+		color_t *pixel, color_t *index)
+{
+	int op, r = *pixel & 0xFF, g = (*pixel >> 8) & 0xFF;
+	int b = (*pixel >> 16) & 0xFF, dg;
+
+	if (*pos >= size || (op = data[(*pos)++]) == 0xFF ||
+			(op == 0xFE && *pos + 3 > size) ||
+			(op >> 6 == 2 && *pos >= size))
+		return (0);
+	if (op == 0xFE)
+	{
+		r = data[*pos];
+		g = data[*pos + 1];
+		b = data[*pos + 2];
+		*pos += 3;
+	}
+	else if (op >> 6 == 3)
+		return ((op & 0x3F) + 1);
+	else if (op >> 6 == 0)
+	{
+		*pixel = index[op]; /* Already in the index, under @op */
+		return (index[op] ? 1 : 0);
+	}
+	else if (op >> 6 == 1)
+	{
+		r += (op >> 4 & 3) - 2;
+		g += (op >> 2 & 3) - 2;
+		b += (op & 3) - 2;
+	}
+	else
+	{
+		dg = (op & 0x3F) - 32;
+		r += dg + (data[*pos] >> 4) - 8;
+		g += dg;
+		b += dg + (data[(*pos)++] & 0xF) - 8;
+	}
+	*pixel = 0xFF000000 | (r & 0xFF) | (g & 0xFF) << 8 |
+		(color_t)(b & 0xFF) << 16;
+	index[((*pixel & 0xFF) * 3 + ((*pixel >> 8) & 0xFF) * 5 +
+			((*pixel >> 16) & 0xFF) * 7 + 255 * 11) % 64] = *pixel;
+	return (1);
+}
+
+/**
+ * qoi_decode_rows - Decodes the chunks written by qoi_encode_rows().
+ * @data: The chunks.
+ * @size: The number of bytes of @data.
+ * @pixels: The first row receiving the pixels, all opaque.
+ * @width: The number of pixels per row.
+ * @height: The number of rows.
+ * @pitch: The number of pixels between the starts of two rows.
+ *
+ * Return: The number of bytes decoded, or 0 if @data is not exactly
+ * @width * @height pixels or ends too soon.
+ */
+size_t qoi_decode_rows(const unsigned char *data, size_t size,
+		color_t *pixels, int width, int height, int pitch)
+{
+	size_t count = (size_t)width * height, i, pos = 0;
+	color_t index[64], pixel = 0xFF000000;
+	int run = 0, x;
+
+	memset(index, 0, sizeof(index));
+	for (i = 0, x = 0; i < count; i++, x++)
+	{
+		if (x == width)
+			x = 0, pixels += pitch;
+		if (run == 0 && (run = qoi_chunk(data, size, &pos, &pixel,
+						index)) == 0)
+			return (0);
+		run--;
+		pixels[x] = pixel;
+	}
+	return (run ? 0 : pos);
+}
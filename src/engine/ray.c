@@ -0,0 +1,215 @@
+#include "../../headers/maze.h"
+
+/**
+ * find_horizontal_intersection - Finds the intersection point of a
+ * horizontal ray with walls.
+ * @ray_angle: The angle of the ray to find the intersection for.
+ * @player: Pointer to the player_t struct.
+ * @map: An instance of the map_t struct representing map data.
+ * @inst: Pointer to the wall_hit_data_t struct receiving the hit.
+ *
+ * Description: This function calculates the intersection point of a
+ * horizontal ray with walls.
+ * It iteratively checks for intersections until the intersection point
+ * is outside the map bounds.
+ * If a wall is found, the related variables and flags are updated accordingly.
+ */
+void find_horizontal_intersection(float ray_angle,
+		const player_t *player, const map_t *map, wall_hit_data_t *inst)
+{
+	float x, y, x_step, y_step, x_cord, y_cord;
+	float next_horz_touch_x, next_horz_touch_y;
+
+	/* Reset flags and variables related to horizontal intersection*/
+	inst->found_horz_wall_hit = false;
+	inst->horz_wall_hit_x = 0;
+	inst->horz_wall_hit_y = 0;
+	inst->horz_wall_texture = 0;
+
+	y = floor(player->y / TILE_SIZE) * TILE_SIZE; /* Cal init intersection point*/
+	y += is_ray_facing_down(ray_angle) ? TILE_SIZE : 0;
+	x = player->x + (y - player->y) / tan(ray_angle);
+
+	y_step = TILE_SIZE * (is_ray_facing_up(ray_angle) ? -1 : 1);
+	x_step = TILE_SIZE / tan(ray_angle);
+	x_step *= (is_ray_facing_left(ray_angle) && x_step > 0) ? -1 : 1;
+	x_step *= (is_ray_facing_right(ray_angle) && x_step < 0) ? -1 : 1;
+	next_horz_touch_x = x;
+	next_horz_touch_y = y;
+
+	while (is_inside_map(next_horz_touch_x, next_horz_touch_y, map))
+	{
+		x_cord = next_horz_touch_x; /* Check until the point is outside map bounds */
+		y_cord = next_horz_touch_y + (is_ray_facing_up(ray_angle) ? -1 : 0);
+
+		if (map_has_wall_at(x_cord, y_cord, map))
+		{
+			inst->horz_wall_hit_x = next_horz_touch_x;
+			inst->horz_wall_hit_y = next_horz_touch_y;
+			inst->horz_wall_texture = get_map_at(
+					(int)floor(y_cord / TILE_SIZE),
+					(int)floor(x_cord / TILE_SIZE), map);
+			inst->found_horz_wall_hit = true;
+			break;
+		}
+		inst->cells++;
+		next_horz_touch_x += x_step; /* Update next intersection */
+		next_horz_touch_y += y_step;
+	}
+}
+
+/**
+ * find_vertical_intersection - Finds the intersection point of
+ * a vertical ray with walls.
+ * @ray_angle: The angle of the ray to find the intersection for.
+ * @player: Pointer to the player_t struct.
+ * @map: An instance of the map_t struct representing map data.
+ * @inst: Pointer to the wall_hit_data_t struct receiving the hit.
+ *
+ * Description: This function calculates the intersection point of
+ * a vertical ray with walls. It iteratively checks for intersections
+ * until the intersection point is outside the map bounds. If a wall is found,
+ * the related variables and flags are updated accordingly.
+ */
+void find_vertical_intersection(float ray_angle, const player_t *player,
+		const map_t *map, wall_hit_data_t *inst)
+{
+	float x, y, x_step, y_step;
+	float next_vert_touch_x, next_vert_touch_y, x_cord, y_cord;
+
+	/* Reset the flags and variables related to vertical intersection */
+	inst->found_vert_wall_hit = false;
+	inst->vert_wall_hit_x = 0;
+	inst->vert_wall_hit_y = 0;
+	inst->vert_wall_texture = 0;
+
+	x = floor(player->x / TILE_SIZE) * TILE_SIZE; /* Cal init intersection point*/
+	x += is_ray_facing_right(ray_angle) ? TILE_SIZE : 0;
+	y = player->y + (x - player->x) * tan(ray_angle);
+
+	x_step = TILE_SIZE * (is_ray_facing_left(ray_angle) ? -1 : 1);
+	y_step = TILE_SIZE * tan(ray_angle);
+	y_step *= (is_ray_facing_up(ray_angle) && y_step > 0) ? -1 : 1;
+	y_step *= (is_ray_facing_down(ray_angle) && y_step < 0) ? -1 : 1;
+
+	next_vert_touch_x = x; /* Set initial values */
+	next_vert_touch_y = y;
+
+	while (is_inside_map(next_vert_touch_x, next_vert_touch_y, map))
+	{
+		x_cord = next_vert_touch_x + (is_ray_facing_left(ray_angle) ? -1 : 0);
+		y_cord = next_vert_touch_y; /* Check until the point is outside map bounds */
+
+		if (map_has_wall_at(x_cord, y_cord, map))
+		{
+			inst->vert_wall_hit_x = next_vert_touch_x;
+			inst->vert_wall_hit_y = next_vert_touch_y;
+			inst->vert_wall_texture = get_map_at(
+					(int)floor(y_cord / TILE_SIZE),
+					(int)floor(x_cord / TILE_SIZE), map);
+			inst->found_vert_wall_hit = true;
+			break;
+		}
+		inst->cells++;
+		next_vert_touch_x += x_step; /* Set initial values */
+		next_vert_touch_y += y_step;
+	}
+}
+/**
+ * ray_set_hit - Records where the ray of a column hits a wall face.
+ * @view: Pointer to the view_t struct owning the rays.
+ * @column: The column of the ray.
+ * @ray_angle: The normalized angle of the ray.
+ * @line: The x-coordinate of the face if @vertical, its y-coordinate
+ * otherwise.
+ * @vertical: Whether the face lies on a vertical grid line.
+ * @texture: The texture of the wall.
+ *
+ * Description: The hit is computed from the grid line directly, so a
+ * ray gets the same hit whether its grid traversal found the face or a
+ * wall span confirmed it.
+ */
+void ray_set_hit(view_t *view, int column, float ray_angle, float line,
+		bool vertical, int texture)
+{
+	const player_t *player = view->player;
+	ray_buffer_t *rays = &view->rays;
+
+	rays->wall_hit_x[column] = vertical ? line :
+		player->x + (line - player->y) / tan(ray_angle);
+	rays->wall_hit_y[column] = vertical ?
+		player->y + (line - player->x) * tan(ray_angle) : line;
+	rays->distance[column] = distance_between_points(player->x,
+			player->y, rays->wall_hit_x[column],
+			rays->wall_hit_y[column]);
+	rays->texture[column] = texture;
+	rays->was_hit_vertical[column] = vertical;
+	rays->ray_angle[column] = ray_angle;
+}
+
+/**
+ * ray_choose_hit - Keeps the closer of the two hits a ray found.
+ * @view: Pointer to the view_t struct owning the rays.
+ * @column: The index of the column for the ray.
+ * @ray_angle: The normalized angle of the ray.
+ * @inst: The hits of the horizontal and vertical searches of the ray.
+ */
+void ray_choose_hit(view_t *view, int column, float ray_angle,
+		const wall_hit_data_t *inst)
+{
+	float horz_hit_distance, vert_hit_distance;
+	const player_t *player = view->player;
+	ray_buffer_t *rays = &view->rays;
+
+	horz_hit_distance = inst->found_horz_wall_hit ? distance_between_points
+		(player->x, player->y, inst->horz_wall_hit_x,
+		 inst->horz_wall_hit_y) : FLT_MAX;
+	vert_hit_distance = inst->found_vert_wall_hit ? distance_between_points
+		(player->x, player->y, inst->vert_wall_hit_x,
+		 inst->vert_wall_hit_y) : FLT_MAX;
+
+	if (vert_hit_distance < horz_hit_distance) /*Choose the smallest hit dist*/
+		ray_set_hit(view, column, ray_angle, inst->vert_wall_hit_x, true,
+				inst->vert_wall_texture);
+	else if (inst->found_horz_wall_hit)
+		ray_set_hit(view, column, ray_angle, inst->horz_wall_hit_y, false,
+				inst->horz_wall_texture);
+	else
+	{
+		rays->distance[column] = FLT_MAX; /* The ray left the map */
+		rays->wall_hit_x[column] = 0;
+		rays->wall_hit_y[column] = 0;
+		rays->texture[column] = 0;
+		rays->was_hit_vertical[column] = false;
+		rays->ray_angle[column] = ray_angle;
+	}
+}
+
+/**
+ * cast_ray - Casts a single ray and determines its intersection with walls.
+ * @ray_angle: The angle of the ray to cast.
+ * @column: The index of the column for the ray.
+ * @view: Pointer to the view_t struct owning the rays.
+ *
+ * Description: This function casts a ray with the specified angle and
+ * determines its intersection points with walls. It calculates the hit
+ * distances between the player's position and the intersection points, and
+ * updates the properties of the rays array for the given column.
+ * cast_ray_packet() casts several rays at once with the same results.
+ */
+void cast_ray(float ray_angle, int column, view_t *view)
+{
+	wall_hit_data_t inst;
+
+	/* Ensure the ray_angle falls within the range of 0 to 360 degrees */
+	normalize_angle(&ray_angle);
+
+	inst.cells = 0;
+	find_horizontal_intersection(ray_angle, view->player, view->world->map,
+			&inst);
+	find_vertical_intersection(ray_angle, view->player, view->world->map,
+			&inst);
+	view->stats.rays_cast++;
+	view->stats.cells_visited += inst.cells;
+	ray_choose_hit(view, column, ray_angle, &inst);
+}
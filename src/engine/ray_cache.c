@@ -0,0 +1,164 @@
+#include "../../headers/maze.h"
+
+/**
+ * ray_cache_init - Allocates the rays of an angular ray cache.
+ * @cache: Pointer to the ray_cache_t struct to initialize.
+ *
+ * Return: True on success, false if memory allocation failed, in which
+ * case the cache stays empty and is never used.
+ */
+bool ray_cache_init(ray_cache_t *cache)
+{
+	ray_buffer_t *probes = &cache->probes;
+	size_t count = RAY_CACHE_STEPS;
+
+	memset(cache, 0, sizeof(*cache));
+	probes->count = count;
+	probes->ray_angle = malloc(sizeof(float) * count);
+	probes->wall_hit_x = malloc(sizeof(float) * count);
+	probes->wall_hit_y = malloc(sizeof(float) * count);
+	probes->distance = malloc(sizeof(float) * count);
+	probes->texture = malloc(sizeof(int) * count);
+	probes->was_hit_vertical = malloc(count);
+	if (!probes->ray_angle || !probes->wall_hit_x || !probes->wall_hit_y ||
+			!probes->distance || !probes->texture ||
+			!probes->was_hit_vertical)
+	{
+		ray_cache_free(cache);
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * ray_cache_free - Releases the rays of an angular ray cache.
+ * @cache: Pointer to the ray_cache_t struct, which is zeroed.
+ */
+void ray_cache_free(ray_cache_t *cache)
+{
+	free(cache->probes.ray_angle);
+	free(cache->probes.wall_hit_x);
+	free(cache->probes.wall_hit_y);
+	free(cache->probes.distance);
+	free(cache->probes.texture);
+	free(cache->probes.was_hit_vertical);
+	memset(cache, 0, sizeof(*cache));
+}
+
+/**
+ * ray_cache_probe - Casts a ray of the grid unless it is cached.
+ * @view: The view, whose camera has not moved since the cache was reset.
+ * @index: The index of the ray in the grid.
+ */
+static void ray_cache_probe(view_t *view, int index)
+{
+	ray_cache_t *cache = &view->ray_cache;
+	ray_buffer_t rays = view->rays;
+
+	if (cache->probes.texture[index] >= 0)
+		return;
+	/* cast_ray() writes to the rays of the view, so the grid stands in */
+	view->rays = cache->probes;
+	cast_ray(index * (2 * PI / RAY_CACHE_STEPS), index, view);
+	view->rays = rays;
+	cache->cast++;
+}
+
+/**
+ * ray_cache_fill - Finds the rays of columns between two rays of the grid.
+ * @view: The view, whose raw column angles are in its ray_angle array.
+ * @first: The first column.
+ * @last: The last column, looking between the same rays of the grid.
+ * @index: The index of the ray of the grid just before the columns.
+ *
+ * Description: When both rays of the grid hit the same wall face, so do
+ * the columns between them, for the reasons wall spans rely on, and
+ * their rays are intersected with the face. Otherwise both ends are cast
+ * and the columns in between are left to cast_wall_span().
+ */
+static void ray_cache_fill(view_t *view, int first, int last, int index)
+{
+	const ray_buffer_t *probes = &view->ray_cache.probes;
+	int column, next = (index + 1) % RAY_CACHE_STEPS;
+	float angle;
+	bool vertical;
+
+	ray_cache_probe(view, index);
+	ray_cache_probe(view, next);
+	if (!wall_span_same_face(probes, index, next))
+	{
+		cast_ray(view->rays.ray_angle[first], first, view);
+		if (last == first)
+			return;
+		cast_ray(view->rays.ray_angle[last], last, view);
+		cast_wall_span(view, first, last);
+		return;
+	}
+	vertical = probes->was_hit_vertical[index];
+	for (column = first; column <= last; column++)
+	{
+		angle = view->rays.ray_angle[column];
+		normalize_angle(&angle);
+		ray_set_hit(view, column, angle, vertical ?
+				probes->wall_hit_x[index] :
+				probes->wall_hit_y[index], vertical,
+				probes->texture[index]);
+	}
+	view->span_columns += last - first + 1;
+}
+
+/**
+ * ray_cache_cast - Casts the rays of a frame from the angular ray cache.
+ * @view: The view, whose frame has begun.
+ *
+ * Description: Turning in place sweeps the same rays as the last frames,
+ * only rotated, so the rays of a fixed grid of angles are kept while the
+ * camera stays put and the map is unchanged. Columns are grouped by the
+ * two rays of the grid they look between; only newly exposed rays of the
+ * grid and the columns near the edges of walls are cast. Any move or
+ * change to the map empties the cache, and that frame is cast as usual.
+ *
+ * Return: True if the frame was cast, false otherwise.
+ */
+bool ray_cache_cast(view_t *view)
+{
+	ray_cache_t *cache = &view->ray_cache;
+	const player_t *player = view->player;
+	const map_t *map = view->world->map;
+	int column, first = 0, group = -1, index, width = view->frame.width;
+	float angle, *raw = view->rays.ray_angle, plane = view->dist_proj_plane;
+
+	cache->cast = 0;
+	if (!cache->probes.texture)
+		return (false);
+	if (!cache->valid || cache->x != player->x || cache->y != player->y ||
+			cache->map != map || cache->map_version != map->version)
+	{
+		memset(cache->probes.texture, 0xFF,
+				sizeof(int) * RAY_CACHE_STEPS);
+		cache->x = player->x;
+		cache->y = player->y;
+		cache->map = map;
+		cache->map_version = map->version;
+		cache->valid = true;
+		return (false);
+	}
+	for (column = 0; column <= width; column++, group = index)
+	{
+		index = -1;
+		if (column < width)
+		{
+			angle = raw[column] = player->rotation_angle +
+				atan((column - width / 2) / plane);
+			normalize_angle(&angle);
+			index = (int)(angle * RAY_CACHE_STEPS / (2 * PI)) %
+				RAY_CACHE_STEPS;
+		}
+		if (column > first && index != group)
+		{
+			ray_cache_fill(view, first, column - 1, group);
+			first = column;
+		}
+	}
+	return (true);
+}
@@ -0,0 +1,217 @@
+#include "../../headers/maze.h"
+
+/**
+ * ray_packet_lane - Sets up both searches of one ray of a packet.
+ * @horz: The packet of horizontal searches.
+ * @vert: The packet of vertical searches.
+ * @lane: The lane of the ray.
+ * @ray_angle: The normalized angle of the ray.
+ * @player: Pointer to the player_t struct the ray starts from.
+ *
+ * Description: The starts and steps are computed exactly as
+ * find_horizontal_intersection() and find_vertical_intersection() do,
+ * with the same types, so the packet finds the same hits.
+ */
+static void ray_packet_lane(ray_walk_t *horz, ray_walk_t *vert, int lane,
+		float ray_angle, const player_t *player)
+{
+	float x, y, x_step, y_step;
+
+	y = floor(player->y / TILE_SIZE) * TILE_SIZE;
+	y += is_ray_facing_down(ray_angle) ? TILE_SIZE : 0;
+	x = player->x + (y - player->y) / tan(ray_angle);
+	y_step = TILE_SIZE * (is_ray_facing_up(ray_angle) ? -1 : 1);
+	x_step = TILE_SIZE / tan(ray_angle);
+	x_step *= (is_ray_facing_left(ray_angle) && x_step > 0) ? -1 : 1;
+	x_step *= (is_ray_facing_right(ray_angle) && x_step < 0) ? -1 : 1;
+	horz->x[lane] = x, horz->y[lane] = y;
+	horz->step_x[lane] = x_step, horz->step_y[lane] = y_step;
+	horz->offset_x[lane] = 0;
+	horz->offset_y[lane] = is_ray_facing_up(ray_angle) ? -1 : 0;
+
+	x = floor(player->x / TILE_SIZE) * TILE_SIZE;
+	x += is_ray_facing_right(ray_angle) ? TILE_SIZE : 0;
+	y = player->y + (x - player->x) * tan(ray_angle);
+	x_step = TILE_SIZE * (is_ray_facing_left(ray_angle) ? -1 : 1);
+	y_step = TILE_SIZE * tan(ray_angle);
+	y_step *= (is_ray_facing_up(ray_angle) && y_step > 0) ? -1 : 1;
+	y_step *= (is_ray_facing_down(ray_angle) && y_step < 0) ? -1 : 1;
+	vert->x[lane] = x, vert->y[lane] = y;
+	vert->step_x[lane] = x_step, vert->step_y[lane] = y_step;
+	vert->offset_x[lane] = is_ray_facing_left(ray_angle) ? -1 : 0;
+	vert->offset_y[lane] = 0;
+	horz->active[lane] = vert->active[lane] = -1;
+}
+
+/**
+ * ray_packet_retire - Records the wall a lane of a packet found.
+ * @walk: The packet.
+ * @lane: The lane, whose crossing hit a wall.
+ * @map: The map.
+ * @hit: The hit of the ray, whose horizontal or vertical fields are set.
+ */
+static void ray_packet_retire(const ray_walk_t *walk, int lane,
+		const map_t *map, wall_hit_data_t *hit)
+{
+	float x = walk->x[lane] + walk->offset_x[lane];
+	float y = walk->y[lane] + walk->offset_y[lane];
+	int texture = get_map_at((int)floor(y / TILE_SIZE),
+			(int)floor(x / TILE_SIZE), map);
+
+	if (!walk->vertical)
+	{
+		hit->horz_wall_hit_x = walk->x[lane];
+		hit->horz_wall_hit_y = walk->y[lane];
+		hit->horz_wall_texture = texture;
+		hit->found_horz_wall_hit = true;
+		return;
+	}
+	hit->vert_wall_hit_x = walk->x[lane];
+	hit->vert_wall_hit_y = walk->y[lane];
+	hit->vert_wall_texture = texture;
+	hit->found_vert_wall_hit = true;
+}
+
+/**
+ * ray_packet_walk - Steps a packet of rays until each finds a wall.
+ * @walk: The packet, whose inactive lanes are ignored.
+ * @map: The map.
+ * @inst: The RAY_PACKET hits receiving the results, one per lane.
+ *
+ * Description: Every lane steps at once under a mask: one comparison
+ * finds the lanes that left the map or reach its edge, one conversion
+ * gives the cells every lane checks, and only fetching the cells, which
+ * are bytes, is done lane by lane. A lane retires on its own when it
+ * finds a wall. The function is also built for AVX-512 and AVX2, and the
+ * best version the processor supports is picked when the program loads.
+ */
+__attribute__((target_clones("avx512f", "avx2", "default")))
+static void ray_packet_walk(ray_walk_t *walk, const map_t *map,
+		wall_hit_data_t *inst)
+{
+	ray_lanes_t x, y, width = {0}, height = {0}, scale = {0};
+	ray_mask_t open, hit, index;
+	int lane;
+
+	width += (float)(map->cols * TILE_SIZE);
+	height += (float)(map->rows * TILE_SIZE);
+	scale += 1.0f / TILE_SIZE;
+	for (;;)
+	{
+		walk->active &= (walk->x > 0) & (walk->x <= width) &
+			(walk->y >= 0) & (walk->y <= height);
+		x = walk->x + walk->offset_x;
+		y = walk->y + walk->offset_y;
+		open = walk->active & (x >= 0) & (x < width) & (y >= 0) &
+			(y < height);
+		/* Truncating is flooring, as the open lanes are not negative */
+		x = (ray_lanes_t)((ray_mask_t)(x * scale) & open);
+		y = (ray_lanes_t)((ray_mask_t)(y * scale) & open);
+		index = __builtin_convertvector(y, ray_mask_t) * map->cols +
+			__builtin_convertvector(x, ray_mask_t);
+		for (lane = 0; lane < RAY_PACKET; lane++)
+			hit[lane] = !open[lane] ? walk->active[lane] :
+				-(map->cells[index[lane]] != 0);
+		for (lane = 0; lane < RAY_PACKET; lane++)
+			if (hit[lane])
+				ray_packet_retire(walk, lane, map, &inst[lane]);
+			else
+				inst[lane].cells -= walk->active[lane];
+		walk->active &= ~hit;
+		for (lane = 0; lane < RAY_PACKET && !walk->active[lane]; lane++)
+			;
+		if (lane == RAY_PACKET)
+			return;
+		walk->x += walk->step_x;
+		walk->y += walk->step_y;
+	}
+}
+
+/**
+ * cast_ray_packet - Casts the rays of several columns together.
+ * @view: Pointer to the view_t struct owning the rays.
+ * @columns: The columns, whose ray_angle holds the angle to cast at, as
+ * cast_ray() takes it.
+ * @count: The number of @columns, at most RAY_PACKET.
+ *
+ * Description: The rays step through the grid side by side, which pays
+ * off as neighbouring rays mostly take as many steps. The hits are the
+ * ones cast_ray() finds, bit for bit, and are counted the same way.
+ */
+void cast_ray_packet(view_t *view, const int *columns, int count)
+{
+	wall_hit_data_t inst[RAY_PACKET];
+	ray_walk_t horz, vert;
+	float angles[RAY_PACKET];
+	int lane;
+
+	memset(inst, 0, sizeof(inst));
+	memset(&horz, 0, sizeof(horz));
+	memset(&vert, 0, sizeof(vert));
+	for (lane = 0; lane < count; lane++)
+	{
+		angles[lane] = view->rays.ray_angle[columns[lane]];
+		normalize_angle(&angles[lane]);
+		ray_packet_lane(&horz, &vert, lane, angles[lane], view->player);
+	}
+	vert.vertical = true;
+	ray_packet_walk(&horz, view->world->map, inst);
+	ray_packet_walk(&vert, view->world->map, inst);
+	for (lane = 0; lane < count; lane++)
+	{
+		view->stats.rays_cast++;
+		view->stats.cells_visited += inst[lane].cells;
+		ray_choose_hit(view, columns[lane], angles[lane], &inst[lane]);
+	}
+}
+
+/**
+ * cast_all_rays - Casts rays for each column of the screen to
+ * generate the 3D projection.
+ * @view: Pointer to the view_t struct to cast the rays of.
+ *
+ * Description: This starts a new frame of the view, so the per-frame
+ * data and the counters of the previous frame are released. One column
+ * in WALL_SPAN_MAX is cast, RAY_PACKET columns at a time, and the
+ * columns in between are left to cast_wall_span(). An interleaved view
+ * only casts the columns it cannot reproject from its last frame, and a
+ * view that only turned reuses the rays of its ray cache. The textures
+ * of the frame are noted in textures_hit.
+ */
+void cast_all_rays(view_t *view)
+{
+	int column, next, id, last = -1, num_rays = view->frame.width;
+	int columns[RAY_PACKET], count = 0, i;
+
+	view->span_columns = 0;
+	memset(&view->stats, 0, sizeof(view->stats));
+	memset(view->textures_hit, 0, sizeof(view->textures_hit));
+	view->frame.pixel_calls = 0;
+	if (!view_begin_frame(view))
+		return;
+	next = interleave_cast(view) || ray_cache_cast(view) ? num_rays : 0;
+	for (column = next; column < num_rays; column = next)
+	{
+		/* Calculate the ray_angle for the current column */
+		view->rays.ray_angle[column] = view->player->rotation_angle +
+			atan((column - num_rays / 2) / view->dist_proj_plane);
+		columns[count++] = column;
+		next = column + WALL_SPAN_MAX; /* Always cast the last column */
+		if (column < num_rays - 1 && next > num_rays - 1)
+			next = num_rays - 1;
+		if (count < RAY_PACKET && next < num_rays)
+			continue;
+		cast_ray_packet(view, columns, count);
+		for (i = 0; i < count; last = columns[i++])
+			if (last >= 0)
+				cast_wall_span(view, last, columns[i]);
+		count = 0;
+	}
+	for (column = 0; column < num_rays; column++)
+		if ((id = view->rays.texture[column] - 1) >= 0)
+			view->textures_hit[id / 32] |= 1u << id % 32;
+	view->textures_hit[FLOOR_TEXTURE_INDEX / 32] |=
+		1u << FLOOR_TEXTURE_INDEX % 32;
+	view->textures_hit[CEILING_TEXTURE_INDEX / 32] |=
+		1u << CEILING_TEXTURE_INDEX % 32;
+}
@@ -1,4 +1,4 @@
-#include "../headers/headers.h"
+#include "../../headers/maze.h"
 
 /**
  * is_ray_facing_down - Checks if the ray is facing downward.
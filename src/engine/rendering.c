@@ -0,0 +1,160 @@
+#include "../../headers/maze.h"
+
+/**
+ * darken_color_intensity - Darkens the intensity of the specified
+ * color by the given factor.
+ *
+ * @color: Pointer to the color value to be modified.
+ * @factor: The factor by which to darken the intensity of the color.
+ */
+void darken_color_intensity(color_t *color, float factor)
+{
+	color_t a, r, g, b;
+
+	/* Extract the alpha component of the color */
+	a = (*color & 0xFF000000);
+
+	/* Extract the red component of the color and darken it */
+	r = (*color & 0x00FF0000) * factor;
+
+	/* Extract the green component of the color and darken it */
+	g = (*color & 0x0000FF00) * factor;
+
+	/* Extract the blue component of the color and darken it */
+	b = (*color & 0x000000FF) * factor;
+
+	/* Combine the modified color components back into the color value */
+	*color = a | (r & 0x00FF0000) | (g & 0x0000FF00) | (b & 0x000000FF);
+}
+/**
+ * render_floor - Renders the floor on the screen beneath the current wall.
+ *
+ * @wall_bottom: The bottom position of the current wall on the screen.
+ * @column: The current column being rendered.
+ * @view: Pointer to the view_t struct being rendered.
+ */
+void render_floor(int wall_bottom, int column, view_t *view)
+{
+	render_plane(wall_bottom - 1, view->frame.height, 1,
+			&view->world->textures[FLOOR_TEXTURE_INDEX], column, view);
+}
+
+/**
+ * render_ceil - Renders the ceiling on the screen above the current wall.
+ *
+ * @wall_top: The top position of the current wall on the screen.
+ * @column: The current column being rendered.
+ * @view: Pointer to the view_t struct being rendered.
+ */
+void render_ceil(int wall_top, int column, view_t *view)
+{
+	render_plane(0, wall_top, -1,
+			&view->world->textures[CEILING_TEXTURE_INDEX], column, view);
+}
+
+/**
+ * render_wall_column - Renders the textured wall span of one column.
+ * @col: The column, whose ray has already been cast.
+ * @wall_top: The first row of the span.
+ * @wall_bottom: The row after the last row of the span.
+ * @wall_height: The projected height of the wall, which may exceed the
+ * height of the frame.
+ * @span: The setup of the wall, from wall_span_init().
+ * @view: Pointer to the view_t struct being rendered.
+ *
+ * Description: Without a lightmap, walls hit on a vertical grid line are
+ * darkened, which makes the corners of the maze easier to see. With one,
+ * the column gets a single light level and every texel is shaded through
+ * its multiply table.
+ */
+void render_wall_column(int col, int wall_top, int wall_bottom,
+		int wall_height, const wall_span_t *span, view_t *view)
+{
+	int texture_offset_x, texture_offset_y, distance_from_top, x,
+	    half_height = view->frame.height / 2;
+	color_t pixel_color;
+	const ray_buffer_t *rays = &view->rays;
+	const texture_t *texture = span->texture;
+	const lightmap_t *lightmap = view->world->lightmap;
+	const unsigned char *shade = lightmap ?
+		lightmap->shade[lightmap_wall_level(lightmap, rays, col)] :
+		span->shade;
+
+	if (wall_bottom > wall_top)
+	{
+		view->stats.wall_pixels += wall_bottom - wall_top;
+		view->stats.texel_fetches += wall_bottom - wall_top;
+	}
+	texture_offset_x = ((int)(span->vertical ? /* On x */
+			rays->wall_hit_y[col] : rays->wall_hit_x[col]) % TILE_SIZE) &
+		(texture->width - 1);
+	for (x = wall_top; x < wall_bottom; x++) /* Render top to bottom */
+	{
+		distance_from_top = x + (wall_height / 2) - half_height;
+		texture_offset_y = distance_from_top * ((float)texture->height /
+				wall_height);
+		pixel_color = texture->texture_buffer[(
+				texture_offset_y << texture->width_shift) | texture_offset_x];
+		if (shade)
+			pixel_color = (pixel_color & 0xFF000000) |
+				shade[pixel_color >> 16 & 0xFF] << 16 |
+				shade[pixel_color >> 8 & 0xFF] << 8 |
+				shade[pixel_color & 0xFF];
+		draw_pixel(col, x, pixel_color, &view->frame);
+	}
+}
+
+/**
+ * render_textured_walls - Renders textured walls on the screen based on
+ * raycasting calculations.
+ *
+ * @view: Pointer to the view_t struct being rendered.
+ * @parts: The parts of the scene to draw, RENDER_FLOOR, RENDER_CEILING
+ * and RENDER_WALLS or'ed together.
+ * This function calculates the wall height of every column, then draws
+ * its floor, ceiling and wall span. Adjacent columns showing the same
+ * wall share its setup. Columns an interleaved view reprojected are
+ * copied from its last frame instead, along with the walls. Drawing the
+ * parts in separate calls, in that order, gives the same frame.
+ */
+void render_textured_walls(view_t *view, int parts)
+{
+	float perpendicular_distance;
+	int wall_top, wall_bottom, wall_height, col,
+	    half_height = view->frame.height / 2;
+	const ray_buffer_t *rays = &view->rays;
+	wall_span_t span = {0, false, NULL, NULL};
+
+	for (col = 0; col < view->frame.width; col++)
+	{
+		if (view->history.active && view->history.source[col] >= 0)
+		{
+			if (parts & RENDER_WALLS)
+				interleave_render_column(view, col);
+			continue;
+		}
+		/* Perpendicular distance to avoid the fish-eye distortion */
+		perpendicular_distance = rays->distance[col] * cos(
+				rays->ray_angle[col] - view->player->rotation_angle);
+		if (perpendicular_distance <= 0)
+			continue;
+		wall_height = (int)((TILE_SIZE / perpendicular_distance) *
+				view->dist_proj_plane); /* Projected wall height */
+		wall_top = half_height - (wall_height / 2);
+		wall_top = wall_top < 0 ? 0 : wall_top;
+		wall_bottom = half_height + (wall_height / 2);
+		wall_bottom = wall_bottom > view->frame.height ?
+			view->frame.height : wall_bottom;
+		if (parts & RENDER_FLOOR)
+			render_floor(wall_bottom, col, view);
+		if (parts & RENDER_CEILING)
+			render_ceil(wall_top, col, view);
+		if (!(parts & RENDER_WALLS))
+			continue;
+		if (!span.texture || span.id != rays->texture[col] ||
+				span.vertical != rays->was_hit_vertical[col])
+			wall_span_init(&span, view, col);
+		render_wall_column(col, wall_top, wall_bottom, wall_height,
+				&span, view);
+	}
+}
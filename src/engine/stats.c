@@ -0,0 +1,110 @@
+#include "../../headers/maze.h"
+
+/**
+ * frame_stats_add - Adds the counters of a frame to a sum.
+ * @total: The sum.
+ * @stats: The counters to add, of a view or of a whole frame.
+ */
+void frame_stats_add(frame_stats_t *total, const frame_stats_t *stats)
+{
+	uint64_t *sum = (uint64_t *)total;
+	const uint64_t *count = (const uint64_t *)stats;
+	size_t i;
+
+	for (i = 0; i < sizeof(*stats) / sizeof(uint64_t); i++)
+		sum[i] += count[i];
+}
+
+/**
+ * hud_glyph - Looks up the 3x5 bitmap of a character.
+ * @c: A digit or an uppercase letter; anything else is blank.
+ *
+ * Return: The five rows of the glyph, one octal digit each from the top,
+ * with the left column in the high bit.
+ */
+static unsigned int hud_glyph(char c)
+{
+	static const unsigned short glyphs[36] = {
+		075557, 026227, 071747, 071717, 055711, 074717, 074757, 071111,
+		075757, 075717, 025755, 065656, 034443, 065556, 074647, 074644,
+		034553, 055755, 072227, 011152, 055655, 044447, 057755, 065555,
+		025552, 065644, 025563, 065655, 034216, 072222, 055557, 055552,
+		055775, 055255, 055222, 071247
+	};
+
+	if (c >= '0' && c <= '9')
+		return (glyphs[c - '0']);
+	if (c >= 'A' && c <= 'Z')
+		return (glyphs[10 + c - 'A']);
+	return (0);
+}
+
+/**
+ * hud_text - Draws a line of text.
+ * @frame: The framebuffer.
+ * @x: The left edge of the text.
+ * @y: The top edge of the text.
+ * @text: The text.
+ */
+static void hud_text(framebuffer_t *frame, int x, int y, const char *text)
+{
+	unsigned int glyph;
+	int bit;
+
+	for (; *text; text++, x += 4 * STATS_HUD_SCALE)
+	{
+		glyph = hud_glyph(*text);
+		for (bit = 0; bit < 15; bit++)
+		{
+			if (!(glyph >> (14 - bit) & 1))
+				continue;
+			draw_rect(x + bit % 3 * STATS_HUD_SCALE,
+					y + bit / 3 * STATS_HUD_SCALE,
+					STATS_HUD_SCALE, STATS_HUD_SCALE,
+					0xFFFFFFFF, frame);
+		}
+	}
+}
+
+/**
+ * stats_hud_draw - Draws the counters in the top-right corner of a frame.
+ * @frame: The framebuffer.
+ * @last: The counters of the last frame.
+ * @total: The counters summed since the start, for the late and dropped
+ * frames.
+ *
+ * Description: Operators read it to see where a slow installation
+ * spends its time: a high ratio of cells to rays means long corridors,
+ * pixels far above the frame size mean overdraw, and late frames with
+ * low counts point at the upload or the machine itself.
+ */
+void stats_hud_draw(framebuffer_t *frame, const frame_stats_t *last,
+		const frame_stats_t *total)
+{
+	static const char * const labels[] = {
+		"RAYS", "CELLS", "WALL", "FLOOR", "CEILING", "TEXELS", "PIXELS",
+		"UPLOAD KB", "LATE", "DROPPED"
+	};
+	uint64_t values[10];
+	int i, line = 6 * STATS_HUD_SCALE + 2;
+	int width = 20 * 4 * STATS_HUD_SCALE + 8, left = frame->width - width;
+	char text[32];
+
+	values[0] = last->rays_cast;
+	values[1] = last->cells_visited;
+	values[2] = last->wall_pixels;
+	values[3] = last->floor_pixels;
+	values[4] = last->ceiling_pixels;
+	values[5] = last->texel_fetches;
+	values[6] = last->pixel_calls;
+	values[7] = last->uploaded_bytes / 1024;
+	values[8] = total->late_frames;
+	values[9] = total->dropped_frames;
+	draw_rect(left, 0, width, 10 * line + 6, 0xFF000000, frame);
+	for (i = 0; i < 10; i++)
+	{
+		sprintf(text, "%-9s %10lu", labels[i],
+				(unsigned long)values[i]);
+		hud_text(frame, left + 4, 4 + i * line, text);
+	}
+}
@@ -0,0 +1,129 @@
+#include "../../headers/maze.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * stats_export_open - Creates a shared-memory segment to publish to.
+ * @export: Pointer to the stats_export_t struct to initialize.
+ * @name: The POSIX shared-memory name, starting with a slash; it shows
+ * up under /dev/shm on Linux.
+ *
+ * Description: A segment left by a process that died is reused.
+ *
+ * Return: True on success, false if the segment cannot be created.
+ */
+bool stats_export_open(stats_export_t *export, const char *name)
+{
+	int fd;
+	void *mapping;
+
+	export->shared = NULL;
+	if (strlen(name) >= sizeof(export->name))
+		return (false);
+	strcpy(export->name, name);
+	fd = shm_open(name, O_RDWR | O_CREAT, 0644);
+	if (fd < 0)
+		return (false);
+	if (ftruncate(fd, sizeof(stats_shared_t)) != 0)
+	{
+		close(fd);
+		shm_unlink(name);
+		return (false);
+	}
+	mapping = mmap(NULL, sizeof(stats_shared_t), PROT_READ | PROT_WRITE,
+			MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+	{
+		shm_unlink(name);
+		return (false);
+	}
+	export->shared = mapping;
+	memset(export->shared, 0, sizeof(stats_shared_t));
+	export->shared->version = STATS_VERSION;
+	export->shared->pid = getpid();
+	__sync_synchronize();
+	export->shared->magic = STATS_MAGIC;
+	return (true);
+}
+
+/**
+ * stats_export_publish - Publishes the counters of a frame.
+ * @export: The segment, which may have failed to open.
+ * @stats: The counters of the frame.
+ *
+ * Description: The sequence number is odd while the counters are
+ * written, so readers never see a half-written frame and the publisher
+ * never waits for them.
+ */
+void stats_export_publish(stats_export_t *export, const frame_stats_t *stats)
+{
+	stats_shared_t *shared = export->shared;
+
+	if (!shared)
+		return;
+	shared->sequence++;
+	__sync_synchronize();
+	shared->frames++;
+	shared->last = *stats;
+	frame_stats_add(&shared->total, stats);
+	__sync_synchronize();
+	shared->sequence++;
+}
+
+/**
+ * stats_export_close - Unmaps and removes a segment.
+ * @export: The segment, which may have failed to open.
+ */
+void stats_export_close(stats_export_t *export)
+{
+	if (!export->shared)
+		return;
+	munmap(export->shared, sizeof(stats_shared_t));
+	shm_unlink(export->name);
+	export->shared = NULL;
+}
+
+/**
+ * stats_export_read - Copies the counters another process publishes.
+ * @name: The POSIX shared-memory name of the segment.
+ * @shared: Receives a consistent copy of the segment.
+ *
+ * Description: The segment is mapped read-only for the copy, so readers
+ * cannot disturb the publisher. The copy is taken again while the
+ * publisher was writing, a thousand times at most.
+ *
+ * Return: True on success, false if no segment of this layout exists
+ * or its publisher died while writing.
+ */
+bool stats_export_read(const char *name, stats_shared_t *shared)
+{
+	const stats_shared_t *mapping;
+	uint32_t sequence;
+	struct stat st;
+	int tries, fd = shm_open(name, O_RDONLY, 0);
+
+	if (fd < 0)
+		return (false);
+	mapping = MAP_FAILED;
+	if (fstat(fd, &st) == 0 && st.st_size >= (off_t)sizeof(*mapping))
+		mapping = mmap(NULL, sizeof(*mapping), PROT_READ, MAP_SHARED,
+				fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return (false);
+	for (tries = 0; tries < 1000; tries++)
+	{
+		sequence = mapping->sequence;
+		__sync_synchronize();
+		memcpy(shared, (const void *)mapping, sizeof(*shared));
+		__sync_synchronize();
+		if (!(sequence & 1) && mapping->sequence == sequence)
+			break;
+	}
+	munmap((void *)mapping, sizeof(*mapping));
+	return (tries < 1000 && shared->magic == STATS_MAGIC &&
+			shared->version == STATS_VERSION);
+}
@@ -0,0 +1,214 @@
+#include "../../headers/maze.h"
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+/**
+ * stream_sender - The main loop of the frame stream sender thread.
+ * @arg: Pointer to the frame_stream_t struct being sent.
+ *
+ * Description: Frames are encoded and sent in the order they were
+ * queued. Once the connection is lost the remaining frames are still
+ * consumed, so the caller never blocks, but nothing more is sent.
+ *
+ * Return: Always NULL.
+ */
+static void *stream_sender(void *arg)
+{
+	frame_stream_t *stream = arg;
+	size_t frame_size = (size_t)stream->width * stream->height, size = 0;
+	struct timespec start, end;
+	const color_t *slot;
+	unsigned long index;
+
+	pthread_mutex_lock(&stream->lock);
+	while (true)
+	{
+		while (stream->tail == stream->head && !stream->stopping)
+			pthread_cond_wait(&stream->frame_ready, &stream->lock);
+		if (stream->tail == stream->head)
+			break;
+		index = stream->tail;
+		pthread_mutex_unlock(&stream->lock);
+		slot = stream->slots + index % STREAM_RING_SIZE * frame_size;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		if (!stream->failed)
+			size = stream_encode_frame(stream, slot, index);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		if (!stream->failed && !stream_send(stream->fd, stream->scratch,
+					size))
+		{
+			stream->failed = true;
+			fprintf(stderr, "Lost the frame stream to %s at frame "
+					"%lu\n", stream->address, index);
+		}
+		pthread_mutex_lock(&stream->lock);
+		if (!stream->failed)
+		{
+			stream->sent++;
+			stream->bytes += size;
+			stream->encode_ns += (end.tv_sec - start.tv_sec) *
+				1000000000L + end.tv_nsec - start.tv_nsec;
+		}
+		stream->tail++;
+		pthread_cond_broadcast(&stream->frame_ready);
+	}
+	pthread_mutex_unlock(&stream->lock);
+	return (NULL);
+}
+
+/**
+ * stream_release - Frees everything a frame stream owns.
+ * @stream: Pointer to the frame_stream_t struct, whose sender is not
+ * running.
+ */
+static void stream_release(frame_stream_t *stream)
+{
+	if (stream->fd >= 0)
+		close(stream->fd);
+	free(stream->slots);
+	free(stream->previous);
+	free(stream->scratch);
+	free(stream->address);
+	pthread_mutex_destroy(&stream->lock);
+	pthread_cond_destroy(&stream->frame_ready);
+	memset(stream, 0, sizeof(*stream));
+}
+
+/**
+ * stream_start - Connects to a receiver and starts streaming frames.
+ * @stream: Pointer to the frame_stream_t struct to initialize.
+ * @address: The receiver, as unix:path or host:port with an IPv4 host;
+ * it must be listening already.
+ * @width: The width of the frames.
+ * @height: The height of the frames.
+ *
+ * Description: The stream starts with its hello: STREAM_MAGIC, then
+ * STREAM_VERSION, @width, @height and STREAM_TILE, each 32 bits, least
+ * significant byte first.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool stream_start(frame_stream_t *stream, const char *address, int width,
+		int height)
+{
+	uint32_t fields[4] = {STREAM_VERSION, 0, 0, STREAM_TILE};
+	size_t frame_size = (size_t)width * height;
+	unsigned char hello[STREAM_HELLO_SIZE];
+	int i;
+
+	fields[1] = width;
+	fields[2] = height;
+	memcpy(hello, STREAM_MAGIC, 4);
+	for (i = 4; i < STREAM_HELLO_SIZE; i++)
+		hello[i] = fields[i / 4 - 1] >> (i % 4 * 8);
+	memset(stream, 0, sizeof(*stream));
+	pthread_mutex_init(&stream->lock, NULL);
+	pthread_cond_init(&stream->frame_ready, NULL);
+	stream->width = width;
+	stream->height = height;
+	stream->address = malloc(strlen(address) + 1);
+	stream->slots = malloc(frame_size * STREAM_RING_SIZE *
+			sizeof(color_t));
+	stream->previous = malloc(frame_size * sizeof(color_t));
+	stream->scratch = malloc(stream_frame_bound(width, height));
+	stream->fd = stream_connect(address);
+	if (!stream->address || !stream->slots || !stream->previous ||
+			!stream->scratch || stream->fd < 0 ||
+			!stream_send(stream->fd, hello, sizeof(hello)) ||
+			pthread_create(&stream->sender, NULL, stream_sender,
+				stream) != 0)
+	{
+		fprintf(stderr, "Unable to stream the frames to %s\n", address);
+		stream_release(stream);
+		return (false);
+	}
+	strcpy(stream->address, address);
+	return (true);
+}
+
+/**
+ * stream_frame - Queues a finished frame for the sender thread.
+ * @stream: Pointer to the frame_stream_t struct.
+ * @pixels: The frame, of the size given to stream_start.
+ * @pitch: The number of pixels between the starts of two rows of @pixels.
+ *
+ * Description: Only one thread may queue frames. The cost is one memcpy
+ * of the frame; when every slot is still being encoded or sent the frame
+ * is counted in @stream->dropped instead, which is how a slow receiver
+ * pushes back. A zero-initialized stream that was never started ignores
+ * every frame.
+ *
+ * Return: True if the frame was queued, false if it was dropped.
+ */
+bool stream_frame(frame_stream_t *stream, const color_t *pixels, int pitch)
+{
+	size_t frame_size = (size_t)stream->width * stream->height;
+	color_t *slot;
+	bool full;
+	int y;
+
+	if (!stream->slots)
+		return (false);
+	pthread_mutex_lock(&stream->lock);
+	full = stream->head - stream->tail >= STREAM_RING_SIZE;
+	pthread_mutex_unlock(&stream->lock);
+	if (full)
+	{
+		stream->dropped++;
+		return (false);
+	}
+	slot = stream->slots + stream->head % STREAM_RING_SIZE * frame_size;
+	for (y = 0; y < stream->height; y++)
+		memcpy(slot + (size_t)y * stream->width,
+				pixels + (size_t)y * pitch,
+				stream->width * sizeof(color_t));
+	pthread_mutex_lock(&stream->lock);
+	stream->head++;
+	pthread_cond_broadcast(&stream->frame_ready);
+	pthread_mutex_unlock(&stream->lock);
+	return (true);
+}
+
+/**
+ * stream_stop - Sends the queued frames and closes a frame stream.
+ * @stream: Pointer to the frame_stream_t struct. Stopping a stream that
+ * was never started, or zero-initialized, does nothing.
+ *
+ * Description: The receiver sees the connection end after the last
+ * frame. A receiver that does not take the queued frames within
+ * STREAM_DRAIN_MS loses them: the socket is shut down, which fails the
+ * send the sender may be blocked in, so quitting never hangs on a
+ * receiver that stopped reading.
+ */
+void stream_stop(frame_stream_t *stream)
+{
+	struct timespec deadline;
+	unsigned long sent;
+
+	if (!stream->slots)
+		return;
+	clock_gettime(CLOCK_REALTIME, &deadline);
+	deadline.tv_nsec += STREAM_DRAIN_MS % 1000 * 1000000L;
+	deadline.tv_sec += STREAM_DRAIN_MS / 1000 +
+		deadline.tv_nsec / 1000000000L;
+	deadline.tv_nsec %= 1000000000L;
+	pthread_mutex_lock(&stream->lock);
+	stream->stopping = true;
+	pthread_cond_broadcast(&stream->frame_ready);
+	while (stream->tail != stream->head &&
+			pthread_cond_timedwait(&stream->frame_ready,
+				&stream->lock, &deadline) == 0)
+		;
+	if (stream->tail != stream->head)
+		shutdown(stream->fd, SHUT_RDWR);
+	pthread_mutex_unlock(&stream->lock);
+	pthread_join(stream->sender, NULL);
+	sent = stream->sent ? stream->sent : 1;
+	fprintf(stderr, "Streamed %lu frames to %s, dropped %lu, %.1f KB and "
+			"%.2f ms of encoding per frame\n", stream->sent,
+			stream->address, stream->dropped,
+			stream->bytes / 1024.0 / sent,
+			stream->encode_ns / 1e6 / sent);
+	stream_release(stream);
+}
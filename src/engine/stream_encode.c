@@ -0,0 +1,129 @@
+#include "../../headers/maze.h"
+
+/**
+ * stream_put32 - Writes a 32-bit value, least significant byte first.
+ * @out: The buffer to write to.
+ * @value: The value to write.
+ *
+ * Return: Pointer to the byte following the value.
+ */
+static unsigned char *stream_put32(unsigned char *out, uint32_t value)
+{
+	*out++ = value & 0xFF;
+	*out++ = (value >> 8) & 0xFF;
+	*out++ = (value >> 16) & 0xFF;
+	*out++ = value >> 24;
+	return (out);
+}
+
+/**
+ * stream_tile_update - Brings a tile of the last frame sent up to date.
+ * @stream: Pointer to the frame_stream_t struct.
+ * @pixels: The frame being sent.
+ * @x: The left edge of the tile.
+ * @y: The top edge of the tile.
+ * @w: The width of the tile.
+ * @h: The height of the tile.
+ *
+ * Return: True if any row of the tile changed, false otherwise.
+ */
+static bool stream_tile_update(frame_stream_t *stream, const color_t *pixels,
+		int x, int y, int w, int h)
+{
+	size_t row = (size_t)y * stream->width + x, end = row +
+		(size_t)h * stream->width;
+	bool changed = false;
+
+	for (; row < end; row += stream->width)
+		if (memcmp(stream->previous + row, pixels + row,
+					w * sizeof(color_t)) != 0)
+		{
+			memcpy(stream->previous + row, pixels + row,
+					w * sizeof(color_t));
+			changed = true;
+		}
+	return (changed);
+}
+
+/**
+ * stream_frame_bound - Computes the largest message a frame can take.
+ * @width: The width of the frames.
+ * @height: The height of the frames.
+ *
+ * Return: The size, in bytes, of a frame sending every tile, none of
+ * which compresses.
+ */
+size_t stream_frame_bound(int width, int height)
+{
+	size_t tiles = (size_t)((width + STREAM_TILE - 1) / STREAM_TILE) *
+		((height + STREAM_TILE - 1) / STREAM_TILE);
+
+	return (STREAM_FRAME_HEADER + tiles * 8 +
+			(size_t)width * height * 4);
+}
+
+/**
+ * stream_encode_frame - Encodes the tiles of a frame that changed.
+ * @stream: Pointer to the frame_stream_t struct; its scratch buffer
+ * receives the message.
+ * @pixels: The frame, of the size of the stream.
+ * @number: The number of the frame.
+ *
+ * Description: A frame is the number of the frame, the number of tiles
+ * and the size of what follows, then each tile: its index, row-major,
+ * the size of its chunks and its pixels as QOI chunks. All values are
+ * 32 bits, least significant byte first. The first frame sends every
+ * tile.
+ *
+ * Return: The size of the message, in bytes.
+ */
+size_t stream_encode_frame(frame_stream_t *stream, const color_t *pixels,
+		unsigned long number)
+{
+	unsigned char *out = stream->scratch, *header = out, *end;
+	int across = (stream->width + STREAM_TILE - 1) / STREAM_TILE;
+	int tiles = across * ((stream->height + STREAM_TILE - 1) / STREAM_TILE);
+	int tile, count = 0, x, y, w, h;
+
+	out += STREAM_FRAME_HEADER;
+	for (tile = 0; tile < tiles; tile++)
+	{
+		x = tile % across * STREAM_TILE;
+		y = tile / across * STREAM_TILE;
+		w = stream->width - x < STREAM_TILE ? stream->width - x :
+			STREAM_TILE;
+		h = stream->height - y < STREAM_TILE ? stream->height - y :
+			STREAM_TILE;
+		if (!stream_tile_update(stream, pixels, x, y, w, h) &&
+				stream->keyed)
+			continue;
+		end = qoi_encode_rows(pixels + (size_t)y * stream->width + x,
+				w, h, stream->width, out + 8);
+		stream_put32(stream_put32(out, tile), end - out - 8);
+		out = end;
+		count++;
+	}
+	stream->keyed = true;
+	stream_put32(stream_put32(stream_put32(header, number), count),
+			out - header - STREAM_FRAME_HEADER);
+	return (out - stream->scratch);
+}
+
+/**
+ * stream_totals - Reads how much a stream has sent so far.
+ * @stream: Pointer to the frame_stream_t struct, started or zeroed.
+ * @bytes: Receives the bytes sent.
+ * @encode_ns: Receives the nanoseconds spent encoding them.
+ */
+void stream_totals(frame_stream_t *stream, uint64_t *bytes,
+		uint64_t *encode_ns)
+{
+	*bytes = 0;
+	*encode_ns = 0;
+	if (!stream->slots)
+		return;
+	pthread_mutex_lock(&stream->lock);
+	*bytes = stream->bytes;
+	*encode_ns = stream->encode_ns;
+	pthread_mutex_unlock(&stream->lock);
+}
@@ -0,0 +1,135 @@
+#include "../../headers/maze.h"
+#include <unistd.h>
+
+/**
+ * stream_get32 - Reads a value written by stream_put32().
+ * @data: The four bytes of the value.
+ *
+ * Return: The value.
+ */
+static uint32_t stream_get32(const unsigned char *data)
+{
+	return (data[0] | data[1] << 8 | data[2] << 16 |
+			(uint32_t)data[3] << 24);
+}
+
+/**
+ * stream_mirror_open - Reads the hello of a frame stream.
+ * @mirror: Pointer to the stream_mirror_t struct to initialize.
+ * @fd: A socket connected to a sender, owned by the mirror from now on.
+ *
+ * Return: True on success, false if the hello is missing or malformed,
+ * or memory allocation failed; the socket is closed then.
+ */
+bool stream_mirror_open(stream_mirror_t *mirror, int fd)
+{
+	unsigned char hello[STREAM_HELLO_SIZE];
+
+	memset(mirror, 0, sizeof(*mirror));
+	mirror->fd = fd;
+	if (stream_receive(fd, hello, sizeof(hello)) != sizeof(hello) ||
+			memcmp(hello, STREAM_MAGIC, 4) != 0 ||
+			stream_get32(hello + 4) != STREAM_VERSION ||
+			stream_get32(hello + 16) != STREAM_TILE ||
+			stream_get32(hello + 8) - 1 >= MAP_MAX_SIZE ||
+			stream_get32(hello + 12) - 1 >= MAP_MAX_SIZE)
+	{
+		stream_mirror_close(mirror);
+		return (false);
+	}
+	mirror->width = stream_get32(hello + 8);
+	mirror->height = stream_get32(hello + 12);
+	mirror->tile = STREAM_TILE;
+	mirror->capacity = stream_frame_bound(mirror->width, mirror->height);
+	mirror->pixels = calloc((size_t)mirror->width * mirror->height,
+			sizeof(color_t));
+	mirror->data = malloc(mirror->capacity);
+	if (!mirror->pixels || !mirror->data)
+	{
+		stream_mirror_close(mirror);
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * stream_mirror_tiles - Decodes the tiles of a frame into the mirror.
+ * @mirror: Pointer to the stream_mirror_t struct.
+ * @size: The number of bytes of tiles in @mirror->data.
+ *
+ * Return: True on success, false if a tile is malformed.
+ */
+static bool stream_mirror_tiles(stream_mirror_t *mirror, size_t size)
+{
+	int across = (mirror->width + mirror->tile - 1) / mirror->tile;
+	int tiles = across * ((mirror->height + mirror->tile - 1) /
+			mirror->tile);
+	const unsigned char *data = mirror->data;
+	uint32_t tile, length;
+	int i, x, y, w, h;
+
+	for (i = 0; i < mirror->tiles; i++)
+	{
+		if (size < 8)
+			return (false);
+		tile = stream_get32(data);
+		length = stream_get32(data + 4);
+		if (tile >= (uint32_t)tiles || length > size - 8)
+			return (false);
+		x = tile % across * mirror->tile;
+		y = tile / across * mirror->tile;
+		w = mirror->width - x < mirror->tile ? mirror->width - x :
+			mirror->tile;
+		h = mirror->height - y < mirror->tile ? mirror->height - y :
+			mirror->tile;
+		if (qoi_decode_rows(data + 8, length, mirror->pixels +
+					(size_t)y * mirror->width + x, w, h,
+					mirror->width) != length)
+			return (false);
+		data += 8 + length;
+		size -= 8 + length;
+	}
+	return (size == 0);
+}
+
+/**
+ * stream_mirror_read - Waits for the next frame of a stream and applies it.
+ * @mirror: Pointer to the stream_mirror_t struct.
+ *
+ * Description: The tiles the frame carries replace those of
+ * @mirror->pixels, which then holds the frame the sender sent.
+ *
+ * Return: 1 if a frame was read, 0 if the sender closed the stream, or
+ * -1 if the frame is malformed or the connection failed.
+ */
+int stream_mirror_read(stream_mirror_t *mirror)
+{
+	unsigned char header[STREAM_FRAME_HEADER];
+	size_t got, size;
+
+	got = stream_receive(mirror->fd, header, sizeof(header));
+	if (got == 0)
+		return (0);
+	size = stream_get32(header + 8);
+	if (got != sizeof(header) || size > mirror->capacity ||
+			stream_receive(mirror->fd, mirror->data, size) != size)
+		return (-1);
+	mirror->frame = stream_get32(header);
+	mirror->tiles = stream_get32(header + 4);
+	mirror->bytes = sizeof(header) + size;
+	return (stream_mirror_tiles(mirror, size) ? 1 : -1);
+}
+
+/**
+ * stream_mirror_close - Closes the connection of a mirror and frees it.
+ * @mirror: Pointer to the stream_mirror_t struct, which is zeroed.
+ */
+void stream_mirror_close(stream_mirror_t *mirror)
+{
+	if (mirror->fd >= 0)
+		close(mirror->fd);
+	free(mirror->pixels);
+	free(mirror->data);
+	memset(mirror, 0, sizeof(*mirror));
+	mirror->fd = -1;
+}
@@ -0,0 +1,160 @@
+#include "../../headers/maze.h"
+#include <arpa/inet.h>
+#include <errno.h>
+#include <netinet/tcp.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+/**
+ * stream_address - Parses the address of a frame stream.
+ * @address: unix:path for a Unix socket, or host:port with an IPv4 host.
+ * @addr: Receives the address.
+ * @length: Receives the size of the address.
+ *
+ * Return: True on success, false if @address is malformed.
+ */
+static bool stream_address(const char *address, struct sockaddr_storage *addr,
+		socklen_t *length)
+{
+	struct sockaddr_un *local = (struct sockaddr_un *)addr;
+	struct sockaddr_in *inet = (struct sockaddr_in *)addr;
+	const char *colon = strrchr(address, ':');
+	char host[64];
+
+	memset(addr, 0, sizeof(*addr));
+	if (strncmp(address, "unix:", 5) == 0)
+	{
+		if (strlen(address + 5) >= sizeof(local->sun_path))
+			return (false);
+		local->sun_family = AF_UNIX;
+		strcpy(local->sun_path, address + 5);
+		*length = sizeof(*local);
+		return (address[5] != '\0');
+	}
+	if (!colon || colon == address || colon - address >= (long)sizeof(host))
+		return (false);
+	memcpy(host, address, colon - address);
+	host[colon - address] = '\0';
+	inet->sin_family = AF_INET;
+	inet->sin_port = htons(atoi(colon + 1));
+	*length = sizeof(*inet);
+	return (inet_pton(AF_INET, host, &inet->sin_addr) == 1);
+}
+
+/**
+ * stream_connect - Connects to the receiver of a frame stream.
+ * @address: unix:path for a Unix socket, or host:port with an IPv4 host.
+ *
+ * Description: Small writes go out at once over TCP, so the end of a
+ * frame is not held back waiting for the next one.
+ *
+ * Return: The connected socket, or -1 on failure.
+ */
+int stream_connect(const char *address)
+{
+	struct sockaddr_storage addr;
+	socklen_t length;
+	int fd, on = 1;
+
+	if (!stream_address(address, &addr, &length))
+		return (-1);
+	fd = socket(addr.ss_family, SOCK_STREAM, 0);
+	if (fd < 0)
+		return (-1);
+	if (addr.ss_family == AF_INET)
+		setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &on, sizeof(on));
+	if (connect(fd, (struct sockaddr *)&addr, length) != 0)
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * stream_listen - Opens a socket receivers of frame streams listen on.
+ * @address: unix:path for a Unix socket, replacing a stale one, or
+ * host:port with an IPv4 host; port 0 picks a free port.
+ *
+ * Return: The listening socket, or -1 on failure.
+ */
+int stream_listen(const char *address)
+{
+	struct sockaddr_storage addr;
+	socklen_t length;
+	int fd, on = 1;
+
+	if (!stream_address(address, &addr, &length))
+		return (-1);
+	fd = socket(addr.ss_family, SOCK_STREAM, 0);
+	if (fd < 0)
+		return (-1);
+	if (addr.ss_family == AF_UNIX)
+		unlink(address + 5);
+	else
+		setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on));
+	if (bind(fd, (struct sockaddr *)&addr, length) != 0 ||
+			listen(fd, 4) != 0)
+	{
+		close(fd);
+		return (-1);
+	}
+	return (fd);
+}
+
+/**
+ * stream_send - Sends a whole buffer over a socket.
+ * @fd: The connected socket.
+ * @data: The bytes to send.
+ * @size: The number of bytes of @data.
+ *
+ * Description: Blocks until the receiver took everything. A receiver
+ * closing the connection fails the call instead of raising SIGPIPE.
+ *
+ * Return: True on success, false if the connection was lost.
+ */
+bool stream_send(int fd, const void *data, size_t size)
+{
+	const unsigned char *bytes = data;
+	ssize_t sent;
+
+	while (size > 0)
+	{
+		sent = send(fd, bytes, size, MSG_NOSIGNAL);
+		if (sent < 0 && errno == EINTR)
+			continue;
+		if (sent <= 0)
+			return (false);
+		bytes += sent;
+		size -= sent;
+	}
+	return (true);
+}
+
+/**
+ * stream_receive - Reads a whole buffer from a socket.
+ * @fd: The connected socket.
+ * @data: Receives the bytes.
+ * @size: The number of bytes to read.
+ *
+ * Return: The number of bytes read, less than @size if the connection
+ * ended or failed first.
+ */
+size_t stream_receive(int fd, void *data, size_t size)
+{
+	unsigned char *bytes = data;
+	size_t total = 0;
+	ssize_t got;
+
+	while (total < size)
+	{
+		got = recv(fd, bytes + total, size - total, 0);
+		if (got < 0 && errno == EINTR)
+			continue;
+		if (got <= 0)
+			break;
+		total += got;
+	}
+	return (total);
+}
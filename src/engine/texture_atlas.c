@@ -0,0 +1,119 @@
+#include "../../headers/maze.h"
+
+/**
+ * texture_atlas_log2 - Computes the exponent of the power of two fitting
+ * a texture dimension.
+ * @size: The dimension, in pixels.
+ *
+ * Return: The smallest shift such that (1 << shift) >= @size.
+ */
+static int texture_atlas_log2(int size)
+{
+	int shift = 0;
+
+	while ((1 << shift) < size)
+		shift++;
+	return (shift);
+}
+
+/**
+ * texture_atlas_copy - Copies a texture into its atlas tile.
+ * @tile: Pointer to the destination tile, with power of two dimensions.
+ * @source: Pointer to the source texture.
+ *
+ * Description: Sources whose dimensions are not powers of two are scaled
+ * up with nearest neighbour sampling. A source that failed to load leaves
+ * a black tile.
+ */
+static void texture_atlas_copy(texture_t *tile, const texture_t *source)
+{
+	const color_t *source_row;
+	color_t *tile_row;
+	int x, y;
+	size_t num_pixels = (size_t)tile->width * tile->height;
+
+	if (!source->texture_buffer)
+	{
+		memset(tile->texture_buffer, 0, num_pixels * sizeof(color_t));
+		return;
+	}
+	if (source->width == tile->width && source->height == tile->height)
+	{
+		memcpy(tile->texture_buffer, source->texture_buffer,
+				num_pixels * sizeof(color_t));
+		return;
+	}
+	for (y = 0; y < tile->height; y++)
+	{
+		source_row = source->texture_buffer +
+			(long)y * source->height / tile->height * source->width;
+		tile_row = tile->texture_buffer + (y << tile->width_shift);
+		for (x = 0; x < tile->width; x++)
+			tile_row[x] = source_row[
+				(long)x * source->width / tile->width];
+	}
+}
+
+/**
+ * texture_atlas_build - Packs textures into a single aligned allocation.
+ * @atlas: Pointer to the texture_atlas_t struct to build.
+ * @sources: Array of @count textures to pack. They are only read.
+ * @count: The number of textures, at most TEXTURE_MAX_IDS.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool texture_atlas_build(texture_atlas_t *atlas, const texture_t *sources,
+		int count)
+{
+	size_t offsets[TEXTURE_MAX_IDS], total = 0, mask = CACHE_LINE_SIZE - 1;
+	texture_t *tile;
+	int i;
+
+	atlas->pixels = NULL;
+	atlas->count = 0;
+	if (count > TEXTURE_MAX_IDS)
+		return (false);
+	for (i = 0; i < TEXTURE_MAX_IDS; i++)
+	{
+		tile = &atlas->tiles[i];
+		offsets[i] = total;
+		tile->width = tile->height = 1;
+		tile->width_shift = 0;
+		if (i >= count)
+			continue;
+		tile->width_shift = texture_atlas_log2(sources[i].width);
+		tile->width = 1 << tile->width_shift;
+		tile->height = 1 << texture_atlas_log2(sources[i].height);
+		total += (sizeof(color_t) * tile->width * tile->height + mask) &
+			~mask;
+	}
+	/* The last cache line holds the black texel of the missing indices */
+	if (posix_memalign((void **)&atlas->pixels, CACHE_LINE_SIZE,
+				total + CACHE_LINE_SIZE) != 0)
+	{
+		fprintf(stderr, "Unable to allocate the texture atlas\n");
+		atlas->pixels = NULL;
+		return (false);
+	}
+	atlas->pixels[total / sizeof(color_t)] = 0;
+	for (i = 0; i < TEXTURE_MAX_IDS; i++)
+	{
+		atlas->tiles[i].texture_buffer = atlas->pixels +
+			offsets[i] / sizeof(color_t);
+		if (i < count)
+			texture_atlas_copy(&atlas->tiles[i], &sources[i]);
+	}
+	atlas->count = count;
+	return (true);
+}
+
+/**
+ * texture_atlas_free - Releases the memory of a texture atlas.
+ * @atlas: Pointer to the texture_atlas_t struct to release.
+ */
+void texture_atlas_free(texture_atlas_t *atlas)
+{
+	free(atlas->pixels);
+	atlas->pixels = NULL;
+	atlas->count = 0;
+}
@@ -0,0 +1,136 @@
+#include "../../headers/maze.h"
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * texture_cache_map - Maps a whole cache file read-only in memory.
+ * @cache: Pointer to the texture_cache_t struct receiving the mapping.
+ * @path: The path of the cache file.
+ *
+ * Description: The mapping is shared, so every process mapping the same
+ * cache file reads the same page cache pages, and the pages of a texture
+ * are only read once it is loaded.
+ *
+ * Return: True if the file was mapped, false otherwise.
+ */
+static bool texture_cache_map(texture_cache_t *cache, const char *path)
+{
+	struct stat st;
+	void *mapping;
+	int fd;
+
+	cache->mapping = NULL;
+	cache->size = 0;
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (false);
+	if (fstat(fd, &st) != 0 ||
+			st.st_size < (off_t)sizeof(texture_cache_header_t))
+	{
+		close(fd);
+		return (false);
+	}
+	mapping = mmap(NULL, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+	close(fd);
+	if (mapping == MAP_FAILED)
+		return (false);
+	cache->mapping = mapping;
+	cache->size = st.st_size;
+	return (true);
+}
+
+/**
+ * texture_cache_entry_valid - Checks that a cache entry is still usable.
+ * @cache: Pointer to the mapped texture_cache_t struct.
+ * @entry: Pointer to the texture_cache_entry_t to check.
+ * @source: The path of the image the entry was decoded from.
+ *
+ * Description: An empty @source is a gap, whose entry must be empty.
+ *
+ * Return: True if the source is unchanged and the pixels are inside the
+ * file, false otherwise.
+ */
+static bool texture_cache_entry_valid(const texture_cache_t *cache,
+		const texture_cache_entry_t *entry, const char *source)
+{
+	int64_t mtime, size;
+	uint64_t bytes;
+
+	if (!*source)
+		return (entry->width == 0 && entry->height == 0);
+	if (!texture_source_stat(source, &mtime, &size))
+		return (false);
+	if (entry->source_mtime != mtime || entry->source_size != size)
+		return (false);
+	bytes = (uint64_t)entry->width * entry->height * sizeof(color_t);
+	return (entry->offset % TEXTURE_CACHE_ALIGN == 0 &&
+			entry->offset <= cache->size &&
+			bytes <= cache->size - entry->offset);
+}
+
+/**
+ * texture_cache_load - Points textures at the pixels of a cache file.
+ * @cache: Pointer to the texture_cache_t struct receiving the mapping.
+ * @path: The path of the cache file.
+ * @sources: The paths of the @count source images, in cache order.
+ * @textures: Array of @count texture_t structs to fill.
+ * @count: The number of textures.
+ *
+ * Description: Nothing is decoded or copied: the texture buffers point
+ * straight into the read-only mapping and stay valid until
+ * texture_cache_close(). The cache is rejected as a whole if its version
+ * differs or if any source image changed since it was written. An
+ * empty source is a gap in the list, left with a NULL buffer.
+ *
+ * Return: True if the textures were loaded, false otherwise.
+ */
+bool texture_cache_load(texture_cache_t *cache, const char *path,
+		const char * const *sources, texture_t *textures, int count)
+{
+	const texture_cache_header_t *header;
+	const texture_cache_entry_t *entries;
+	int i;
+
+	if (!texture_cache_map(cache, path))
+		return (false);
+	header = cache->mapping;
+	entries = (const texture_cache_entry_t *)(header + 1);
+	if (memcmp(header->magic, TEXTURE_CACHE_MAGIC, 8) != 0 ||
+			header->version != TEXTURE_CACHE_VERSION ||
+			header->num_textures != (uint32_t)count || cache->size <
+			sizeof(*header) + sizeof(*entries) * count)
+	{
+		texture_cache_close(cache);
+		return (false);
+	}
+	for (i = 0; i < count; i++)
+		if (!texture_cache_entry_valid(cache, &entries[i], sources[i]))
+		{
+			texture_cache_close(cache);
+			return (false);
+		}
+	for (i = 0; i < count; i++)
+	{
+		textures[i].width = entries[i].width;
+		textures[i].height = entries[i].height;
+		textures[i].texture_buffer = !*sources[i] ? NULL :
+			(color_t *)((char *)cache->mapping + entries[i].offset);
+	}
+	return (true);
+}
+
+/**
+ * texture_cache_close - Unmaps a cache file.
+ * @cache: Pointer to the texture_cache_t struct to close.
+ *
+ * Description: Textures loaded from the cache must not be used afterwards.
+ */
+void texture_cache_close(texture_cache_t *cache)
+{
+	if (cache->mapping)
+		munmap(cache->mapping, cache->size);
+	cache->mapping = NULL;
+	cache->size = 0;
+}
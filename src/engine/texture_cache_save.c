@@ -0,0 +1,134 @@
+#include "../../headers/maze.h"
+#include <sys/stat.h>
+#include <unistd.h>
+
+/**
+ * texture_source_stat - Reads what identifies a version of a source image.
+ * @source: The path of the image.
+ * @mtime: Pointer receiving the modification time, in nanoseconds.
+ * @size: Pointer receiving the size of the image, in bytes.
+ *
+ * Return: True on success, false if the image cannot be found.
+ */
+bool texture_source_stat(const char *source, int64_t *mtime, int64_t *size)
+{
+	struct stat st;
+
+	if (stat(source, &st) != 0)
+		return (false);
+	*mtime = (int64_t)st.st_mtim.tv_sec * 1000000000 + st.st_mtim.tv_nsec;
+	*size = st.st_size;
+	return (true);
+}
+
+/**
+ * texture_cache_write_index - Writes the header and entries of a cache.
+ * @file: The cache file.
+ * @entries: Array of @count entries describing the textures written.
+ * @count: The number of textures.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool texture_cache_write_index(FILE *file,
+		const texture_cache_entry_t *entries, int count)
+{
+	texture_cache_header_t header;
+
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, TEXTURE_CACHE_MAGIC, sizeof(TEXTURE_CACHE_MAGIC));
+	header.version = TEXTURE_CACHE_VERSION;
+	header.num_textures = count;
+	return (fseek(file, 0, SEEK_SET) == 0 &&
+			fwrite(&header, sizeof(header), 1, file) == 1 &&
+			fwrite(entries, sizeof(*entries), count, file) ==
+			(size_t)count);
+}
+
+/**
+ * texture_cache_write_texture - Writes the pixels of one texture.
+ * @file: The cache file.
+ * @source: The path of the image the texture was decoded from.
+ * @texture: The decoded texture.
+ * @offset: Pointer to the end of the data written so far, advanced past
+ * the pixels.
+ * @entry: Receives what was written.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool texture_cache_write_texture(FILE *file, const char *source,
+		const texture_t *texture, uint64_t *offset,
+		texture_cache_entry_t *entry)
+{
+	size_t num_pixels = (size_t)texture->width * texture->height;
+
+	memset(entry, 0, sizeof(*entry));
+	if (!texture_source_stat(source, &entry->source_mtime,
+				&entry->source_size))
+		return (false);
+	entry->width = texture->width;
+	entry->height = texture->height;
+	entry->offset = (*offset + TEXTURE_CACHE_ALIGN - 1) &
+		~(uint64_t)(TEXTURE_CACHE_ALIGN - 1);
+	*offset = entry->offset + sizeof(color_t) * num_pixels;
+	return (fseek(file, entry->offset, SEEK_SET) == 0 &&
+			fwrite(texture->texture_buffer, sizeof(color_t),
+				num_pixels, file) == num_pixels);
+}
+
+/**
+ * texture_cache_save - Writes decoded textures to a cache file.
+ * @path: The path of the cache file.
+ * @sources: The paths of the @count source images; an empty one is a
+ * gap, written as an empty entry.
+ * @count: The number of textures.
+ * @load: Decodes a texture into a malloc'ed buffer; called once per
+ * texture but the gaps, in order, with @context and the index of the
+ * texture.
+ * @context: The first argument of @load.
+ *
+ * Description: Textures are decoded and written one at a time, so a set
+ * of textures larger than memory can be cached. The cache is written
+ * next to @path and renamed over it, so processes mapping the previous
+ * cache keep a consistent view of it.
+ *
+ * Return: True on success, false if a texture cannot be decoded or the
+ * file cannot be written.
+ */
+bool texture_cache_save(const char *path, const char * const *sources,
+		int count, bool (*load)(void *, int, texture_t *),
+		void *context)
+{
+	texture_cache_entry_t *entries;
+	texture_t texture;
+	uint64_t offset;
+	char tmp_path[4096];
+	FILE *file;
+	bool ok = true;
+	int i;
+
+	sprintf(tmp_path, "%.4000s.%d.tmp", path, (int)getpid());
+	entries = malloc(sizeof(*entries) * (count ? count : 1));
+	file = entries ? fopen(tmp_path, "wb") : NULL;
+	if (!file)
+	{
+		free(entries);
+		return (false);
+	}
+	offset = sizeof(texture_cache_header_t) + sizeof(*entries) * count;
+	for (i = 0; ok && i < count; i++)
+	{
+		memset(&entries[i], 0, sizeof(entries[i]));
+		texture.texture_buffer = NULL;
+		ok = !*sources[i] || (load(context, i, &texture) &&
+			texture_cache_write_texture(file, sources[i], &texture,
+					&offset, &entries[i]));
+		free(texture.texture_buffer);
+	}
+	ok = ok && texture_cache_write_index(file, entries, count);
+	free(entries);
+	ok = fclose(file) == 0 && ok;
+	if (ok && rename(tmp_path, path) == 0)
+		return (true);
+	remove(tmp_path);
+	return (false);
+}
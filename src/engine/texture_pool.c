@@ -0,0 +1,176 @@
+#include "../../headers/maze.h"
+
+/**
+ * texture_pool_loader - Loads the textures queued in a pool.
+ * @arg: Pointer to the texture_pool_t struct.
+ *
+ * Description: The lock is released while a texture is read and packed
+ * into its tile, so requests keep coming while the loader works. A
+ * texture that fails to load is handed back without a buffer. The
+ * generation of the index is read with the index and passed to the
+ * load. Texels the load only borrows, such as those of a mapped cache,
+ * go straight into the tile and are not freed.
+ *
+ * Return: NULL.
+ */
+static void *texture_pool_loader(void *arg)
+{
+	texture_pool_t *pool = arg;
+	texture_atlas_t tile;
+	texture_t source;
+	unsigned int generation;
+	bool built, borrowed;
+	int index;
+
+	pthread_mutex_lock(&pool->lock);
+	while (!pool->stopping)
+	{
+		if (pool->queued == 0)
+		{
+			pthread_cond_wait(&pool->wake, &pool->lock);
+			continue;
+		}
+		index = pool->queue[pool->head];
+		pool->head = (pool->head + 1) % TEXTURE_MAX_IDS;
+		pool->queued--;
+		generation = pool->generations[index];
+		pthread_mutex_unlock(&pool->lock);
+		source.texture_buffer = NULL;
+		borrowed = false;
+		built = pool->load(pool->context, index, generation, &source,
+				&borrowed) &&
+			texture_atlas_build(&tile, &source, 1);
+		if (!borrowed)
+			free(source.texture_buffer);
+		pthread_mutex_lock(&pool->lock);
+		pool->loaded[index] = tile.tiles[0];
+		if (!built)
+			pool->loaded[index].texture_buffer = NULL;
+		pool->done[pool->num_done++] = index;
+		if (--pool->busy == 0)
+			pthread_cond_broadcast(&pool->idle);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+/**
+ * texture_pool_init - Sets up a pool and starts its loader thread.
+ * @pool: Pointer to the texture_pool_t struct to initialize.
+ * @count: The number of texture indices @load can read, at most
+ * TEXTURE_MAX_IDS; the others always show the placeholder.
+ * @budget: The bytes of texels the pool should keep resident.
+ * @load: Reads the texture of an index into a malloc'ed buffer, which
+ * the pool frees, or returns false and leaves the buffer NULL. It may
+ * instead point the buffer at texels that outlive the pool and set its
+ * last argument, so they are only read. It runs on the loader thread,
+ * and its third argument is the generation of the index: 0 until
+ * texture_pool_invalidate() is first called on it.
+ * @context: The first argument of @load.
+ *
+ * Description: Nothing is loaded yet: every index shows a checkered
+ * placeholder until a view hits it and texture_pool_update() installs
+ * what the loader read.
+ *
+ * Return: True on success, false if @count is too large or the loader
+ * thread cannot be started.
+ */
+bool texture_pool_init(texture_pool_t *pool, int count, size_t budget,
+		bool (*load)(void *, int, unsigned int, texture_t *, bool *),
+		void *context)
+{
+	int i, size = 1 << TEXTURE_PLACEHOLDER_SHIFT;
+
+	memset(pool, 0, sizeof(*pool));
+	if (count < 0 || count > TEXTURE_MAX_IDS)
+		return (false);
+	for (i = 0; i < size * size; i++)
+		pool->placeholder[i] = ((i / size ^ i) & 1) ? 0xFF808080 :
+			0xFF404040;
+	for (i = 0; i < TEXTURE_MAX_IDS; i++)
+	{
+		pool->textures[i].width = size;
+		pool->textures[i].height = size;
+		pool->textures[i].width_shift = TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[i].texture_buffer = pool->placeholder;
+	}
+	pool->count = count;
+	pool->budget = budget;
+	pool->load = load;
+	pool->context = context;
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->wake, NULL);
+	pthread_cond_init(&pool->idle, NULL);
+	if (pthread_create(&pool->loader, NULL, texture_pool_loader,
+				pool) != 0)
+	{
+		fprintf(stderr, "Unable to start the texture loader\n");
+		pthread_cond_destroy(&pool->idle);
+		pthread_cond_destroy(&pool->wake);
+		pthread_mutex_destroy(&pool->lock);
+		pool->load = NULL;
+		return (false);
+	}
+	return (true);
+}
+
+/**
+ * texture_pool_invalidate - Notes that the source of a texture changed.
+ * @pool: Pointer to the texture_pool_t struct.
+ * @index: The texture index.
+ *
+ * Description: Nothing waits for the loader: the generation of the
+ * index is bumped, and a load already in progress is read again once it
+ * is installed. A resident texture stays on screen until the new one is
+ * read, the next time a view hits it; one that failed is tried again.
+ */
+void texture_pool_invalidate(texture_pool_t *pool, int index)
+{
+	if (index < 0 || index >= pool->count || !pool->load)
+		return;
+	pthread_mutex_lock(&pool->lock);
+	pool->generations[index]++;
+	pthread_mutex_unlock(&pool->lock);
+	if (pool->slots[index].state == TEXTURE_FAILED)
+		pool->slots[index].state = TEXTURE_ABSENT;
+	else if (pool->slots[index].state != TEXTURE_ABSENT)
+		pool->slots[index].stale = true;
+}
+
+/**
+ * texture_pool_free - Stops the loader and releases every texture.
+ * @pool: Pointer to the texture_pool_t struct to release.
+ *
+ * Description: A load in progress is finished first; the queued ones
+ * are dropped. Every index shows the placeholder afterwards.
+ */
+void texture_pool_free(texture_pool_t *pool)
+{
+	int i;
+
+	if (!pool->load)
+		return;
+	pthread_mutex_lock(&pool->lock);
+	pool->stopping = true;
+	pthread_cond_signal(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+	pthread_join(pool->loader, NULL);
+	for (i = 0; i < pool->num_done; i++)
+		free(pool->loaded[pool->done[i]].texture_buffer);
+	for (i = 0; i < TEXTURE_MAX_IDS; i++)
+	{
+		free(pool->slots[i].pixels);
+		pool->slots[i].pixels = NULL;
+		pool->slots[i].state = TEXTURE_ABSENT;
+		pool->textures[i].width = 1 << TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[i].height = 1 << TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[i].width_shift = TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[i].texture_buffer = pool->placeholder;
+	}
+	pthread_cond_destroy(&pool->idle);
+	pthread_cond_destroy(&pool->wake);
+	pthread_mutex_destroy(&pool->lock);
+	pool->num_done = 0;
+	pool->resident = 0;
+	pool->load = NULL;
+}
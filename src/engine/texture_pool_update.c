@@ -0,0 +1,155 @@
+#include "../../headers/maze.h"
+
+/**
+ * texture_pool_install - Swaps in the textures the loader finished.
+ * @pool: Pointer to the texture_pool_t struct.
+ *
+ * Description: A texture that failed to load again keeps the texels it
+ * had, if any.
+ */
+static void texture_pool_install(texture_pool_t *pool)
+{
+	texture_slot_t *slot;
+	texture_t *tile;
+	int i, index;
+
+	pthread_mutex_lock(&pool->lock);
+	for (i = 0; i < pool->num_done; i++)
+	{
+		index = pool->done[i];
+		slot = &pool->slots[index];
+		tile = &pool->loaded[index];
+		if (!tile->texture_buffer)
+		{
+			slot->state = slot->pixels ? TEXTURE_RESIDENT :
+				TEXTURE_FAILED;
+			continue;
+		}
+		free(slot->pixels);
+		pool->resident -= slot->bytes;
+		slot->pixels = tile->texture_buffer;
+		slot->bytes = sizeof(color_t) * tile->width * tile->height;
+		pool->resident += slot->bytes;
+		slot->state = TEXTURE_RESIDENT;
+		pool->textures[index] = *tile;
+		pool->loads++;
+	}
+	pool->num_done = 0;
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * texture_pool_request - Queues a texture for the loader thread.
+ * @pool: Pointer to the texture_pool_t struct.
+ * @index: The texture index, which is not queued yet.
+ */
+static void texture_pool_request(texture_pool_t *pool, int index)
+{
+	pool->slots[index].state = TEXTURE_QUEUED;
+	pool->slots[index].stale = false;
+	pthread_mutex_lock(&pool->lock);
+	pool->queue[(pool->head + pool->queued++) % TEXTURE_MAX_IDS] = index;
+	pool->busy++;
+	pthread_cond_signal(&pool->wake);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * texture_pool_evict - Releases the least recently hit textures until
+ * the resident ones fit in the budget.
+ * @pool: Pointer to the texture_pool_t struct.
+ *
+ * Description: The textures hit in the last update are never evicted,
+ * so the budget is only exceeded when a single frame shows more than it
+ * holds.
+ */
+static void texture_pool_evict(texture_pool_t *pool)
+{
+	texture_slot_t *slot;
+	int i, oldest;
+
+	while (pool->resident > pool->budget)
+	{
+		oldest = -1;
+		for (i = 0, slot = pool->slots; i < pool->count; i++)
+			if (slot[i].state == TEXTURE_RESIDENT &&
+					slot[i].last_used < pool->frame &&
+					(oldest < 0 || slot[i].last_used <
+					 slot[oldest].last_used))
+				oldest = i;
+		if (oldest < 0)
+			return;
+		slot = &pool->slots[oldest];
+		free(slot->pixels);
+		slot->pixels = NULL;
+		pool->resident -= slot->bytes;
+		slot->bytes = 0;
+		slot->state = TEXTURE_ABSENT;
+		slot->stale = false;
+		pool->textures[oldest].width = 1 << TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[oldest].height = 1 << TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[oldest].width_shift = TEXTURE_PLACEHOLDER_SHIFT;
+		pool->textures[oldest].texture_buffer = pool->placeholder;
+		pool->evictions++;
+	}
+}
+
+/**
+ * texture_pool_update - Applies the textures the last frame hit.
+ * @pool: Pointer to the texture_pool_t struct.
+ * @views: Array of @count views whose frame was just cast.
+ * @count: The number of views.
+ *
+ * Description: Called between frames, as it changes what views read.
+ * The textures the loader finished are installed, the ones the views
+ * hit are stamped as used and queued if they are not resident, and the
+ * least recently used are evicted if the pool is over its budget. A
+ * texture hit for the first time shows the placeholder for a frame or
+ * two, while the loader reads it.
+ */
+void texture_pool_update(texture_pool_t *pool, const view_t *views,
+		int count)
+{
+	texture_slot_t *slot;
+	uint32_t hit;
+	int i, index;
+
+	if (!pool->load)
+		return;
+	pool->frame++;
+	texture_pool_install(pool);
+	for (index = 0; index < pool->count; index++)
+	{
+		for (i = 0, hit = 0; i < count; i++)
+			hit |= views[i].textures_hit[index / 32] >> index % 32;
+		if (!(hit & 1))
+			continue;
+		slot = &pool->slots[index];
+		slot->last_used = pool->frame;
+		if (slot->state == TEXTURE_ABSENT ||
+				(slot->stale && slot->state != TEXTURE_QUEUED))
+			texture_pool_request(pool, index);
+	}
+	texture_pool_evict(pool);
+}
+
+/**
+ * texture_pool_flush - Waits for the requested textures and installs
+ * them.
+ * @pool: Pointer to the texture_pool_t struct.
+ *
+ * Description: Called between frames, like texture_pool_update(), when
+ * the textures must be on screen right away: before a reload reads the
+ * sources again, or in tests.
+ */
+void texture_pool_flush(texture_pool_t *pool)
+{
+	if (!pool->load)
+		return;
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy > 0)
+		pthread_cond_wait(&pool->idle, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+	texture_pool_install(pool);
+	texture_pool_evict(pool);
+}
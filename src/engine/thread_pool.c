@@ -0,0 +1,145 @@
+#include "../../headers/maze.h"
+#include <unistd.h>
+
+/**
+ * thread_pool_drain - Runs items of the current loop until none are left.
+ * @pool: Pointer to the thread_pool_t struct. Its lock must be held.
+ *
+ * Description: The lock is released while an item runs, so every thread
+ * of the pool can work on the same loop.
+ */
+static void thread_pool_drain(thread_pool_t *pool)
+{
+	int index;
+
+	while (pool->next_index < pool->job_count)
+	{
+		index = pool->next_index++;
+		pthread_mutex_unlock(&pool->lock);
+		pool->job(pool->job_arg, index);
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->pending == 0)
+			pthread_cond_broadcast(&pool->work_done);
+	}
+}
+
+/**
+ * thread_pool_worker - The main loop of a worker thread.
+ * @arg: Pointer to the thread_pool_t struct the worker belongs to.
+ *
+ * Return: Always NULL.
+ */
+static void *thread_pool_worker(void *arg)
+{
+	thread_pool_t *pool = arg;
+	unsigned long seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	while (true)
+	{
+		while (!pool->shutting_down && pool->generation == seen)
+			pthread_cond_wait(&pool->work_ready, &pool->lock);
+		if (pool->shutting_down)
+			break;
+		seen = pool->generation;
+		thread_pool_drain(pool);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return (NULL);
+}
+
+/**
+ * thread_pool_init - Starts the workers of a thread pool.
+ * @pool: Pointer to the thread_pool_t struct to initialize.
+ * @num_threads: The number of threads, caller included, that run a loop.
+ * Zero or less uses one thread per online core.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool thread_pool_init(thread_pool_t *pool, int num_threads)
+{
+	int i;
+
+	if (num_threads <= 0)
+		num_threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+	memset(pool, 0, sizeof(*pool));
+	pool->num_threads = num_threads > 1 ? num_threads - 1 : 0;
+	pool->threads = malloc(sizeof(pthread_t) * (pool->num_threads + 1));
+	if (!pool->threads)
+	{
+		fprintf(stderr, "Unable to allocate memory for thread pool\n");
+		return (false);
+	}
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->work_ready, NULL);
+	pthread_cond_init(&pool->work_done, NULL);
+	for (i = 0; i < pool->num_threads; i++)
+	{
+		if (pthread_create(&pool->threads[i], NULL,
+					thread_pool_worker, pool) != 0)
+		{
+			fprintf(stderr, "Unable to start worker %d\n", i);
+			pool->num_threads = i;
+			thread_pool_destroy(pool);
+			return (false);
+		}
+	}
+	return (true);
+}
+
+/**
+ * thread_pool_run - Runs @job once for every index in [0, @count).
+ * @pool: Pointer to the thread_pool_t struct, or NULL to run serially.
+ * @count: The number of items.
+ * @job: The function to run, called with @arg and the item index.
+ * @arg: The argument passed to @job.
+ *
+ * Description: The calling thread takes part in the loop, and the call
+ * returns once every item has completed.
+ */
+void thread_pool_run(thread_pool_t *pool, int count,
+		void (*job)(void *, int), void *arg)
+{
+	int i;
+
+	if (!pool || pool->num_threads == 0 || count <= 1)
+	{
+		for (i = 0; i < count; i++)
+			job(arg, i);
+		return;
+	}
+	pthread_mutex_lock(&pool->lock);
+	pool->job = job;
+	pool->job_arg = arg;
+	pool->job_count = count;
+	pool->next_index = 0;
+	pool->pending = count;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->work_ready);
+	thread_pool_drain(pool);
+	while (pool->pending > 0)
+		pthread_cond_wait(&pool->work_done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * thread_pool_destroy - Stops the workers and frees a thread pool.
+ * @pool: Pointer to the thread_pool_t struct to destroy.
+ */
+void thread_pool_destroy(thread_pool_t *pool)
+{
+	int i;
+
+	pthread_mutex_lock(&pool->lock);
+	pool->shutting_down = true;
+	pthread_cond_broadcast(&pool->work_ready);
+	pthread_mutex_unlock(&pool->lock);
+	for (i = 0; i < pool->num_threads; i++)
+		pthread_join(pool->threads[i], NULL);
+	pthread_mutex_destroy(&pool->lock);
+	pthread_cond_destroy(&pool->work_ready);
+	pthread_cond_destroy(&pool->work_done);
+	free(pool->threads);
+	pool->threads = NULL;
+	pool->num_threads = 0;
+}
@@ -0,0 +1,144 @@
+#include "../../headers/maze.h"
+
+/**
+ * view_arena_size - Computes the per-frame memory a view needs.
+ * @width: The width of the view, which is also the number of rays.
+ *
+ * Return: The size of the view arena, in bytes.
+ */
+static size_t view_arena_size(int width)
+{
+	size_t line = CACHE_LINE_SIZE, bytes = 0;
+
+	/* Each array of the ray buffer is rounded up to whole cache lines */
+	bytes += 4 * ((sizeof(float) * width + line - 1) / line * line);
+	bytes += (sizeof(int) * width + line - 1) / line * line;
+	bytes += (sizeof(unsigned char) * width + line - 1) / line * line;
+	bytes += (sizeof(draw_cmd_t) * DRAW_BATCH_SIZE + line - 1) /
+		line * line;
+	return (bytes);
+}
+
+/**
+ * view_init - Sets up a view rendering a player into a caller buffer.
+ * @view: Pointer to the view_t struct to initialize.
+ * @world: Pointer to the shared world the view looks into.
+ * @player: Pointer to the player_t giving the camera position and angle.
+ * @pixels: Caller-owned RGBA32 buffer of @width * @height pixels.
+ * @width: The width of @pixels, which is also the number of rays.
+ * @height: The height of @pixels.
+ *
+ * Return: True on success, false if the frame arena cannot be allocated.
+ */
+bool view_init(view_t *view, const world_t *world, const player_t *player,
+		color_t *pixels, int width, int height)
+{
+	color_t color;
+	int shade;
+
+	view->world = world;
+	view->player = player;
+	view->frame.pixels = pixels;
+	view->frame.width = width;
+	view->frame.height = height;
+	view->frame.pitch = width;
+	view->frame.pixel_calls = 0;
+	view->dist_proj_plane = (width / 2) / tan(FOV_ANGLE / 2);
+	view->enable_minimap = false;
+	memset(&view->minimap, 0, sizeof(view->minimap));
+	view->minimap.scale = MINIMAP_SCALE_FACTOR;
+	memset(&view->rays, 0, sizeof(view->rays));
+	memset(&view->overlay, 0, sizeof(view->overlay));
+	memset(&view->history, 0, sizeof(view->history));
+	view->interleave = 1;
+	view->span_columns = 0;
+	ray_cache_init(&view->ray_cache);
+	memset(&view->stats, 0, sizeof(view->stats));
+	memset(view->textures_hit, 0, sizeof(view->textures_hit));
+	view->perf = NULL;
+	for (shade = 0; shade < 256; shade++)
+	{
+		color = shade;
+		darken_color_intensity(&color, 0.7);
+		view->darken[shade] = color;
+	}
+	return (frame_arena_init(&view->arena, view_arena_size(width)));
+}
+
+/**
+ * view_free - Releases the memory owned by a view.
+ * @view: Pointer to the view_t struct to release.
+ *
+ * Description: The framebuffer, world and player are owned by the caller
+ * and are left untouched.
+ */
+void view_free(view_t *view)
+{
+	frame_arena_free(&view->arena);
+	minimap_free(&view->minimap);
+	view_set_interleave(view, 1);
+	ray_cache_free(&view->ray_cache);
+	memset(&view->rays, 0, sizeof(view->rays));
+	memset(&view->overlay, 0, sizeof(view->overlay));
+}
+
+/**
+ * view_begin_frame - Resets the per-frame data of a view.
+ * @view: Pointer to the view_t struct starting a new frame.
+ *
+ * Description: The frame arena is emptied and the ray buffer is carved
+ * out of it again, one cache-line aligned array per field, followed by
+ * an empty overlay batch.
+ *
+ * Return: True on success, false if the arena is too small.
+ */
+bool view_begin_frame(view_t *view)
+{
+	frame_arena_t *arena = &view->arena;
+	ray_buffer_t *rays = &view->rays;
+	int count = view->frame.width;
+
+	frame_arena_reset(arena);
+	rays->count = count;
+	rays->ray_angle = frame_arena_alloc(arena, sizeof(float) * count);
+	rays->wall_hit_x = frame_arena_alloc(arena, sizeof(float) * count);
+	rays->wall_hit_y = frame_arena_alloc(arena, sizeof(float) * count);
+	rays->distance = frame_arena_alloc(arena, sizeof(float) * count);
+	rays->texture = frame_arena_alloc(arena, sizeof(int) * count);
+	rays->was_hit_vertical = frame_arena_alloc(arena, count);
+	return (rays->ray_angle && rays->wall_hit_x && rays->wall_hit_y &&
+			rays->distance && rays->texture &&
+			rays->was_hit_vertical && draw_batch_init(
+				&view->overlay, arena, DRAW_BATCH_SIZE));
+}
+
+/**
+ * render_view - Renders the rays last cast by a view into its framebuffer.
+ * @view: Pointer to the view_t struct to render.
+ *
+ * Description: cast_all_rays() has to be called on the view first. An
+ * interleaved view keeps the frame before the minimap is drawn over it.
+ * A view with counters draws the floor, ceiling and walls one after the
+ * other, so each is counted on its own.
+ */
+void render_view(view_t *view)
+{
+	fill_color_buffer(&view->frame, 0xFF000000);
+	if (view->perf)
+	{
+		render_textured_walls(view, RENDER_FLOOR);
+		perf_mark(view->perf, PERF_STAGE_FLOOR);
+		render_textured_walls(view, RENDER_CEILING);
+		perf_mark(view->perf, PERF_STAGE_CEILING);
+		render_textured_walls(view, RENDER_WALLS);
+	}
+	else
+		render_textured_walls(view, RENDER_ALL);
+	if (view->interleave > 1)
+		view_history_save(view);
+	perf_mark(view->perf, PERF_STAGE_WALLS);
+	if (view->enable_minimap)
+		render_minimap(view);
+	perf_mark(view->perf, PERF_STAGE_MINIMAP);
+	view->stats.pixel_calls = view->frame.pixel_calls;
+}
@@ -0,0 +1,86 @@
+#include "../../headers/maze.h"
+
+/**
+ * view_history_free - Releases the last frame kept by a view.
+ * @history: Pointer to the view_history_t struct, which is zeroed.
+ */
+static void view_history_free(view_history_t *history)
+{
+	free(history->pixels);
+	free(history->hit_x);
+	free(history->hit_y);
+	free(history->texture);
+	free(history->was_hit_vertical);
+	free(history->source);
+	free(history->scale);
+	memset(history, 0, sizeof(*history));
+}
+
+/**
+ * view_set_interleave - Sets how many frames a view takes to refresh.
+ * @view: Pointer to the initialized view_t struct.
+ * @interleave: 1 to cast and shade every column every frame, or N, such
+ * as 2 or 4, to do so for one column in N and reproject the others.
+ *
+ * Description: Interleaving keeps a copy of the last frame, which costs
+ * a copy of the frame per frame but saves casting and shading most
+ * columns while the camera moves slowly. Fast motion, changes to the map
+ * and the edges of walls still cast every column concerned.
+ *
+ * Return: True on success, false if memory allocation failed, in which
+ * case interleaving is off.
+ */
+bool view_set_interleave(view_t *view, int interleave)
+{
+	view_history_t *history = &view->history;
+	size_t width = view->frame.width;
+
+	view_history_free(history);
+	view->interleave = 1;
+	if (interleave <= 1)
+		return (true);
+	history->pixels = malloc(sizeof(color_t) * width * view->frame.height);
+	history->hit_x = malloc(sizeof(float) * width);
+	history->hit_y = malloc(sizeof(float) * width);
+	history->texture = malloc(sizeof(int) * width);
+	history->was_hit_vertical = malloc(width);
+	history->source = malloc(sizeof(int) * width);
+	history->scale = malloc(sizeof(float) * width);
+	if (!history->pixels || !history->hit_x || !history->hit_y ||
+			!history->texture || !history->was_hit_vertical ||
+			!history->source || !history->scale)
+	{
+		view_history_free(history);
+		return (false);
+	}
+	view->interleave = interleave;
+	return (true);
+}
+
+/**
+ * view_history_save - Keeps the frame just rendered for the next one.
+ * @view: The view, whose walls are rendered but not its minimap.
+ */
+void view_history_save(view_t *view)
+{
+	view_history_t *history = &view->history;
+	const ray_buffer_t *rays = &view->rays;
+	size_t width = view->frame.width;
+	int y;
+
+	for (y = 0; y < view->frame.height; y++)
+		memcpy(history->pixels + y * width, view->frame.pixels +
+				(size_t)y * view->frame.pitch,
+				sizeof(color_t) * width);
+	memcpy(history->hit_x, rays->wall_hit_x, sizeof(float) * width);
+	memcpy(history->hit_y, rays->wall_hit_y, sizeof(float) * width);
+	memcpy(history->texture, rays->texture, sizeof(int) * width);
+	memcpy(history->was_hit_vertical, rays->was_hit_vertical, width);
+	history->x = view->player->x;
+	history->y = view->player->y;
+	history->angle = view->player->rotation_angle;
+	history->map = view->world->map;
+	history->map_version = view->world->map->version;
+	history->valid = true;
+	history->phase++;
+}
@@ -0,0 +1,107 @@
+#include "../../headers/maze.h"
+
+/**
+ * wall_span_same_face - Checks if two cast rays hit the same wall face.
+ * @rays: The rays, of a frame or of a ray cache.
+ * @first: The first ray.
+ * @last: The last ray, at a larger angle from the same position.
+ *
+ * Description: Both hits must lie on the same grid line within the same
+ * cell. The rays in between then see that face too: the triangle they
+ * sweep with the eye is narrower than a cell everywhere, so no wall can
+ * stand inside it without crossing one of the two rays. The hits also
+ * have to keep clear of the corners of the cell by WALL_SPAN_SLACK, plus
+ * the rounding a traversal gathers over that distance, so no traversal
+ * could pick the adjacent face instead.
+ *
+ * Return: True if they do, false otherwise.
+ */
+bool wall_span_same_face(const ray_buffer_t *rays, int first, int last)
+{
+	bool vertical = rays->was_hit_vertical[first];
+	const float *line = vertical ? rays->wall_hit_x : rays->wall_hit_y;
+	const float *along = vertical ? rays->wall_hit_y : rays->wall_hit_x;
+	float cell = floor(along[first] / TILE_SIZE) * TILE_SIZE;
+	float slack = WALL_SPAN_SLACK + (rays->distance[first] >
+				rays->distance[last] ? rays->distance[first] :
+				rays->distance[last]) / 1024;
+
+	return (rays->texture[first] != 0 &&
+			rays->texture[first] == rays->texture[last] &&
+			vertical == rays->was_hit_vertical[last] &&
+			line[first] == line[last] &&
+			along[first] - cell >= slack &&
+			along[last] - cell >= slack &&
+			cell + TILE_SIZE - along[first] >= slack &&
+			cell + TILE_SIZE - along[last] >= slack);
+}
+
+/**
+ * span_fill - Fills in the columns between two ends of a wall span.
+ * @view: The view, whose columns @first and @last hit the same face.
+ * @first: The first column.
+ * @last: The last column.
+ */
+static void span_fill(view_t *view, int first, int last)
+{
+	const ray_buffer_t *rays = &view->rays;
+	bool vertical = rays->was_hit_vertical[first];
+	float line = vertical ? rays->wall_hit_x[first] :
+		rays->wall_hit_y[first], ray_angle;
+	int column, texture = rays->texture[first], width = view->frame.width;
+
+	for (column = first + 1; column < last; column++)
+	{
+		ray_angle = view->player->rotation_angle + atan(
+			(column - width / 2) / view->dist_proj_plane);
+		normalize_angle(&ray_angle);
+		ray_set_hit(view, column, ray_angle, line, vertical, texture);
+	}
+	view->span_columns += last - first - 1;
+}
+
+/**
+ * cast_wall_span - Fills in the rays between two cast columns.
+ * @view: Pointer to the view_t struct owning the rays.
+ * @first: The first column, already cast.
+ * @last: The last column, already cast.
+ *
+ * Description: Neighbouring columns mostly see the same wall face. When
+ * both ends hit the same face of the same cell, the rays in between are
+ * intersected with the face directly, which gives the hits a traversal
+ * would have found; otherwise the middle column is cast and both halves
+ * are tried again.
+ */
+void cast_wall_span(view_t *view, int first, int last)
+{
+	int middle, width = view->frame.width;
+
+	if (last - first < 2)
+		return;
+	if (wall_span_same_face(&view->rays, first, last))
+	{
+		span_fill(view, first, last);
+		return;
+	}
+	middle = first + (last - first) / 2;
+	cast_ray(view->player->rotation_angle + atan((middle - width / 2) /
+				view->dist_proj_plane), middle, view);
+	cast_wall_span(view, first, middle);
+	cast_wall_span(view, middle, last);
+}
+
+/**
+ * wall_span_init - Sets up the rendering of the wall of a column.
+ * @span: Receives the setup, valid for the following columns as long as
+ * they hit the same texture on the same kind of grid line.
+ * @view: The view.
+ * @col: The column, whose ray has already been cast.
+ */
+void wall_span_init(wall_span_t *span, const view_t *view, int col)
+{
+	span->id = view->rays.texture[col];
+	span->vertical = view->rays.was_hit_vertical[col];
+	span->texture = &view->world->textures[span->id - 1];
+	span->shade = !view->world->lightmap && span->vertical ?
+		view->darken : NULL;
+}
@@ -0,0 +1,155 @@
+#include "../../headers/maze.h"
+#include <errno.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+
+/**
+ * watch_add_dir - Watches the directory of a file.
+ * @fd: The inotify descriptor.
+ * @path: The file.
+ *
+ * Description: A directory watched for several files is only added
+ * once; inotify returns the same watch descriptor for it.
+ *
+ * Return: The watch descriptor, or -1 on error.
+ */
+static int watch_add_dir(int fd, const char *path)
+{
+	const char *slash = strrchr(path, '/');
+	size_t length = slash ? (size_t)(slash - path) : 0;
+	char *dir = malloc(length + 2);
+	int wd;
+
+	if (!dir)
+		return (-1);
+	if (!slash)
+		strcpy(dir, ".");
+	else if (length == 0)
+		strcpy(dir, "/");
+	else
+	{
+		memcpy(dir, path, length);
+		dir[length] = '\0';
+	}
+	wd = inotify_add_watch(fd, dir, IN_CLOSE_WRITE | IN_MOVED_TO);
+	if (wd < 0)
+		fprintf(stderr, "Unable to watch %s\n", dir);
+	free(dir);
+	return (wd);
+}
+
+/**
+ * watch_match - Marks the files an inotify event is about.
+ * @watch: The watcher.
+ * @event: The event.
+ * @changed: The flags of the files, one per watched file.
+ *
+ * Description: When the kernel dropped events, any file may have
+ * changed, so every file is marked but the empty paths.
+ *
+ * Return: The number of files marked that were not marked yet.
+ */
+static int watch_match(const watch_t *watch,
+		const struct inotify_event *event, bool *changed)
+{
+	const char *name;
+	int i, count = 0;
+
+	for (i = 0; i < watch->count; i++)
+	{
+		name = strrchr(watch->paths[i], '/');
+		name = name ? name + 1 : watch->paths[i];
+		if (changed[i] || !*watch->paths[i] ||
+				(!(event->mask & IN_Q_OVERFLOW) &&
+				 (event->wd != watch->dirs[i] ||
+				  event->len == 0 ||
+				  strcmp(event->name, name) != 0)))
+			continue;
+		changed[i] = true;
+		count++;
+	}
+	return (count);
+}
+
+/**
+ * watch_init - Starts watching files for changes.
+ * @watch: Pointer to the watch_t struct to initialize.
+ * @paths: The files to watch; the strings must outlive @watch. They do
+ * not need to exist yet, and an empty one names no file and never
+ * changes.
+ * @count: The number of files, at most WATCH_MAX_FILES.
+ *
+ * Return: True on success, false if inotify is not available or a
+ * directory cannot be watched.
+ */
+bool watch_init(watch_t *watch, const char * const *paths, int count)
+{
+	int i;
+
+	watch->count = 0;
+	watch->fd = count > WATCH_MAX_FILES ? -1 :
+		inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (watch->fd < 0)
+		return (false);
+	for (i = 0; i < count; i++)
+	{
+		watch->paths[i] = paths[i];
+		watch->dirs[i] = *paths[i] ? watch_add_dir(watch->fd,
+				paths[i]) : -1;
+		if (watch->dirs[i] < 0 && *paths[i])
+		{
+			watch_close(watch);
+			return (false);
+		}
+	}
+	watch->count = count;
+	return (true);
+}
+
+/**
+ * watch_poll - Collects the files changed since the last poll.
+ * @watch: The watcher.
+ * @changed: Receives one flag per watched file, in the order they were
+ * given to watch_init().
+ *
+ * Description: This never blocks. A file counts as changed once it was
+ * closed after writing or renamed into place, so a save in progress is
+ * not picked up half written.
+ *
+ * Return: The number of files that changed, or -1 on error.
+ */
+int watch_poll(watch_t *watch, bool *changed)
+{
+	uint64_t buffer[512];
+	const char *bytes = (const char *)buffer;
+	const struct inotify_event *event;
+	ssize_t size, offset;
+	int i, count = 0;
+
+	for (i = 0; i < watch->count; i++)
+		changed[i] = false;
+	if (watch->fd < 0)
+		return (0);
+	while ((size = read(watch->fd, buffer, sizeof(buffer))) > 0)
+		for (offset = 0; offset < size; offset += sizeof(*event) +
+				event->len)
+		{
+			event = (const struct inotify_event *)(bytes + offset);
+			count += watch_match(watch, event, changed);
+		}
+	if (size < 0 && errno != EAGAIN && errno != EWOULDBLOCK)
+		return (-1);
+	return (count);
+}
+
+/**
+ * watch_close - Stops watching files.
+ * @watch: Pointer to the watch_t struct to release.
+ */
+void watch_close(watch_t *watch)
+{
+	if (watch->fd >= 0)
+		close(watch->fd);
+	watch->fd = -1;
+	watch->count = 0;
+}
@@ -0,0 +1,120 @@
+#include "../headers/headers.h"
+
+/**
+ * input_event - Applies an event and notes when it arrived.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @event: The event.
+ *
+ * Description: A key press or release is stamped with the time SDL
+ * queued it, on the performance counter, so its latency can be measured
+ * once a frame shows it. Key repeats change nothing and are not stamped.
+ */
+static void input_event(game_resources_t *resources, SDL_Event *event)
+{
+	Uint32 age;
+
+	if ((event->type == SDL_KEYDOWN && !event->key.repeat) ||
+			event->type == SDL_KEYUP)
+	{
+		age = SDL_GetTicks() - event->common.timestamp;
+		if (resources->num_inputs < INPUT_MAX_EVENTS)
+			resources->input_times[resources->num_inputs++] =
+				SDL_GetPerformanceCounter() - (Uint64)age *
+				SDL_GetPerformanceFrequency() / 1000;
+	}
+	switch (event->type)
+	{
+	case SDL_QUIT:
+		resources->context.game_is_running = false;
+		break;
+	case SDL_KEYDOWN:
+		handle_sdl_keydown(resources, event);
+		break;
+	case SDL_KEYUP:
+		handle_sdl_keyup(resources, event);
+		break;
+	}
+}
+
+/**
+ * input_wait - Waits for the next frame while taking events in.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @milliseconds: How long to wait.
+ *
+ * Description: Replaces a plain sleep, so events are stamped as they
+ * arrive rather than when the wait ends. Their keys are applied right
+ * away, but the player only moves once the wait is over.
+ */
+void input_wait(game_resources_t *resources, int milliseconds)
+{
+	Uint32 deadline = SDL_GetTicks() + milliseconds;
+	SDL_Event event;
+	int left;
+
+	while ((left = (int)(deadline - SDL_GetTicks())) > 0)
+		if (SDL_WaitEventTimeout(&event, left))
+			input_event(resources, &event);
+}
+
+/**
+ * handle_keyboard_input - Handles keyboard input for the game.
+ *
+ * @resource: Pointer to the game_resource_t struct representing
+ * the game resource.
+ *
+ * Description: Called as late as possible, right before the player
+ * moves and the rays are cast, so the frame shows the keys held then.
+ */
+void handle_keyboard_input(game_resources_t *resource)
+{
+	SDL_Event event;
+
+	/*
+	 * Loop through all pending events in the event queue.
+	 * Until it becomes empty. This is useful senarios
+	 * where multiple events are generated at the same time.
+	 */
+	while (SDL_PollEvent(&event))
+		input_event(resource, &event);
+
+	/*
+	 * Ensure that the player doesn't move when conflicting key are pressed
+	 * simultaneously. Hence, the walk_direction and turn_direction limits
+	 * are set to -1, 0, or 1.
+	 */
+	if (resource->player.walk_direction > 1)
+		resource->player.walk_direction = 1;
+	if (resource->player.walk_direction < -1)
+		resource->player.walk_direction = -1;
+	if (resource->player.turn_direction > 1)
+		resource->player.turn_direction = 1;
+	if (resource->player.turn_direction < -1)
+		resource->player.turn_direction = -1;
+}
+
+/**
+ * input_presented - Measures the latency of the events a frame shows.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @stats: The counters of the frame, which receive the latencies.
+ *
+ * Description: Called once SDL_RenderPresent() returned. Every event
+ * stamped since the last frame was applied before its rays were cast,
+ * so this frame is the first to show it.
+ */
+void input_presented(game_resources_t *resources, frame_stats_t *stats)
+{
+	Uint64 now = SDL_GetPerformanceCounter();
+	Uint64 frequency = SDL_GetPerformanceFrequency();
+	uint64_t us;
+	int i;
+
+	stats->input_events = resources->num_inputs;
+	stats->input_latency_us = 0;
+	for (i = 0; i < resources->num_inputs; i++)
+	{
+		us = (now - resources->input_times[i]) * 1000000 / frequency;
+		latency_record(&resources->latency, us);
+		stats->input_latency_us += us;
+	}
+	resources->num_inputs = 0;
+}
@@ -13,6 +13,14 @@ void handle_sdl_keydown(game_resources_t *resources, SDL_Event *event)
 	/* Generated when a key is pressed*/
 	if (event->key.keysym.sym == SDLK_ESCAPE)
 		resources->context.game_is_running = false;
+	/* Shows or hides the frame counters */
+	if (event->key.keysym.sym == SDLK_F3)
+		resources->show_stats = !resources->show_stats;
+	/* Cycles interleaved rendering through 1, 2 and 4 frames per column */
+	if (event->key.keysym.sym == SDLK_i)
+		view_set_interleave(&resources->view,
+				resources->view.interleave >= 4 ? 1 :
+				resources->view.interleave * 2);
 
 	/* Check for opposite keys pressed simultaneously */
 	if (((event->key.keysym.sym == SDLK_UP || event->key.keysym.sym == SDLK_w)
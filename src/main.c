@@ -5,72 +5,54 @@
  *
  * @resources: Pointer to the game_resources_t struct representing
  * the game resources.
- */
-void setup(game_resources_t *resources)
-{
-	resources->player.x = WINDOW_WIDTH / 2;
-	resources->player.y = WINDOW_HEIGHT / 2;
-	resources->player.width = 1;
-	resources->player.height = 30;
-	resources->player.turn_direction = 0;
-	resources->player.walk_direction = 0;
-	resources->player.rotation_angle = PI / 2;
-	resources->player.walk_speed = 100;
-	resources->player.turn_speed = 45 * (PI / 180);
-	load_textures(resources);
-}
-
-/**
- * handle_keyboard_input - Handles keyboard input for the game.
+ * @argc: The number of command-line arguments.
+ * @argv: The map file, whose lights are loaded, then optionally a file
+ * to record the frames to, --connect and the host:port of a server, or
+ * --stream and the address of a receiver to mirror the frames to.
  *
- * @resource: Pointer to the game_resource_t struct representing
- * the game resource.
+ * Description: The player starts at the center of the map, or in the
+ * nearest open cell if the center is a wall.
  */
-void handle_keyboard_input(game_resources_t *resource)
+void setup(game_resources_t *resources, int argc, char *argv[])
 {
-	SDL_Event event;
-
-	/*
-	 * Loop through all pending events in the event queue.
-	 * Until it becomes empty. This is useful senarios
-	 * where multiple events are generated at the same time.
-	 */
-	while (SDL_PollEvent(&event))
-	{
-		switch (event.type)
-		{
-		case SDL_QUIT:
-			resource->context.game_is_running = false;
-			break;
-		case SDL_KEYDOWN:
-			handle_sdl_keydown(resource, &event);
-			break;
-		case SDL_KEYUP:
-			handle_sdl_keyup(resource, &event);
-			break;
-		}
-	}
-
-	/*
-	 * Ensure that the player doesn't move when conflicting key are pressed
-	 * simultaneously. Hence, the walk_direction and turn_direction limits
-	 * are set to -1, 0, or 1.
-	 */
-	if (resource->player.walk_direction > 1)
-		resource->player.walk_direction = 1;
-	if (resource->player.walk_direction < -1)
-		resource->player.walk_direction = -1;
-	if (resource->player.turn_direction > 1)
-		resource->player.turn_direction = 1;
-	if (resource->player.turn_direction < -1)
-		resource->player.turn_direction = -1;
+	const map_t *map = resources->world.map;
+	float x = map->cols * TILE_SIZE / 2, y = map->rows * TILE_SIZE / 2;
+
+	map_find_open_cell(&x, &y, map);
+	player_init(&resources->player, x, y);
+	if (!load_textures(resources))
+		resources->context.game_is_running = false;
+	resources->world.textures = resources->textures.textures;
+	if (!reload_init(resources, argv[1]) || !load_lighting(resources))
+		resources->context.game_is_running = false;
+	if (!view_init(&resources->view, &resources->world, &resources->player,
+			resources->color_buffer, WINDOW_WIDTH, WINDOW_HEIGHT))
+		resources->context.game_is_running = false;
+	if (argc == 3 && !capture_start(&resources->capture, argv[2],
+				WINDOW_WIDTH, WINDOW_HEIGHT, FPS))
+		resources->context.game_is_running = false;
+	if (argc == 4 && strcmp(argv[2], "--connect") == 0 &&
+			!network_connect(resources, argv[3]))
+		resources->context.game_is_running = false;
+	if (argc == 4 && strcmp(argv[2], "--stream") == 0 &&
+			!stream_start(&resources->stream, argv[3], WINDOW_WIDTH,
+				WINDOW_HEIGHT))
+		resources->context.game_is_running = false;
+	game_stats_init(resources);
 }
+
 /**
  * update - Updates the game state and performs necessary operations.
  *
  * @resources: Pointer to the game_resource_t struct representing the
  * game resource.
  * @map: An instance of the map_t struct representing map data.
+ *
+ * Description: The keys are read after the wait and the reload, right
+ * before the player moves and the rays are cast, so the frame shows the
+ * freshest input. Events arriving during the wait are stamped as they
+ * come, to measure how long they take to reach the screen. Each stage
+ * is marked on the performance counters, when they run.
  */
 void update(game_resources_t *resources, map_t *map)
 {
@@ -83,12 +65,11 @@ void update(game_resources_t *resources, map_t *map)
 
 	/*
 	 * If the remaining time is positive and within the target frame time,
-	 * delay the execution to maintain the desired frame rate.
+	 * wait for it, taking events in, to maintain the desired frame rate.
 	 */
 	if (time_to_wait > 0 && time_to_wait <= FRAME_TARGET_TIME)
-	{
-		SDL_Delay(time_to_wait);
-	}
+		input_wait(resources, time_to_wait);
+	resources->late = time_to_wait < 0; /* The last frame overran */
 	/*
 	 * Compute the delta time to be used as an update factor/
 	 * when changing game objects.
@@ -98,34 +79,54 @@ void update(game_resources_t *resources, map_t *map)
 	/* Update the last frame time to the current time */
 	resources->context.last_frame_time = SDL_GetTicks();
 
-	/* Perform player movement based on the delta time */
-	move_player(delta_time, &(resources->player), map);
+	/* Apply the map, lights and textures edited on disk */
+	reload_poll(resources, map);
+
+	/* Latch the keys as late as possible */
+	handle_keyboard_input(resources);
+	perf_mark(&resources->perf, PERF_STAGE_INPUT);
+
+	/* Perform player movement based on the delta time, or on a server */
+	if (resources->online)
+		network_update(resources);
+	else
+		move_player(delta_time, &(resources->player), map);
+	perf_mark(&resources->perf, PERF_STAGE_MOVE);
 
 	/* Cast rays for raycasting in the game */
-	cast_all_rays(&(resources->player), map);
+	cast_all_rays(&(resources->view));
+	perf_mark(&resources->perf, PERF_STAGE_CAST);
 }
 /**
  * render - Renders the game scene and displays it on the screen.
  * @resources: Pointer to the game_resources_t struct representing the
  * game resources.
- * @map: An instance of the map_t struct representing map data.
+ *
+ * Description: The textures the frame hit are loaded or kept for the
+ * next frames once it is drawn. The counters are drawn after the frame
+ * is recorded and streamed, so recordings and mirrors stay clean, and
+ * show the frame before this one.
  */
-void render(game_resources_t *resources, map_t *map)
+void render(game_resources_t *resources)
 {
-	fill_color_buffer(resources, 0xFF000000);
-	render_textured_walls(resources);
-	if (resources->enable_minimap)
-	{
-		render_map_tiles(resources, map);
-		render_minimap_rays(resources);
-		render_player_on_minimap(resources);
-	}
-	render_color_buffer(resources);
+	resources->view.enable_minimap = resources->enable_minimap;
+	render_view(&resources->view);
+	texture_pool_update(&resources->textures, &resources->view, 1);
+	capture_frame(&resources->capture, resources->color_buffer,
+			WINDOW_WIDTH);
+	stream_frame(&resources->stream, resources->color_buffer,
+			WINDOW_WIDTH);
+	if (resources->show_stats)
+		stats_hud_draw(&resources->view.frame, &resources->stats,
+				&resources->stats_total);
+	game_stats_update(resources, render_color_buffer(resources));
 }
 /**
  * main - The entry point of the game program.
  * @argc: The number of command-line arguments passed to the program.
- * @argv: An array of strings containing the command-line arguments.
+ * @argv: The map file, then optionally a file to record the frames to,
+ * --connect and the address of a server to play on, or --stream and the
+ * address of a receiver to mirror the frames to.
  *
  * Return: 0 on successful execution.
  *
@@ -136,44 +137,44 @@ void render(game_resources_t *resources, map_t *map)
  */
 int main(int argc, char *argv[])
 {
-	game_resources_t resources;
+	game_resources_t *resources;
 	map_t *map;
-	const char *map_file_path;
-
-	/* Initialize SDL_image */
-	IMG_Init(IMG_INIT_PNG);
 
-	if (argc != 2)
+	if (argc < 2 || argc > 4 || (argc > 3 && strcmp(argv[2], "--connect")
+				&& strcmp(argv[2], "--stream")))
 	{
-		fprintf(stderr, "Usage: ./run-game <map_file_path>\n");
+		fprintf(stderr, "Usage: ./run-game <map_file_path> [capture_file"
+			" | --connect host:port | --stream host:port|unix:path]\n");
 		return (EXIT_FAILURE);
 	}
-	map_file_path = argv[1];
-	map = malloc(sizeof(map_t));
-	parse_map_from_file(map_file_path, map);
-
-	resources.enable_minimap = false;
+	map = calloc(1, sizeof(map_t));
+	resources = calloc(1, sizeof(game_resources_t));
+	if (!map || !resources || !parse_map_from_file(argv[1], map))
+	{
+		if (!map || !resources)
+			fprintf(stderr, "Unable to allocate memory for the game\n");
+		free(map);
+		free(resources);
+		return (EXIT_FAILURE);
+	}
+	resources->enable_minimap = false;
+	resources->world.map = map;
 
 	/* Initialize the game window and check if it was successful */
-	resources.context.game_is_running = initialize_window(&resources);
+	resources->context.game_is_running = initialize_window(resources);
 
 	/* Set up the game context */
-	setup(&resources);
+	setup(resources, argc, argv);
 
 	/* Main game loop */
-	while (resources.context.game_is_running)
+	while (resources->context.game_is_running)
 	{
-		/* Handle keyboard input */
-		handle_keyboard_input(&resources);
-
-		/* Update the game state */
-		update(&resources, map);
-
-		/* Render the game scene */
-		render(&resources, map);
+		update(resources, map); /* Read the keys and update the game */
+		render(resources); /* Render the game scene */
 	}
+	destroy_window(resources);  /* Destroy the game window */
+	map_free(map);
 	free(map);
-	destroy_window(&resources);  /* Destroy the game window */
-
+	free(resources);
 	return (EXIT_SUCCESS);
 }
@@ -0,0 +1,74 @@
+#include "../headers/headers.h"
+
+/**
+ * network_connect - Joins a server instead of playing alone.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @address: The server, as host:port with an IPv4 host.
+ *
+ * Description: The server runs at NET_TICK_RATE ticks per second and
+ * decides where the player is; the game sends it the keys held and
+ * draws the player where the snapshots put it.
+ *
+ * Return: True on success, false if @address is malformed or no
+ * socket can be opened.
+ */
+bool network_connect(game_resources_t *resources, const char *address)
+{
+	char host[64];
+	const char *colon = strrchr(address, ':');
+
+	if (!colon || colon == address || colon - address >= (long)sizeof(host))
+	{
+		fprintf(stderr, "Invalid server address: %s\n", address);
+		return (false);
+	}
+	memcpy(host, address, colon - address);
+	host[colon - address] = '\0';
+	if (!net_client_init(&resources->net, host, atoi(colon + 1),
+				NET_TICK_RATE))
+	{
+		fprintf(stderr, "Unable to connect to %s\n", address);
+		net_client_free(&resources->net);
+		return (false);
+	}
+	resources->online = true;
+	return (true);
+}
+
+/**
+ * network_update - Exchanges the input and the snapshots with the server.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ *
+ * Description: Takes the place of move_player() when online. The player
+ * is drawn interpolated between the last snapshots, NET_INTERP_TICKS
+ * ticks behind the server; it stays put until the first one arrives.
+ */
+void network_update(game_resources_t *resources)
+{
+	double now = SDL_GetTicks() / 1000.0;
+	env_action_t action;
+
+	action.walk_direction = resources->player.walk_direction;
+	action.turn_direction = resources->player.turn_direction;
+	net_client_send(&resources->net, &action, now);
+	if (net_client_poll(&resources->net, now) < 0)
+	{
+		fprintf(stderr, "The server stopped\n");
+		resources->context.game_is_running = false;
+		return;
+	}
+	net_client_interpolate(&resources->net, resources->net.slot, now,
+			&resources->player);
+}
+
+/**
+ * network_close - Leaves the server, if the game joined one.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ */
+void network_close(game_resources_t *resources)
+{
+	if (!resources->online)
+		return;
+	net_client_free(&resources->net);
+	resources->online = false;
+}
@@ -0,0 +1,129 @@
+#include "../headers/headers.h"
+
+/**
+ * reload_init - Starts watching the files the game is loaded from.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @map_path: The file the map was read from.
+ *
+ * Description: The map, its lights and the texture images are watched,
+ * so edits show up in the running game. Without inotify the game runs
+ * as usual, only without reloading.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+bool reload_init(game_resources_t *resources, const char *map_path)
+{
+	const char *paths[2 + TEXTURE_MAX_IDS];
+	int i;
+
+	resources->map_path = map_path;
+	resources->lights_path = malloc(strlen(map_path) + sizeof(".lights"));
+	if (!resources->lights_path)
+		return (false);
+	sprintf(resources->lights_path, "%s.lights", map_path);
+	paths[0] = map_path;
+	paths[1] = resources->lights_path;
+	for (i = 0; i < resources->num_textures; i++)
+		paths[2 + i] = resources->texture_names[i];
+	if (!watch_init(&resources->watch, paths, 2 + resources->num_textures))
+		fprintf(stderr, "Unable to watch the map and the textures\n");
+	return (true);
+}
+
+/**
+ * load_lighting - Bakes the lighting of the map of the game.
+ * @resources: Pointer to the game_resources_t struct whose map is loaded
+ * and whose lights path is set.
+ *
+ * Description: The point lights are read from the file named after the
+ * map with a ".lights" suffix, if it exists; without it the map is only
+ * lit by the ambient light. The lighting in use is only replaced once
+ * the new one is baked.
+ *
+ * Return: True on success, false if the lights file is malformed or
+ * memory allocation failed.
+ */
+bool load_lighting(game_resources_t *resources)
+{
+	light_t lights[LIGHT_MAX_SOURCES];
+	lightmap_t lightmap;
+	int count;
+
+	count = lightmap_load_lights(resources->lights_path, lights,
+			LIGHT_MAX_SOURCES);
+	if (count < 0 || !lightmap_build(&lightmap, resources->world.map,
+				lights, count, LIGHT_AMBIENT))
+		return (false);
+	lightmap_free(&resources->lightmap);
+	resources->lightmap = lightmap;
+	resources->world.lightmap = &resources->lightmap;
+	return (true);
+}
+
+/**
+ * reload_map - Applies a map reload once it is read.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @map: The map in use.
+ *
+ * Description: Only the lighting around the edited cells is rebaked; a
+ * map of another size is lit again whole. A player walled in by the
+ * edit moves to the nearest open cell.
+ */
+static void reload_map(game_resources_t *resources, map_t *map)
+{
+	map_reload_t *reload = &resources->map_reload;
+
+	if (!map_reload_poll(reload, map))
+		return;
+	if (reload->count < 0 || !lightmap_update(&resources->lightmap, map,
+				reload->changed, reload->count))
+		load_lighting(resources);
+	map_find_open_cell(&resources->player.x, &resources->player.y, map);
+}
+
+/**
+ * reload_poll - Applies the files changed since the last frame.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @map: The map in use.
+ *
+ * Description: Called between two frames, so nothing is rendering while
+ * the game data changes. The map is read and compared on a background
+ * thread and applied on a later frame, and a map saved again meanwhile
+ * is read once that reload is applied. An edited image decodes only its
+ * own texture, when a frame next shows it; the texture cache notices it
+ * on the next launch.
+ */
+void reload_poll(game_resources_t *resources, map_t *map)
+{
+	bool changed[2 + TEXTURE_MAX_IDS];
+	int i;
+
+	if (watch_poll(&resources->watch, changed) > 0)
+	{
+		resources->map_stale = resources->map_stale || changed[0];
+		if (changed[1])
+			load_lighting(resources);
+		for (i = 0; i < resources->num_textures; i++)
+			if (changed[2 + i])
+				reload_texture(resources, i);
+	}
+	if (resources->map_stale && map_reload_start(&resources->map_reload,
+				resources->map_path, map))
+		resources->map_stale = false;
+	reload_map(resources, map);
+}
+
+/**
+ * reload_free - Stops watching files and releases the reload state.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ *
+ * Description: A map reload still running is waited for, so this must
+ * be called before the map is freed.
+ */
+void reload_free(game_resources_t *resources)
+{
+	map_reload_free(&resources->map_reload);
+	watch_close(&resources->watch);
+	free(resources->lights_path);
+	resources->lights_path = NULL;
+}
@@ -0,0 +1,87 @@
+#include "../headers/headers.h"
+#include <unistd.h>
+
+/**
+ * game_stats_init - Starts publishing the counters of the game.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ *
+ * Description: The segment is named after the process, so several games
+ * can run side by side; `maze-stats <pid>` reads it. Without shared
+ * memory the game runs as usual, only without publishing. Setting
+ * MAZE_PERF also counts each stage of a frame on the performance
+ * counters, reported on exit; any other value than 1 names a CSV file
+ * the counts of every frame are written to. Without counters the game
+ * says why and runs as usual.
+ */
+void game_stats_init(game_resources_t *resources)
+{
+	const char *perf = getenv("MAZE_PERF");
+	char name[32];
+
+	sprintf(name, "/maze-stats.%d", (int)getpid());
+	if (stats_export_open(&resources->stats_export, name))
+		printf("Publishing the frame counters to %s\n", name);
+	else
+		fprintf(stderr, "Unable to publish the frame counters\n");
+	if (!perf || !*perf)
+		return;
+	if (!perf_init(&resources->perf))
+	{
+		perf_report(&resources->perf, stderr);
+		return;
+	}
+	resources->view.perf = &resources->perf;
+	if (strcmp(perf, "1") != 0 && !(resources->perf_log =
+				fopen(perf, "w")))
+		perror(perf);
+}
+
+/**
+ * game_stats_update - Sums the counters of a frame once it is shown.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ * @uploaded: The number of bytes of the frame sent to the screen.
+ *
+ * Description: Called right after the frame is presented. The counters
+ * the view kept while rendering are joined by those of the game and of
+ * the frame stream, added to the totals and published. This ends the
+ * frame of the performance counters too.
+ */
+void game_stats_update(game_resources_t *resources, size_t uploaded)
+{
+	frame_stats_t *stats = &resources->stats;
+	const frame_stats_t *total = &resources->stats_total;
+	uint64_t bytes, encode_ns;
+
+	perf_mark(&resources->perf, PERF_STAGE_PRESENT);
+	perf_frame_end(&resources->perf, resources->perf_log);
+	*stats = resources->view.stats;
+	stats->uploaded_bytes = uploaded;
+	stats->late_frames = resources->late;
+	stats->dropped_frames = resources->capture.dropped +
+		resources->stream.dropped - total->dropped_frames;
+	stream_totals(&resources->stream, &bytes, &encode_ns);
+	stats->stream_bytes = bytes - total->stream_bytes;
+	stats->stream_encode_us = encode_ns / 1000 - total->stream_encode_us;
+	input_presented(resources, stats);
+	frame_stats_add(&resources->stats_total, stats);
+	stats_export_publish(&resources->stats_export, stats);
+}
+
+/**
+ * game_stats_close - Reports the input latency and the performance
+ * counters, and stops publishing.
+ * @resources: Pointer to the game_resources_t struct of the game.
+ */
+void game_stats_close(game_resources_t *resources)
+{
+	latency_report(&resources->latency, "Input to present latency",
+			stdout);
+	if (resources->perf.active)
+	{
+		perf_close(&resources->perf);
+		perf_report(&resources->perf, stdout);
+	}
+	if (resources->perf_log)
+		fclose(resources->perf_log);
+	stats_export_close(&resources->stats_export);
+}
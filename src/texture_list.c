@@ -0,0 +1,119 @@
+#include "../headers/headers.h"
+
+/**
+ * texture_list_read - Reads the images listed by TEXTURE_LIST_PATH.
+ * @inst: Pointer to the game_resources_t struct receiving the names.
+ * @file: The open list.
+ *
+ * Description: Each line names the image of one texture ID, from 1 on,
+ * relative to the directory the game runs from. An empty line leaves a
+ * gap that draws as the placeholder.
+ *
+ * Return: True on success, false if the list names more than
+ * TEXTURE_MAX_IDS images or cannot be read.
+ */
+static bool texture_list_read(game_resources_t *inst, FILE *file)
+{
+	char *line, *end;
+	long size;
+
+	if (fseek(file, 0, SEEK_END) != 0 || (size = ftell(file)) < 0 ||
+			fseek(file, 0, SEEK_SET) != 0)
+		return (false);
+	inst->texture_list = malloc(size + 1);
+	if (!inst->texture_list || fread(inst->texture_list, 1, size,
+				file) != (size_t)size)
+		return (false);
+	inst->texture_list[size] = '\0';
+	for (line = inst->texture_list; *line; line = end + 1)
+	{
+		if (inst->num_textures == TEXTURE_MAX_IDS)
+			return (false);
+		inst->texture_names[inst->num_textures++] = line;
+		end = line + strcspn(line, "\n");
+		if (end > line && end[-1] == '\r')
+			end[-1] = '\0';
+		if (*end == '\0')
+			break;
+		*end = '\0';
+	}
+	return (true);
+}
+
+/**
+ * texture_list_load - Lists the image of each texture index.
+ * @inst: Pointer to the game_resources_t struct receiving the names.
+ *
+ * Description: Maps name their textures by ID, so a content pack lists
+ * one image per ID in TEXTURE_LIST_PATH; without it, the game uses the
+ * built-in texture_file_names.
+ *
+ * Return: True on success, false if the list is malformed or memory
+ * allocation failed.
+ */
+bool texture_list_load(game_resources_t *inst)
+{
+	FILE *file;
+	bool valid;
+
+	inst->num_textures = 0;
+	inst->texture_list = NULL;
+	inst->texture_names = malloc(sizeof(char *) * TEXTURE_MAX_IDS);
+	if (!inst->texture_names)
+		return (false);
+	file = fopen(TEXTURE_LIST_PATH, "r");
+	if (!file)
+	{
+		for (; inst->num_textures < NUM_TEXTURES; inst->num_textures++)
+			inst->texture_names[inst->num_textures] =
+				texture_file_names[inst->num_textures];
+		return (true);
+	}
+	valid = texture_list_read(inst, file);
+	fclose(file);
+	if (!valid)
+		fprintf(stderr, "Invalid texture list %s\n", TEXTURE_LIST_PATH);
+	return (valid);
+}
+
+/**
+ * texture_budget - Reads the memory budget of the textures.
+ *
+ * Description: MAZE_TEXTURE_BUDGET sets it in bytes, or with a K, M or
+ * G suffix, for devices with less memory than a content pack needs.
+ *
+ * Return: The budget, TEXTURE_BUDGET bytes by default.
+ */
+size_t texture_budget(void)
+{
+	const char *value = getenv("MAZE_TEXTURE_BUDGET");
+	unsigned long budget;
+	char *end;
+
+	if (!value || !*value)
+		return (TEXTURE_BUDGET);
+	budget = strtoul(value, &end, 10);
+	if (*end == 'K' || *end == 'k')
+		budget <<= 10;
+	else if (*end == 'M' || *end == 'm')
+		budget <<= 20;
+	else if (*end == 'G' || *end == 'g')
+		budget <<= 30;
+	return (budget);
+}
+
+/**
+ * reload_texture - Reads a texture again once its image changed.
+ * @inst: Pointer to the game_resources_t struct that holds the texture data.
+ * @index: The index of the texture in texture_names.
+ *
+ * Description: Nothing waits for the loader: the texture pool counts
+ * a new generation of the texture, which load_texture() decodes from the
+ * image rather than copy from the out of date cache, the next time a
+ * frame shows it. The old texture stays on screen until then, and if
+ * the image fails to load.
+ */
+void reload_texture(game_resources_t *inst, int index)
+{
+	texture_pool_invalidate(&inst->textures, index);
+}
@@ -1,6 +1,6 @@
 #include "../headers/headers.h"
 
-static const char *texture_file_names[NUM_TEXTURES] = {
+const char * const texture_file_names[NUM_TEXTURES] = {
 	"./images/redbrick.png",
 	"./images/mossystone.png",
 	"./images/graystone.png",
@@ -15,9 +15,10 @@ static const char *texture_file_names[NUM_TEXTURES] = {
  * RGBA pixel values.
  *
  * Description: This function converts the @surface to the RGBA32 format,
- * locks the surface, and copies the RGBA pixel values into the @rgba_buffer.
- * The @rgba_buffer should be preallocated with enough memory to store the
- * pixel values. The surface is then unlocked and freed.
+ * unless it already is, locks the surface, and copies the RGBA pixel values
+ * into the @rgba_buffer. The @rgba_buffer should be preallocated with enough
+ * memory to store the pixel values. The converted surface is then unlocked
+ * and freed.
  *
  */
 void get_texture_rgba_values(SDL_Surface *surface, color_t *rgba_buffer)
@@ -26,8 +27,8 @@ void get_texture_rgba_values(SDL_Surface *surface, color_t *rgba_buffer)
 	int num_pixels;
 	SDL_Surface *converted_surface;
 
-	converted_surface = SDL_ConvertSurfaceFormat(
-			surface, SDL_PIXELFORMAT_RGBA32, 0);
+	converted_surface = surface->format->format == SDL_PIXELFORMAT_RGBA32 ?
+		surface : SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
 	if (converted_surface != NULL)
 	{
 		SDL_LockSurface(converted_surface);
@@ -37,7 +38,8 @@ void get_texture_rgba_values(SDL_Surface *surface, color_t *rgba_buffer)
 		memcpy(rgba_buffer, pixels, num_pixels * sizeof(color_t));
 
 		SDL_UnlockSurface(converted_surface);
-		SDL_FreeSurface(converted_surface);
+		if (converted_surface != surface)
+			SDL_FreeSurface(converted_surface);
 	}
 	else
 	{
@@ -47,87 +49,121 @@ void get_texture_rgba_values(SDL_Surface *surface, color_t *rgba_buffer)
 }
 
 /**
- * load_textures - Loads textures from image files and retrieves
- * RGBA pixel values.
- * @inst: Pointer to the game_resources_t struct that holds the texture data.
+ * decode_texture - Decodes the image of a texture.
+ * @context: Pointer to the game_resources_t struct naming the images.
+ * @index: The texture index.
+ * @texture: Receives the texture, in a malloc'ed buffer.
  *
- * Description: This function loads textures from image files specified in the
- * texture_file_names array. It converts the loaded surfaces to the RGBA32
- * format, creates SDL textures from the surfaces, and retrieves RGBA pixel
- * values into the texture_buffer field of the wall_textures array in the
- * game_resources_t struct.
+ * Description: The image is converted to RGBA32. This runs on the
+ * texture loader thread, or once per image when the cache is rebuilt.
  *
+ * Return: True on success, false if the image cannot be decoded.
  */
-void load_textures(game_resources_t *inst)
+static bool decode_texture(void *context, int index, texture_t *texture)
 {
-	color_t num_pixels;
-	SDL_Surface *converted_surface, *image_surface;
-	SDL_Renderer *renderer;
-	int i;
+	game_resources_t *inst = context;
+	SDL_Surface *image_surface = IMG_Load(inst->texture_names[index]);
 
-	for (i = 0; i < NUM_TEXTURES; i++)
+	texture->texture_buffer = NULL;
+	if (image_surface == NULL)
 	{
-		image_surface = IMG_Load(texture_file_names[i]);
-		if (image_surface != NULL)
-		{
-			inst->wall_textures[i].width = image_surface->w;
-			inst->wall_textures[i].height = image_surface->h;
-			/* Convert surface to RGBA32 format */
-			converted_surface = SDL_ConvertSurfaceFormat(image_surface,
-					SDL_PIXELFORMAT_RGBA32, 0);
-			SDL_FreeSurface(image_surface);
-			image_surface = converted_surface;
-			renderer = inst->renderer;
-			inst->wall_textures[i].sdl_texture =
-				SDL_CreateTextureFromSurface(renderer, image_surface);
-			/* Convert pixel data to RGBA32 format */
-			num_pixels = image_surface->w * image_surface->h;
-			inst->wall_textures[i].texture_buffer = (color_t *)malloc(
-					num_pixels * sizeof(color_t));
-			if (inst->wall_textures[i].texture_buffer != NULL)
-			{
-				get_texture_rgba_values(
-						image_surface, inst->wall_textures[i].texture_buffer);
-			}
-			else
-				fprintf(stderr, "Error allocating memory for texture buffer\n");
-			SDL_FreeSurface(image_surface);
-		}
-		else
-		{
-			fprintf(stderr, "Error loading texture %s: %s\n",
-					texture_file_names[i], IMG_GetError());
-		}
+		fprintf(stderr, "Error loading texture %s: %s\n",
+				inst->texture_names[index], IMG_GetError());
+		return (false);
 	}
+	texture->width = image_surface->w;
+	texture->height = image_surface->h;
+	texture->texture_buffer = malloc(sizeof(color_t) * texture->width *
+			texture->height);
+	if (texture->texture_buffer != NULL)
+		get_texture_rgba_values(image_surface, texture->texture_buffer);
+	else
+		fprintf(stderr, "Error allocating memory for texture buffer\n");
+	SDL_FreeSurface(image_surface);
+	return (texture->texture_buffer != NULL);
 }
+
 /**
- * free_textures - Frees the textures and texture buffers in the
- * game_resources_t struct.
- * @inst: Pointer to the game_resources_t struct containing the texture data.
+ * load_texture - Loads a texture for the texture pool.
+ * @context: Pointer to the game_resources_t struct of the game.
+ * @index: The texture index.
+ * @generation: How many times the image was reloaded since launch.
+ * @texture: Receives the texture.
+ * @borrowed: Set when @texture points into the texture cache.
  *
- * Description: This function frees the SDL textures and texture buffers in
- * the wall_textures array of the game_resources_t struct. It iterates through
- * each texture, destroys the SDL texture using SDL_DestroyTexture, and frees
- * the texture buffer using free. It also sets the corresponding pointers to
- * NULL to indicate that the resources have been freed.
+ * Description: The pool reads the pixels straight from the mapped
+ * texture cache when it holds them and the image was never reloaded.
+ * Otherwise the image is decoded into a malloc'ed buffer, as the cache
+ * only notices edits on the next launch. A gap in the texture list
+ * loads nothing, so it keeps showing the placeholder.
  *
+ * Return: True on success, false otherwise.
  */
-void free_textures(game_resources_t *inst)
+static bool load_texture(void *context, int index, unsigned int generation,
+		texture_t *texture, bool *borrowed)
 {
-	int i;
+	game_resources_t *inst = context;
+	const texture_t *cached = &inst->cached_textures[index];
 
-	for (i = 0; i < NUM_TEXTURES; i++)
-	{
-		if (inst->wall_textures[i].sdl_texture != NULL)
-		{
-			SDL_DestroyTexture(inst->wall_textures[i].sdl_texture);
-			inst->wall_textures[i].sdl_texture = NULL;
-		}
+	if (!*inst->texture_names[index])
+		return (false);
+	if (generation > 0 || cached->texture_buffer == NULL)
+		return (decode_texture(context, index, texture));
+	*texture = *cached;
+	*borrowed = true;
+	return (true);
+}
 
-		if (inst->wall_textures[i].texture_buffer != NULL)
-		{
-			free(inst->wall_textures[i].texture_buffer);
-			inst->wall_textures[i].texture_buffer = NULL;
-		}
+/**
+ * load_textures - Sets up the textures of the game.
+ * @inst: Pointer to the game_resources_t struct that holds the texture data.
+ *
+ * Description: The textures are listed by TEXTURE_LIST_PATH, or are the
+ * built-in ones. When TEXTURE_CACHE_PATH is out of date with the images,
+ * it is rewritten first, decoding one image at a time. Nothing is loaded
+ * yet: the texture pool loads what the frames show, from the cache, and
+ * keeps under texture_budget() bytes.
+ *
+ * Return: True on success, false if the list is malformed or the pool
+ * cannot start.
+ */
+bool load_textures(game_resources_t *inst)
+{
+	if (!texture_list_load(inst))
+		return (false);
+	IMG_Init(IMG_INIT_PNG);
+	if (!texture_cache_load(&inst->texture_cache, TEXTURE_CACHE_PATH,
+				inst->texture_names, inst->cached_textures,
+				inst->num_textures))
+	{
+		if (texture_cache_save(TEXTURE_CACHE_PATH, inst->texture_names,
+					inst->num_textures, decode_texture, inst))
+			texture_cache_load(&inst->texture_cache, TEXTURE_CACHE_PATH,
+					inst->texture_names, inst->cached_textures,
+					inst->num_textures);
+		else
+			fprintf(stderr, "Unable to write texture cache %s\n",
+					TEXTURE_CACHE_PATH);
 	}
+	return (texture_pool_init(&inst->textures, inst->num_textures,
+				texture_budget(), load_texture, inst));
+}
+
+/**
+ * free_textures - Frees the textures of the game.
+ * @inst: Pointer to the game_resources_t struct containing the texture data.
+ *
+ * Description: The texture pool stops loading and releases every
+ * texture before the cache it reads from is unmapped.
+ */
+void free_textures(game_resources_t *inst)
+{
+	texture_pool_free(&inst->textures);
+	memset(inst->cached_textures, 0, sizeof(inst->cached_textures));
+	texture_cache_close(&inst->texture_cache);
+	free(inst->texture_names);
+	free(inst->texture_list);
+	inst->texture_names = NULL;
+	inst->texture_list = NULL;
+	inst->num_textures = 0;
 }
@@ -11,7 +11,7 @@ bool initialize_window(game_resources_t *resources)
 {
 	SDL_DisplayMode mode;
 
-	if (SDL_Init(SDL_INIT_EVERYTHING) != 0) /*SDL_INIT_VIDEO */
+	if (SDL_Init(SDL_INIT_VIDEO) != 0)
 	{
 		fprintf(stderr, "Error initializing SDL: %s\n", SDL_GetError());
 		return (false);
@@ -57,12 +57,20 @@ bool initialize_window(game_resources_t *resources)
  * @resources: Pointer to the game_resource_t struct representing the
  * game resource.
  *
- * Description: This function frees the color buffer, destroys the
- * color buffer texture, renderer, window, and quits SDL.
+ * Description: This function stops the recording and the frame stream,
+ * leaves the server, frees the color buffer, destroys the color buffer
+ * texture, renderer, window, and quits SDL.
  */
 void destroy_window(game_resources_t *resources)
 {
+	capture_stop(&resources->capture);
+	stream_stop(&resources->stream);
 	free_textures(resources);
+	lightmap_free(&resources->lightmap);
+	reload_free(resources);
+	network_close(resources);
+	game_stats_close(resources);
+	view_free(&resources->view);
 	free(resources->color_buffer);
 	SDL_DestroyTexture(resources->color_buffer_texture);
 	SDL_DestroyRenderer(resources->renderer);
@@ -70,27 +78,6 @@ void destroy_window(game_resources_t *resources)
 	SDL_Quit();
 }
 
-/**
- * fill_color_buffer - Fills the color buffer with a specified color.
- *
- * @resources: Pointer to the game_resource_t struct representing
- * the game resource.
- * @color: The color value to fill the buffer with.
- *
- * Description: This function sets each pixel in the color buffer to the
- * specified color value, effectively clearing the previous contents.
- * The color buffer represents the color values of each pixel in the
- * window or screen.
- */
-void fill_color_buffer(game_resources_t *resources, color_t color)
-{
-	int i;
-
-	for (i = 0; i < WINDOW_WIDTH * WINDOW_HEIGHT; i++)
-	{
-		resources->color_buffer[i] = color;
-	}
-}
 /**
  * render_color_buffer - Updates the color buffer texture and renders
  * it to the screen.
@@ -102,10 +89,12 @@ void fill_color_buffer(game_resources_t *resources, color_t color)
  * contents of the color buffer, renders the color buffer texture onto
  * the renderer, and presents it on the screen.
  * It is responsible for displaying the rendered frame to the user.
+ *
+ * Return: The number of bytes uploaded, 0 if the upload failed.
  */
-void render_color_buffer(const game_resources_t *resources)
+size_t render_color_buffer(const game_resources_t *resources)
 {
-	SDL_UpdateTexture
+	int failed = SDL_UpdateTexture
 		(
 		 resources->color_buffer_texture,
 		 NULL,
@@ -115,20 +104,5 @@ void render_color_buffer(const game_resources_t *resources)
 	SDL_RenderCopy(resources->renderer, resources->color_buffer_texture,
 			NULL, NULL);
 	SDL_RenderPresent(resources->renderer);
-}
-/**
- * draw_pixel - Sets the color of a pixel in the color buffer.
- *
- * @x: The x-coordinate of the pixel.
- * @y: The y-coordinate of the pixel.
- * @color: The color of the pixel.
- * @resources: Pointer to the game_resource_t struct representing
- * the game resource.
- */
-void draw_pixel(int x, int y, color_t color, game_resources_t *resources)
-{
-	int index = (WINDOW_WIDTH * y) + x;
-
-	if (index >= 0 && index < (WINDOW_WIDTH * WINDOW_HEIGHT))
-		resources->color_buffer[index] = color;
+	return (failed ? 0 : WINDOW_WIDTH * WINDOW_HEIGHT * sizeof(color_t));
 }
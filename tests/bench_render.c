@@ -0,0 +1,155 @@
+#include "tests.h"
+#include <time.h>
+
+#define BENCH_PASSES 6
+#define BENCH_TOLERANCE 0.25
+
+/**
+ * compare_times - Orders frame times for qsort.
+ * @a: Pointer to the first frame time.
+ * @b: Pointer to the second frame time.
+ *
+ * Return: Negative, zero or positive as @a is less, equal or greater.
+ */
+static int compare_times(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * bench_scene - Measures the frame times of a scene.
+ * @scene: The scene to play.
+ * @stats: Receives the median, 90th and 99th percentile of every frame,
+ * then the lowest median of a single pass, in microseconds.
+ *
+ * Description: The scene is played BENCH_PASSES times from the start;
+ * the first pass only warms up the caches and is not measured. Each
+ * frame times the ray casting and the rendering. The best pass median
+ * is the figure compared with the baseline, as it is the least affected
+ * by other processes competing for the machine.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool bench_scene(const scene_t *scene, double stats[4])
+{
+	int frames = strlen(scene->script), pass, frame, count = 0;
+	double *times = malloc(sizeof(double) * frames * BENCH_PASSES);
+	struct timespec start, end;
+	scene_run_t run;
+
+	for (pass = 0; times && pass < BENCH_PASSES; pass++)
+	{
+		if (!scene_open(&run, scene))
+			break;
+		for (frame = 0; frame < frames; frame++)
+		{
+			clock_gettime(CLOCK_MONOTONIC, &start);
+			scene_step(&run, frame);
+			clock_gettime(CLOCK_MONOTONIC, &end);
+			if (pass > 0)
+				times[count++] =
+					(end.tv_sec - start.tv_sec) * 1e6 +
+					(end.tv_nsec - start.tv_nsec) / 1e3;
+		}
+		scene_close(&run);
+		if (pass == 0)
+			continue;
+		qsort(times + count - frames, frames, sizeof(double),
+				compare_times);
+		if (pass == 1 || times[count - frames + frames / 2] < stats[3])
+			stats[3] = times[count - frames + frames / 2];
+	}
+	if (count > 0)
+	{
+		qsort(times, count, sizeof(double), compare_times);
+		stats[0] = times[count / 2];
+		stats[1] = times[count * 9 / 10];
+		stats[2] = times[count * 99 / 100];
+	}
+	free(times);
+	return (count > 0 && count == frames * (BENCH_PASSES - 1));
+}
+
+/**
+ * find_baseline - Looks up the baseline of a scene.
+ * @baseline: The baseline file, or NULL.
+ * @name: The name of the scene.
+ *
+ * Return: The baseline best pass median in microseconds, or 0 if there
+ * is none.
+ */
+static double find_baseline(FILE *baseline, const char *name)
+{
+	char scene[64];
+	double median, p90, p99, best;
+
+	if (!baseline)
+		return (0);
+	rewind(baseline);
+	while (fscanf(baseline, "%63s %lf %lf %lf %lf", scene, &median, &p90,
+				&p99, &best) == 5)
+		if (strcmp(scene, name) == 0)
+			return (best);
+	return (0);
+}
+
+/**
+ * bench_tolerance - Reads the allowed slowdown from the environment.
+ *
+ * Return: MAZE_BENCH_TOLERANCE if set, BENCH_TOLERANCE otherwise.
+ */
+static double bench_tolerance(void)
+{
+	const char *value = getenv("MAZE_BENCH_TOLERANCE");
+
+	return (value ? atof(value) : BENCH_TOLERANCE);
+}
+
+/**
+ * main - Measures every test scene and compares it with a baseline.
+ * @argc: The number of command-line arguments.
+ * @argv: The baseline file, optionally followed by --update to rewrite it.
+ *
+ * Return: 0 if no scene got slower than the tolerance allows, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	bool update = argc == 3 && strcmp(argv[2], "--update") == 0;
+	double stats[4], base, tolerance = bench_tolerance();
+	const char *name;
+	FILE *baseline;
+	int i, slower = 0;
+	bool slow;
+
+	if (argc != 2 && !update)
+	{
+		fprintf(stderr, "Usage: %s <baseline_file> [--update]\n",
+				argv[0]);
+		return (1);
+	}
+	baseline = fopen(argv[1], update ? "w" : "r");
+	printf("%-16s %10s %10s %10s %10s %10s\n", "scene", "median_us",
+			"p90_us", "p99_us", "best_us", "baseline");
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		name = test_scenes[i].name;
+		if (!bench_scene(&test_scenes[i], stats))
+			return (1);
+		base = update ? 0 : find_baseline(baseline, name);
+		slow = base > 0 && stats[3] > base * (1 + tolerance);
+		slower += slow;
+		printf("%-16s %10.1f %10.1f %10.1f %10.1f %10.1f%s\n", name,
+				stats[0], stats[1], stats[2], stats[3], base,
+				slow ? "  SLOWER" : "");
+		if (update && baseline)
+			fprintf(baseline, "%s %.1f %.1f %.1f %.1f\n", name,
+					stats[0], stats[1], stats[2], stats[3]);
+	}
+	if (baseline)
+		fclose(baseline);
+	printf("%d scenes slower than the baseline by more than %.0f%%\n",
+			slower, tolerance * 100);
+	return (slower ? 1 : 0);
+}
@@ -0,0 +1,135 @@
+#include "tests.h"
+
+/**
+ * scene_textures - Builds the procedural textures of the test scenes.
+ * @atlas: Pointer to the texture_atlas_t struct to build.
+ *
+ * Description: The textures do not depend on the PNG decoder, so the
+ * goldens are the same on every machine. The last texture is 48x40 to
+ * exercise the resampling of non-power-of-two sources.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool scene_textures(texture_atlas_t *atlas)
+{
+	texture_t sources[NUM_TEXTURES];
+	color_t *texel;
+	bool built;
+	int i, x, y;
+
+	for (i = 0; i < NUM_TEXTURES; i++)
+	{
+		sources[i].width = i == NUM_TEXTURES - 1 ? 48 : 64;
+		sources[i].height = i == NUM_TEXTURES - 1 ? 40 : 64;
+		texel = malloc(sizeof(color_t) *
+				sources[i].width * sources[i].height);
+		sources[i].texture_buffer = texel;
+		for (y = 0; texel && y < sources[i].height; y++)
+			for (x = 0; x < sources[i].width; x++)
+				*texel++ = 0xFF000000 |
+					((x ^ y) * 4 * (i + 1) & 0xFF) |
+					((x * 4) & 0xFF) << 8 |
+					((y * 6 + i * 40) & 0xFF) << 16;
+	}
+	built = texture_atlas_build(atlas, sources, NUM_TEXTURES);
+	for (i = 0; i < NUM_TEXTURES; i++)
+		free(sources[i].texture_buffer);
+	return (built);
+}
+
+/**
+ * scene_open - Loads the map of a scene and places its camera.
+ * @run: Pointer to the scene_run_t struct to initialize.
+ * @scene: The scene to play.
+ *
+ * Return: True on success, false otherwise.
+ */
+bool scene_open(scene_run_t *run, const scene_t *scene)
+{
+	light_t light;
+
+	memset(run, 0, sizeof(*run));
+	run->scene = scene;
+	if (!parse_map_from_file(scene->map_file, &run->map) ||
+			!scene_textures(&run->atlas))
+		return (false);
+	run->world.map = &run->map;
+	run->world.textures = run->atlas.tiles;
+	light.x = scene->x;
+	light.y = scene->y;
+	light.radius = 6 * TILE_SIZE;
+	light.level = LIGHT_FULL;
+	if (scene->lit && !lightmap_build(&run->lightmap, &run->map, &light, 1,
+				LIGHT_AMBIENT))
+		return (false);
+	run->world.lightmap = scene->lit ? &run->lightmap : NULL;
+	player_init(&run->player, scene->x, scene->y);
+	run->player.rotation_angle = scene->angle;
+	run->pixels = malloc(sizeof(color_t) * scene->width * scene->height);
+	if (!run->pixels || !view_init(&run->view, &run->world, &run->player,
+				run->pixels, scene->width, scene->height))
+	{
+		fprintf(stderr, "Unable to set up scene %s\n", scene->name);
+		return (false);
+	}
+	run->view.enable_minimap = scene->minimap;
+	return (true);
+}
+
+/**
+ * scene_step - Plays one frame of a scene.
+ * @run: Pointer to the scene_run_t struct.
+ * @frame: The index of the frame in the script of the scene.
+ *
+ * Description: The camera moves with a fixed time step, so a frame only
+ * depends on the script and on the engine.
+ */
+void scene_step(scene_run_t *run, int frame)
+{
+	char action = run->scene->script[frame];
+
+	run->player.walk_direction = action == 'w' || action == 'W' ? 1 :
+		action == 's' ? -1 : 0;
+	run->player.turn_direction = action == 'r' || action == 'W' ? 1 :
+		action == 'l' ? -1 : 0;
+	move_player(SCENE_DELTA_TIME, &run->player, &run->map);
+	cast_all_rays(&run->view);
+	render_view(&run->view);
+}
+
+/**
+ * scene_close - Frees everything a scene run owns.
+ * @run: Pointer to the scene_run_t struct.
+ */
+void scene_close(scene_run_t *run)
+{
+	view_free(&run->view);
+	texture_atlas_free(&run->atlas);
+	lightmap_free(&run->lightmap);
+	map_free(&run->map);
+	free(run->pixels);
+	run->pixels = NULL;
+}
+
+/**
+ * frame_hash - Hashes the visible pixels of a framebuffer.
+ * @frame: Pointer to the framebuffer_t struct to hash.
+ *
+ * Return: The 64-bit FNV-1a hash of the pixels, row by row.
+ */
+uint64_t frame_hash(const framebuffer_t *frame)
+{
+	uint64_t hash = UINT64_C(0xCBF29CE484222325);
+	const unsigned char *bytes;
+	size_t i, size = frame->width * sizeof(color_t);
+	int y;
+
+	for (y = 0; y < frame->height; y++)
+	{
+		bytes = (const unsigned char *)(frame->pixels +
+				(size_t)y * frame->pitch);
+		for (i = 0; i < size; i++)
+			hash = (hash ^ bytes[i]) * UINT64_C(0x100000001B3);
+	}
+	return (hash);
+}
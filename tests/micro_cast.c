@@ -0,0 +1,107 @@
+#include "tests.h"
+
+/**
+ * micro_cast_all_rays - Casts the rays of every column of the view.
+ * @run: The scene the kernel runs on.
+ *
+ * Return: The number of rays cast.
+ */
+unsigned long micro_cast_all_rays(scene_run_t *run)
+{
+	cast_all_rays(&run->view);
+	return (run->view.frame.width);
+}
+
+/**
+ * micro_cast_ray - Casts the ray of every column through cast_ray alone.
+ * @run: The scene the kernel runs on; its rays must already be cast.
+ *
+ * Description: Unlike cast_all_rays, this skips resetting the frame and
+ * computing the ray angles, leaving only the grid traversal.
+ *
+ * Return: The number of rays cast.
+ */
+unsigned long micro_cast_ray(scene_run_t *run)
+{
+	view_t *view = &run->view;
+	int column;
+
+	for (column = 0; column < view->frame.width; column++)
+		cast_ray(view->rays.ray_angle[column], column, view);
+	return (view->frame.width);
+}
+
+/**
+ * micro_map_has_wall_at - Looks up walls at pseudo-random points.
+ * @run: The scene the kernel runs on.
+ *
+ * Description: The points come from a fixed linear congruential sequence
+ * covering the map and a margin around it.
+ *
+ * Return: The number of lookups.
+ */
+unsigned long micro_map_has_wall_at(scene_run_t *run)
+{
+	unsigned long seed = 12345, walls = 0;
+	float width = run->map.cols * TILE_SIZE;
+	float height = run->map.rows * TILE_SIZE, x, y;
+	int i;
+
+	for (i = 0; i < 4096; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		x = (seed >> 8 & 0xFFFF) / 65536.0f * 1.1f - 0.05f;
+		y = (seed >> 24 & 0xFFFF) / 65536.0f * 1.1f - 0.05f;
+		walls += map_has_wall_at(x * width, y * height, &run->map);
+	}
+	micro_sink += walls;
+	return (4096);
+}
+
+/**
+ * micro_draw_line - Draws lines between pseudo-random points.
+ * @run: The scene the kernel runs on.
+ *
+ * Description: The end points spread over twice the frame, so many of
+ * the lines need clipping.
+ *
+ * Return: The number of lines drawn.
+ */
+unsigned long micro_draw_line(scene_run_t *run)
+{
+	framebuffer_t *frame = &run->view.frame;
+	unsigned long seed = 67890;
+	int i, coords[4], k;
+
+	for (i = 0; i < 256; i++)
+	{
+		for (k = 0; k < 4; k++)
+		{
+			seed = seed * 1103515245 + 12345;
+			coords[k] = (int)(seed >> 12 & 0xFFFF) %
+				(2 * (k % 2 ? frame->height : frame->width)) -
+				(k % 2 ? frame->height : frame->width) / 2;
+		}
+		draw_line(coords[0], coords[1], coords[2], coords[3],
+				0xFF0000FF, frame);
+	}
+	return (256);
+}
+
+/**
+ * micro_parse_map - Parses the map file of the scene.
+ * @run: The scene the kernel runs on.
+ *
+ * Return: The number of map cells parsed.
+ */
+unsigned long micro_parse_map(scene_run_t *run)
+{
+	map_t map = {NULL, 0, 0, 0};
+	unsigned long cells;
+
+	parse_map_from_file(run->scene->map_file, &map);
+	cells = (unsigned long)map.rows * map.cols;
+	micro_sink += cells ? map.cells[cells / 2] : 0;
+	map_free(&map);
+	return (cells ? cells : 1);
+}
@@ -0,0 +1,62 @@
+#include "tests.h"
+
+/**
+ * micro_render_floor_lit - Renders the floor of every column, lit.
+ * @run: The scene the kernel runs on; its rays must already be cast and
+ * its lightmap baked.
+ *
+ * Description: The same span as micro_render_floor(), shaded by the
+ * lightmap of the scene, so the two compare the cost of lighting.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_render_floor_lit(scene_run_t *run)
+{
+	unsigned long items;
+
+	run->world.lightmap = &run->lightmap;
+	items = micro_render_floor(run);
+	run->world.lightmap = NULL;
+	return (items);
+}
+
+/**
+ * micro_wall_span_lit - Renders a full-height lit wall span per column.
+ * @run: The scene the kernel runs on; its rays must already be cast and
+ * its lightmap baked.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_wall_span_lit(scene_run_t *run)
+{
+	unsigned long items;
+
+	run->world.lightmap = &run->lightmap;
+	items = micro_wall_span(run);
+	run->world.lightmap = NULL;
+	return (items);
+}
+
+/**
+ * micro_lightmap_build - Bakes the lighting of the map of the scene.
+ * @run: The scene the kernel runs on.
+ *
+ * Description: The ambient occlusion of every cell and one light at the
+ * camera, as for the lit test scenes.
+ *
+ * Return: The number of map cells baked.
+ */
+unsigned long micro_lightmap_build(scene_run_t *run)
+{
+	lightmap_t lightmap;
+	light_t light;
+
+	light.x = run->scene->x;
+	light.y = run->scene->y;
+	light.radius = 6 * TILE_SIZE;
+	light.level = LIGHT_FULL;
+	if (lightmap_build(&lightmap, &run->map, &light, 1, LIGHT_AMBIENT))
+		micro_sink += lightmap.corners[0];
+	lightmap_free(&lightmap);
+	return ((unsigned long)run->map.rows * run->map.cols);
+}
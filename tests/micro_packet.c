@@ -0,0 +1,27 @@
+#include "tests.h"
+
+/**
+ * micro_cast_packet - Casts the ray of every column in packets.
+ * @run: The scene the kernel runs on; its rays must already be cast.
+ *
+ * Description: The counterpart of micro_cast_ray, casting RAY_PACKET
+ * neighbouring columns at a time through cast_ray_packet().
+ *
+ * Return: The number of rays cast.
+ */
+unsigned long micro_cast_packet(scene_run_t *run)
+{
+	view_t *view = &run->view;
+	int column, count, i, columns[RAY_PACKET];
+
+	for (column = 0; column < view->frame.width; column += count)
+	{
+		count = view->frame.width - column;
+		if (count > RAY_PACKET)
+			count = RAY_PACKET;
+		for (i = 0; i < count; i++)
+			columns[i] = column + i;
+		cast_ray_packet(view, columns, count);
+	}
+	return (view->frame.width);
+}
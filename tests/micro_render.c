@@ -0,0 +1,95 @@
+#include "tests.h"
+
+/**
+ * micro_render_floor - Renders the floor of every column.
+ * @run: The scene the kernel runs on; its rays must already be cast.
+ *
+ * Description: Every column gets the same wall, ending a quarter of the
+ * frame below the horizon, so the cost does not depend on the camera.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_render_floor(scene_run_t *run)
+{
+	view_t *view = &run->view;
+	int column, wall_bottom = view->frame.height * 3 / 4;
+
+	for (column = 0; column < view->frame.width; column++)
+		render_floor(wall_bottom, column, view);
+	return ((unsigned long)view->frame.width *
+			(view->frame.height - wall_bottom + 1));
+}
+
+/**
+ * micro_render_ceil - Renders the ceiling of every column.
+ * @run: The scene the kernel runs on; its rays must already be cast.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_render_ceil(scene_run_t *run)
+{
+	view_t *view = &run->view;
+	int column, wall_top = view->frame.height / 4;
+
+	for (column = 0; column < view->frame.width; column++)
+		render_ceil(wall_top, column, view);
+	return ((unsigned long)view->frame.width * wall_top);
+}
+
+/**
+ * micro_wall_span - Renders a full-height wall span in every column.
+ * @run: The scene the kernel runs on; its rays must already be cast.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_wall_span(scene_run_t *run)
+{
+	view_t *view = &run->view;
+	wall_span_t span;
+	int column;
+
+	for (column = 0; column < view->frame.width; column++)
+	{
+		if (column == 0 || span.id != view->rays.texture[column] ||
+				span.vertical !=
+				view->rays.was_hit_vertical[column])
+			wall_span_init(&span, view, column);
+		render_wall_column(column, 0, view->frame.height,
+				view->frame.height, &span, view);
+	}
+	return ((unsigned long)view->frame.width * view->frame.height);
+}
+
+/**
+ * micro_darken - Darkens a copy of every pixel of the frame.
+ * @run: The scene the kernel runs on.
+ *
+ * Return: The number of pixels darkened.
+ */
+unsigned long micro_darken(scene_run_t *run)
+{
+	const framebuffer_t *frame = &run->view.frame;
+	unsigned long count = (unsigned long)frame->width * frame->height, i;
+	color_t color, sum = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		color = frame->pixels[i];
+		darken_color_intensity(&color, 0.7);
+		sum ^= color;
+	}
+	micro_sink += sum;
+	return (count);
+}
+
+/**
+ * micro_fill - Clears the whole frame.
+ * @run: The scene the kernel runs on.
+ *
+ * Return: The number of pixels written.
+ */
+unsigned long micro_fill(scene_run_t *run)
+{
+	fill_color_buffer(&run->view.frame, 0xFF000000);
+	return ((unsigned long)run->view.frame.width * run->view.frame.height);
+}
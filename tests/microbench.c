@@ -0,0 +1,177 @@
+#include "tests.h"
+#include <time.h>
+
+volatile unsigned long micro_sink;
+
+static const micro_kernel_t micro_kernels[] = {
+	{"cast_all_rays", micro_cast_all_rays},
+	{"cast_ray", micro_cast_ray},
+	{"cast_ray_packet", micro_cast_packet},
+	{"map_has_wall_at", micro_map_has_wall_at},
+	{"render_floor", micro_render_floor},
+	{"render_floor_lit", micro_render_floor_lit},
+	{"render_ceil", micro_render_ceil},
+	{"wall_span", micro_wall_span},
+	{"wall_span_lit", micro_wall_span_lit},
+	{"darken_color_intensity", micro_darken},
+	{"fill_color_buffer", micro_fill},
+	{"draw_line", micro_draw_line},
+	{"parse_map_from_file", micro_parse_map},
+	{"lightmap_build", micro_lightmap_build}
+};
+
+/**
+ * compare_doubles - Orders measurements for qsort.
+ * @a: Pointer to the first measurement.
+ * @b: Pointer to the second measurement.
+ *
+ * Return: Negative, zero or positive as @a is less, equal or greater.
+ */
+static int compare_doubles(const void *a, const void *b)
+{
+	double x = *(const double *)a, y = *(const double *)b;
+
+	return ((x > y) - (x < y));
+}
+
+/**
+ * read_cycles - Reads the time stamp counter, where there is one.
+ *
+ * Return: The reference cycle count, or 0 if it is not available.
+ */
+static double read_cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	return ((double)__builtin_ia32_rdtsc());
+#else
+	return (0);
+#endif
+}
+
+/**
+ * time_kernel - Measures one kernel and prints its JSON record.
+ * @kernel: The kernel to measure.
+ * @run: The scene the kernel runs on.
+ * @reps: The number of measured repetitions.
+ * @warmup: The number of repetitions run before measuring.
+ * @separator: Printed after the record.
+ *
+ * Description: Repetitions are timed one by one; the median and the
+ * fastest are reported. Cycles are time stamp counter ticks and are null
+ * where the counter is not available.
+ */
+static void time_kernel(const micro_kernel_t *kernel, scene_run_t *run,
+		int reps, int warmup, const char *separator)
+{
+	double *ns = malloc(sizeof(double) * reps * 2), *ticks = ns + reps;
+	double cycles;
+	struct timespec start, end;
+	unsigned long items = 1;
+	int i;
+
+	for (i = 0; ns && i < warmup + reps; i++)
+	{
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		cycles = read_cycles();
+		items = kernel->run(run);
+		cycles = read_cycles() - cycles;
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		if (i < warmup)
+			continue;
+		ticks[i - warmup] = cycles;
+		ns[i - warmup] = (end.tv_sec - start.tv_sec) * 1e9 +
+			(end.tv_nsec - start.tv_nsec);
+	}
+	if (!ns)
+		return;
+	qsort(ns, reps, sizeof(double), compare_doubles);
+	qsort(ticks, reps, sizeof(double), compare_doubles);
+	printf("    {\"name\": \"%s\", \"items\": %lu, \"median_ns\": %.0f, ",
+			kernel->name, items, ns[reps / 2]);
+	printf("\"min_ns\": %.0f, \"ns_per_item\": %.3f, ", ns[0],
+			ns[reps / 2] / items);
+	if (ticks[reps / 2] > 0)
+		printf("\"cycles_per_item\": %.3f}%s\n",
+				ticks[reps / 2] / items, separator);
+	else
+		printf("\"cycles_per_item\": null}%s\n", separator);
+	free(ns);
+}
+
+/**
+ * parse_args - Reads the options of the microbenchmark.
+ * @argc: The number of command-line arguments.
+ * @argv: Pairs of --width, --height, --map, --x, --y, --angle, --reps
+ * or --warmup and their value.
+ * @scene: The scene the kernels run on, updated from the options.
+ * @counts: The number of measured and warmup repetitions, updated.
+ *
+ * Return: True on success, false on an unknown or incomplete option.
+ */
+static bool parse_args(int argc, char *argv[], scene_t *scene, int counts[2])
+{
+	int i;
+
+	for (i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--width") == 0)
+			scene->width = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--height") == 0)
+			scene->height = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--map") == 0)
+			scene->map_file = argv[i + 1];
+		else if (strcmp(argv[i], "--x") == 0)
+			scene->x = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--y") == 0)
+			scene->y = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--angle") == 0)
+			scene->angle = atof(argv[i + 1]);
+		else if (strcmp(argv[i], "--reps") == 0)
+			counts[0] = atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--warmup") == 0)
+			counts[1] = atoi(argv[i + 1]);
+		else
+			break;
+	}
+	return (i == argc && scene->width > 0 && scene->height > 0 &&
+			counts[0] > 0 && counts[1] >= 0);
+}
+
+/**
+ * main - Measures the hot kernels of the engine in isolation.
+ * @argc: The number of command-line arguments.
+ * @argv: The options, see parse_args.
+ *
+ * Return: 0 on success, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	scene_t scene = {"microbench", "./map/map.txt", 640, 400, 640, 416,
+		3 * PI / 2, false, true, "."};
+	int counts[2] = {200, 20}, i, count = sizeof(micro_kernels) /
+		sizeof(micro_kernels[0]);
+	scene_run_t run;
+
+	if (!parse_args(argc, argv, &scene, counts))
+	{
+		fprintf(stderr, "Usage: %s [--width N] [--height N] "
+				"[--map FILE] [--x X] [--y Y] [--angle A] "
+				"[--reps N] [--warmup N]\n", argv[0]);
+		return (1);
+	}
+	if (!scene_open(&run, &scene))
+		return (1);
+	run.world.lightmap = NULL; /* The lit kernels set it while they run */
+	scene_step(&run, 0);
+	printf("{\n  \"config\": {\"width\": %d, \"height\": %d, "
+			"\"map\": \"%s\", \"x\": %g, \"y\": %g, \"angle\": %g, "
+			"\"reps\": %d, \"warmup\": %d},\n  \"kernels\": [\n",
+			scene.width, scene.height, scene.map_file, scene.x,
+			scene.y, scene.angle, counts[0], counts[1]);
+	for (i = 0; i < count; i++)
+		time_kernel(&micro_kernels[i], &run, counts[0], counts[1],
+				i + 1 < count ? "," : "");
+	printf("  ]\n}\n");
+	scene_close(&run);
+	return (0);
+}
@@ -0,0 +1,70 @@
+#include "tests.h"
+
+/*
+ * The camera paths shared by `make test` and `make bench`. Adding or
+ * changing a scene requires regenerating tests/golden.txt and
+ * tests/baseline.txt with --update.
+ */
+const scene_t test_scenes[] = {
+	{
+		"map_walk", "./map/map.txt",
+		640, 400, 640, 416, 3 * PI / 2, false, false,
+		"wwwwwwwwwwwwwwwwllllllllllllllllwwwwwwwwwwwwwwwwwwww"
+		"rrrrrrrrrrrrrrrrrrrrrrrrwwwwwwwwwwwwwwwwssssssss"
+	},
+	{
+		"map_minimap", "./map/map.txt",
+		1280, 832, 200, 200, 0, true, false,
+		"WWWWWWWWWWWWWWWWWWWWWWWWWWWWWWwwwwwwwwwwwwwwwwllllllll"
+		"........wwwwwwwwwwwwwwww"
+	},
+	{
+		"map_odd_size", "./map/map.txt",
+		321, 201, 1000, 150, PI, true, false,
+		"wwwwwwwwwwwwwwwwwwwwrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrwwwwwwwwww"
+	},
+	{
+		"map_lit", "./map/map.txt",
+		640, 400, 640, 416, 3 * PI / 2, false, true,
+		"wwwwwwwwwwwwwwwwllllllllllllllllwwwwwwwwwwwwwwwwwwww"
+		"rrrrrrrrrrrrrrrrrrrrrrrrwwwwwwwwwwwwwwwwssssssss"
+	},
+	{
+		"open_hall", "./tests/maps/open.txt",
+		320, 200, 640, 416, 0, false, false,
+		"rrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrr"
+		"wwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwwww"
+	},
+	{
+		"pillars", "./tests/maps/pillars.txt",
+		800, 600, 608, 352, 0.3, false, false,
+		"wwwwwwwwwwwwwwwwwwwwWWWWWWWWWWWWWWWWWWWWllllllllllllllll"
+		"sssssssssssssssrrrrrrrrrrrrrrrrrrrrwwwwwwwwww"
+	},
+	{
+		"braided_maze", "./tests/maps/gen_braided.txt",
+		640, 400, 96, 96, 0, true, false,
+		"wwwwwwwwwwwwwwwwwwwwrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrwwwwwwwwww"
+		"wwwwwwwwwwllllllllllllllllllllllllwwwwwwwwwwwwwwwwwwww"
+	},
+	{
+		"cave", "./tests/maps/gen_cave.txt",
+		640, 400, 160, 160, PI / 4, true, false,
+		"wwwwwwwwwwwwwwwwwwwwwwwwwwwwwwWWWWWWWWWWWWWWWWWWWW"
+		"llllllllllllllllllllwwwwwwwwwwwwwwwwwwww"
+	},
+	{
+		"cave_lit", "./tests/maps/gen_cave.txt",
+		640, 400, 160, 160, PI / 4, true, true,
+		"wwwwwwwwwwwwwwwwwwwwwwwwwwwwwwWWWWWWWWWWWWWWWWWWWW"
+		"llllllllllllllllllllwwwwwwwwwwwwwwwwwwww"
+	},
+	{
+		"large_hall", "./tests/maps/gen_hall.txt",
+		800, 500, 65568, 65568, PI / 5, false, false,
+		"wwwwwwwwwwwwwwwwwwwwrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrrr"
+		"rrrrrrrrrrrrrrrrrrrrwwwwwwwwwwwwwwwwwwww"
+	}
+};
+
+const int num_test_scenes = sizeof(test_scenes) / sizeof(test_scenes[0]);
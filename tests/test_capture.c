@@ -0,0 +1,261 @@
+#include "tests.h"
+#include <limits.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#define CAPTURE_TEST_SCENE "map_odd_size"
+#define CAPTURE_TEST_FRAMES 6
+#define CAPTURE_TEST_QUEUED (CAPTURE_RING_SIZE + 5)
+
+static char capture_dir[] = "/tmp/maze-capture-XXXXXX";
+static int capture_width, capture_height;
+
+/**
+ * check_y4m - Reads one Y4M frame and compares it against a frame.
+ * @file: The stream, just before the FRAME line.
+ * @frame: The frame that was captured.
+ * @data: Buffer large enough for one frame in any format.
+ *
+ * Description: Every luma sample, and every chroma sample averaging a
+ * 2x2 block, must be within one step of the BT.601 value.
+ *
+ * Return: The number of wrong samples, or 1 if the frame is cut short.
+ */
+static int check_y4m(FILE *file, const color_t *frame, unsigned char *data)
+{
+	int w = capture_width, h = capture_height, x, y, i, wrong = 0;
+	size_t count = (size_t)w * h, chroma = (size_t)((w + 1) / 2) *
+		((h + 1) / 2);
+	const unsigned char *u = data + count, *v = u + chroma;
+	double r, g, b;
+	color_t c;
+
+	if (fread(data, 1, 6, file) != 6 || memcmp(data, "FRAME\n", 6) != 0 ||
+			fread(data, 1, count + 2 * chroma, file) !=
+			count + 2 * chroma)
+		return (1);
+	for (i = 0; i < (int)count; i++)
+		wrong += fabs(0.299 * (frame[i] & 0xFF) + 0.587 *
+				(frame[i] >> 8 & 0xFF) + 0.114 *
+				(frame[i] >> 16 & 0xFF) - data[i]) > 1;
+	for (y = 0; y < h; y += 2)
+		for (x = 0; x < w; x += 2)
+		{
+			for (i = 0, r = 0, g = 0, b = 0; i < 4; i++)
+			{
+				c = frame[(y + (i / 2 && y + 1 < h)) * w + x +
+					(i % 2 && x + 1 < w)];
+				r += (c & 0xFF) / 4.0;
+				g += (c >> 8 & 0xFF) / 4.0;
+				b += (c >> 16 & 0xFF) / 4.0;
+			}
+			wrong += fabs(128 - 0.168736 * r - 0.331264 * g +
+					0.5 * b - *u++) > 1;
+			wrong += fabs(128 + 0.5 * r - 0.418688 * g -
+					0.081312 * b - *v++) > 1;
+		}
+	return (wrong);
+}
+
+/**
+ * check_frame - Reads one captured frame and compares it against a frame.
+ * @file: The stream or frame file, or NULL if it could not be opened.
+ * @format: The format of the capture.
+ * @frame: The frame that was captured.
+ * @data: Buffer large enough for one frame in any format.
+ *
+ * Description: PPM, QOI and raw frames must decode to exactly the pixels
+ * of @frame, with alpha stored as opaque.
+ *
+ * Return: The number of wrong pixels, or 1 if the frame is unreadable.
+ */
+static int check_frame(FILE *file, capture_format_t format,
+		const color_t *frame, unsigned char *data)
+{
+	size_t count = (size_t)capture_width * capture_height, size, i;
+	color_t *pixels;
+	int w, h, wrong = 0;
+
+	if (!file || format == CAPTURE_Y4M)
+		return (file ? check_y4m(file, frame, data) : 1);
+	if (format == CAPTURE_QOI)
+	{
+		size = fread(data, 1, count * 5 + 32, file);
+		pixels = malloc(sizeof(color_t) * count);
+		wrong = !pixels || size < 22 || memcmp(data, "qoif", 4) != 0 ||
+			(data[6] << 8 | data[7]) != capture_width ||
+			(data[10] << 8 | data[11]) != capture_height ||
+			qoi_decode_rows(data + 14, size - 22, pixels,
+					capture_width, capture_height,
+					capture_width) != size - 22 ||
+			memcmp(data + size - 8, "\0\0\0\0\0\0\0\1", 8) != 0;
+		for (i = 0; !wrong && i < count; i++)
+			wrong = pixels[i] != (frame[i] | 0xFF000000);
+		free(pixels);
+		return (wrong);
+	}
+	if (format == CAPTURE_PPM && (fscanf(file, "P6 %d %d 255", &w,
+					&h) != 2 || fgetc(file) != '\n' ||
+				w != capture_width || h != capture_height))
+		return (1);
+	if (fread(data, 1, count * 3, file) != count * 3)
+		return (1);
+	for (i = 0; i < count; i++)
+		wrong += data[3 * i] != (frame[i] & 0xFF) ||
+			data[3 * i + 1] != (frame[i] >> 8 & 0xFF) ||
+			data[3 * i + 2] != (frame[i] >> 16 & 0xFF);
+	return (wrong);
+}
+
+/**
+ * check_format - Captures frames in one format and reads them back.
+ * @extension: The extension of the capture path, which picks the format.
+ * @frames: CAPTURE_TEST_FRAMES frames.
+ * @data: Buffer large enough for one frame in any format.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_format(const char *extension, const color_t *frames,
+		unsigned char *data)
+{
+	size_t count = (size_t)capture_width * capture_height;
+	char path[PATH_MAX], frame_path[PATH_MAX];
+	capture_format_t format;
+	capture_t capture;
+	FILE *stream = NULL, *file;
+	int i, w, h, wrong = 0;
+
+	sprintf(path, "%s/shot.%s", capture_dir, extension);
+	if (!capture_format_from_path(path, &format) ||
+			!capture_start(&capture, path, capture_width,
+				capture_height, 30))
+		return (1);
+	for (i = 0; i < CAPTURE_TEST_FRAMES; i++)
+		wrong += !capture_frame(&capture, frames + i * count,
+				capture_width);
+	capture_stop(&capture);
+	if (format == CAPTURE_Y4M || format == CAPTURE_RAW)
+		stream = fopen(path, "rb");
+	if (stream && format == CAPTURE_Y4M)
+		wrong += fscanf(stream,
+				"YUV4MPEG2 W%d H%d F30:1 Ip A1:1 C420jpeg",
+				&w, &h) != 2 || fgetc(stream) != '\n' ||
+			w != capture_width || h != capture_height;
+	for (i = 0; i < CAPTURE_TEST_FRAMES; i++)
+	{
+		sprintf(frame_path, "%s/shot-%06d.%s", capture_dir, i,
+				extension);
+		file = stream ? stream : fopen(frame_path, "rb");
+		wrong += check_frame(file, format, frames + i * count, data);
+		if (file && file != stream)
+			fclose(file);
+		remove(frame_path);
+	}
+	if (stream)
+		wrong += fgetc(stream) != EOF;
+	if (stream)
+		fclose(stream);
+	remove(path);
+	printf("%-16s %s\n", extension, wrong ? "FAILED" : "ok");
+	return (wrong);
+}
+
+/**
+ * check_ring - Fills the ring of a capture, then stops it.
+ * @frames: CAPTURE_TEST_FRAMES frames.
+ * @data: Buffer large enough for one frame in any format.
+ *
+ * Description: The first frame file is a fifo, so the writer waits until
+ * it is read and frees no slot: the frames past CAPTURE_RING_SIZE must be
+ * dropped and counted. Once the first frame is read, stopping must still
+ * write every queued frame, and none of the dropped ones.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_ring(const color_t *frames, unsigned char *data)
+{
+	size_t count = (size_t)capture_width * capture_height;
+	char path[PATH_MAX], first[PATH_MAX];
+	capture_t capture;
+	FILE *file;
+	int i, wrong = 0;
+
+	sprintf(path, "%s/ring.ppm", capture_dir);
+	sprintf(first, "%s/ring-000000.ppm", capture_dir);
+	if (mkfifo(first, 0600) != 0 || !capture_start(&capture, path,
+				capture_width, capture_height, 30))
+		return (1);
+	for (i = 0; i < CAPTURE_TEST_QUEUED; i++)
+		wrong += capture_frame(&capture, frames + i %
+				CAPTURE_TEST_FRAMES * count, capture_width) !=
+			(i < CAPTURE_RING_SIZE);
+	wrong += capture.dropped != CAPTURE_TEST_QUEUED - CAPTURE_RING_SIZE;
+	file = fopen(first, "rb");
+	wrong += check_frame(file, CAPTURE_PPM, frames, data) ||
+		fgetc(file) != EOF;
+	if (file)
+		fclose(file);
+	capture_stop(&capture);
+	for (i = 1; i < CAPTURE_TEST_QUEUED; i++)
+	{
+		sprintf(path, "%s/ring-%06d.ppm", capture_dir, i);
+		file = fopen(path, "rb");
+		if (i < CAPTURE_RING_SIZE)
+			wrong += check_frame(file, CAPTURE_PPM, frames + i %
+					CAPTURE_TEST_FRAMES * count, data);
+		else
+			wrong += file != NULL;
+		if (file)
+			fclose(file);
+		remove(path);
+	}
+	remove(first);
+	printf("%-16s %s\n", "ring", wrong ? "FAILED" : "ok");
+	return (wrong);
+}
+
+/**
+ * main - Captures frames of a scene in every format and reads them back.
+ *
+ * Description: The scene has an odd size, so the Y4M chroma planes
+ * repeat the last row and column.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	static const char * const extensions[] = {"y4m", "ppm", "qoi", "rgb"};
+	static scene_run_t run;
+	const scene_t *scene = NULL;
+	color_t *frames = NULL;
+	unsigned char *data = NULL;
+	size_t count = 0;
+	int i, failures = 1;
+
+	for (i = 0; i < num_test_scenes; i++)
+		if (strcmp(test_scenes[i].name, CAPTURE_TEST_SCENE) == 0)
+			scene = &test_scenes[i];
+	if (scene && mkdtemp(capture_dir) && scene_open(&run, scene))
+	{
+		capture_width = scene->width;
+		capture_height = scene->height;
+		count = (size_t)capture_width * capture_height;
+		frames = malloc(sizeof(color_t) * count * CAPTURE_TEST_FRAMES);
+		data = malloc(count * 5 + 32);
+	}
+	for (i = 0; frames && data && i < CAPTURE_TEST_FRAMES * 4; i++)
+	{
+		scene_step(&run, i);
+		if (i % 4 == 3)
+			memcpy(frames + i / 4 * count, run.pixels,
+					sizeof(color_t) * count);
+	}
+	for (i = 0, failures = !frames || !data; frames && data && i < 4; i++)
+		failures += check_format(extensions[i], frames, data);
+	failures += frames && data ? check_ring(frames, data) : 0;
+	rmdir(capture_dir);
+	free(frames);
+	free(data);
+	scene_close(&run);
+	return (failures ? 1 : 0);
+}
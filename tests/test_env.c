@@ -0,0 +1,163 @@
+#include "tests.h"
+
+#define ENV_TEST_COUNT 130
+#define ENV_TEST_WIDTH 24
+#define ENV_TEST_HEIGHT 16
+#define ENV_TEST_STEPS 40
+#define ENV_TEST_REPLAY 16
+
+/**
+ * step_batch - Steps a batch with the actions of a step number.
+ * @batch: The batch.
+ * @step: The number of the step, which picks the actions.
+ *
+ * Description: Environments walk and turn differently from one another
+ * and change their minds every few steps, so they spread over the map
+ * and run into walls.
+ */
+static void step_batch(env_batch_t *batch, int step)
+{
+	static env_action_t actions[ENV_TEST_COUNT];
+	int i;
+
+	for (i = 0; i < batch->count; i++)
+	{
+		actions[i].walk_direction = (i * 7 + step / 10) % 3 - 1;
+		actions[i].turn_direction = (i / 3 + i * 5 + step / 6) % 3 - 1;
+	}
+	env_batch_step(batch, actions, SCENE_DELTA_TIME, true);
+}
+
+/**
+ * states_differ - Compares the states of two sets of environments.
+ * @a: The first @count states.
+ * @b: The other @count states.
+ * @count: The number of environments.
+ *
+ * Return: The number of environments whose states differ.
+ */
+static int states_differ(const env_state_t *a, const env_state_t *b,
+		int count)
+{
+	int i, differ = 0;
+
+	for (i = 0; i < count; i++)
+		differ += a[i].step_count != b[i].step_count ||
+			memcmp(&a[i].player, &b[i].player,
+					sizeof(player_t)) != 0;
+	return (differ);
+}
+
+/**
+ * check_replay - Replays steps from snapshots of every environment.
+ * @batch: The batch, after @first steps.
+ * @first: The number of steps taken so far.
+ *
+ * Description: Restoring the snapshots must bring every state back, and
+ * stepping again with the same actions must reach the same states and
+ * observations as the first time.
+ *
+ * Return: The number of failed checks, or 1 if memory runs out.
+ */
+static int check_replay(env_batch_t *batch, int first)
+{
+	size_t size = sizeof(color_t) * ENV_TEST_WIDTH * ENV_TEST_HEIGHT *
+		batch->count;
+	env_state_t *saved = malloc(sizeof(env_state_t) * batch->count * 2);
+	color_t *frames = malloc(size);
+	int i, step, wrong = 1;
+
+	if (saved && frames)
+	{
+		for (i = 0; i < batch->count; i++)
+			env_batch_snapshot(batch, i, &saved[i]);
+		for (step = first; step < first + ENV_TEST_REPLAY; step++)
+			step_batch(batch, step);
+		memcpy(saved + batch->count, batch->states,
+				sizeof(env_state_t) * batch->count);
+		memcpy(frames, batch->observations, size);
+		for (i = 0; i < batch->count; i++)
+			env_batch_restore(batch, i, &saved[i]);
+		wrong = states_differ(batch->states, saved, batch->count);
+		for (step = first; step < first + ENV_TEST_REPLAY; step++)
+			step_batch(batch, step);
+		wrong += states_differ(batch->states, saved + batch->count,
+				batch->count) + (memcmp(frames,
+					batch->observations, size) != 0);
+	}
+	free(saved);
+	free(frames);
+	return (wrong);
+}
+
+/**
+ * check_scene - Steps batches of environments in the world of a scene.
+ * @scene: The scene.
+ * @pool: The thread pool of the threaded batch.
+ *
+ * Description: A batch stepped on @pool must reach exactly the states
+ * and observations of a batch stepped serially, with every environment
+ * taking each step, and snapshots must replay exactly.
+ *
+ * Return: The number of failed checks, or 1 if the batches cannot be
+ * set up.
+ */
+static int check_scene(const scene_t *scene, thread_pool_t *pool)
+{
+	static scene_run_t run;
+	env_batch_t threaded, serial;
+	size_t size = sizeof(color_t) * ENV_TEST_WIDTH * ENV_TEST_HEIGHT *
+		ENV_TEST_COUNT;
+	int i, step, wrong = 1;
+
+	memset(&threaded, 0, sizeof(threaded));
+	memset(&serial, 0, sizeof(serial));
+	if (scene_open(&run, scene) && env_batch_init(&threaded, &run.world,
+				pool, ENV_TEST_COUNT, ENV_TEST_WIDTH,
+				ENV_TEST_HEIGHT) && env_batch_init(&serial,
+				&run.world, NULL, ENV_TEST_COUNT,
+				ENV_TEST_WIDTH, ENV_TEST_HEIGHT))
+		for (step = 0, wrong = 0; step < ENV_TEST_STEPS; step++)
+		{
+			step_batch(&threaded, step);
+			step_batch(&serial, step);
+			wrong += states_differ(threaded.states, serial.states,
+					ENV_TEST_COUNT);
+			wrong += memcmp(threaded.observations,
+					serial.observations, size) != 0;
+			for (i = 0; i < ENV_TEST_COUNT; i++)
+				wrong += threaded.states[i].step_count !=
+					(unsigned long)step + 1;
+		}
+	wrong += wrong ? 0 : check_replay(&threaded, ENV_TEST_STEPS);
+	printf("%-16s %s\n", scene->name, wrong ? "FAILED" : "ok");
+	env_batch_free(&threaded);
+	env_batch_free(&serial);
+	scene_close(&run);
+	return (wrong);
+}
+
+/**
+ * main - Checks batches of environments in the worlds of the scenes.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	thread_pool_t pool;
+	int i, passed = 0, total = 0;
+
+	if (!thread_pool_init(&pool, 4))
+		return (1);
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		if (i > 0 && strcmp(test_scenes[i].map_file,
+					test_scenes[i - 1].map_file) == 0)
+			continue;
+		passed += !check_scene(&test_scenes[i], &pool);
+		total++;
+	}
+	thread_pool_destroy(&pool);
+	printf("%d of %d checks passed\n", passed, total);
+	return (passed == total ? 0 : 1);
+}
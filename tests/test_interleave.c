@@ -0,0 +1,151 @@
+#include "tests.h"
+
+#define MAX_MEAN_ERROR 32000
+
+/**
+ * frame_error - Measures how far a frame is from a reference frame.
+ * @frame: The frame.
+ * @reference: The reference frame, of the same size.
+ *
+ * Return: The mean absolute difference of the color channels, in
+ * 1/1000ths of a level.
+ */
+static long frame_error(const framebuffer_t *frame,
+		const framebuffer_t *reference)
+{
+	long i, size = (long)frame->width * frame->height, error = 0;
+	color_t a, b;
+	int shift, d;
+
+	for (i = 0; i < size; i++)
+	{
+		a = frame->pixels[i];
+		b = reference->pixels[i];
+		for (shift = 0; shift < 24; shift += 8)
+		{
+			d = (int)(a >> shift & 0xFF) - (int)(b >> shift & 0xFF);
+			error += d < 0 ? -d : d;
+		}
+	}
+	return (error * 1000 / (size * 3));
+}
+
+/**
+ * check_rays - Compares the reprojected rays of a frame with cast ones.
+ * @run: The interleaved run.
+ * @reference: The run casting every column.
+ *
+ * Description: A ray through a wall corner may hit either face, so only
+ * the hit points are compared, up to the error of a ray cast that far.
+ *
+ * Return: The number of reprojected columns that hit another point.
+ */
+static int check_rays(const scene_run_t *run, const scene_run_t *reference)
+{
+	const ray_buffer_t *rays = &run->view.rays;
+	const ray_buffer_t *cast = &reference->view.rays;
+	int col, wrong = 0;
+	float dx, dy, slack;
+
+	for (col = 0; col < rays->count; col++)
+	{
+		dx = fabs(rays->wall_hit_x[col] - cast->wall_hit_x[col]);
+		dy = fabs(rays->wall_hit_y[col] - cast->wall_hit_y[col]);
+		slack = 1 + cast->distance[col] / 4096;
+		if (run->view.history.source[col] >= 0 &&
+				(dx > slack || dy > slack))
+			wrong++;
+	}
+	return (wrong);
+}
+
+/**
+ * check_turn - Checks that a sharp turn casts every column again.
+ * @run: The interleaved run.
+ * @reference: The run casting every column, at the same pose.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_turn(scene_run_t *run, scene_run_t *reference)
+{
+	run->player.rotation_angle += FOV_ANGLE / 2;
+	reference->player.rotation_angle += FOV_ANGLE / 2;
+	cast_all_rays(&run->view);
+	render_view(&run->view);
+	cast_all_rays(&reference->view);
+	render_view(&reference->view);
+	if (run->view.history.reused != 0 ||
+			frame_hash(&run->view.frame) !=
+			frame_hash(&reference->view.frame))
+	{
+		printf("%s: a sharp turn reused %d columns\n",
+				run->scene->name, run->view.history.reused);
+		return (1);
+	}
+	return (0);
+}
+
+/**
+ * check_scene - Plays a scene interleaved next to a reference run.
+ * @scene: The scene.
+ * @step: The number of frames a column takes to be cast again.
+ *
+ * Description: Reprojected rays must hit what a cast ray hits, the
+ * frame must stay close to the reference, and once the camera stood
+ * still for @step frames every column was cast there, so the frame must
+ * be the reference frame.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_scene(const scene_t *scene, int step)
+{
+	scene_run_t run, ref;
+	int frame, still = 0, failures = 0, wrong = 0;
+	long error = 0, reused = 0;
+
+	if (!scene_open(&run, scene) || !scene_open(&ref, scene) ||
+			!view_set_interleave(&run.view, step))
+		return (1);
+	for (frame = 0; scene->script[frame]; frame++)
+	{
+		scene_step(&run, frame);
+		scene_step(&ref, frame);
+		still = scene->script[frame] == '.' ? still + 1 : 0;
+		if (still >= step && frame_hash(&run.view.frame) !=
+				frame_hash(&ref.view.frame))
+			printf("%s x%d: frame %d differs\n", scene->name, step,
+					frame), failures++;
+		wrong += check_rays(&run, &ref);
+		error += frame_error(&run.view.frame, &ref.view.frame);
+		reused += run.view.history.reused;
+	}
+	printf("%-16s x%d: %.2f reused, mean error %ld, %d wrong rays\n",
+			scene->name, step,
+			(double)reused / frame / scene->width, error / frame,
+			wrong);
+	failures += wrong > 0 || error / frame > MAX_MEAN_ERROR ||
+		reused * 5 < (long)frame * scene->width * 2;
+	failures += check_turn(&run, &ref);
+	scene_close(&run);
+	scene_close(&ref);
+	return (failures);
+}
+
+/**
+ * main - Checks interleaved rendering on the test scenes.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, failures = 0;
+
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		failures += check_scene(&test_scenes[i], 2);
+		failures += check_scene(&test_scenes[i], 4);
+	}
+	if (failures)
+		printf("%d interleaving checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
@@ -0,0 +1,70 @@
+#include "tests.h"
+
+/**
+ * check_uniform - Records latencies spread evenly from 1 us to 50 ms.
+ *
+ * Description: Each percentile must fall within a bucket of the exact
+ * one, and the mean and maximum must be exact.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_uniform(void)
+{
+	static latency_hist_t hist;
+	static const double fractions[] = {0.01, 0.5, 0.9, 0.99, 1};
+	uint64_t us, exact, found;
+	int i, wrong = 0;
+
+	for (us = 1; us <= 50000; us++)
+		latency_record(&hist, us);
+	for (i = 0; i < 5; i++)
+	{
+		exact = fractions[i] * 50000;
+		found = latency_percentile(&hist, fractions[i]);
+		wrong += found < exact || found > exact + LATENCY_BUCKET_US;
+	}
+	wrong += hist.count != 50000 || hist.max_us != 50000 ||
+		hist.total_us != 50000ul * 50001 / 2;
+	latency_report(&hist, "uniform", stdout);
+	return (wrong);
+}
+
+/**
+ * check_edges - Checks an empty distribution and one with outliers.
+ *
+ * Description: Latencies beyond the last bucket are counted in it, and
+ * percentiles reaching them report the longest latency.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_edges(void)
+{
+	static latency_hist_t hist;
+	int i, wrong;
+
+	wrong = latency_percentile(&hist, 0.5) != 0;
+	for (i = 0; i < 98; i++)
+		latency_record(&hist, 250);
+	latency_record(&hist, 2000000);
+	latency_record(&hist, 3000000);
+	wrong += latency_percentile(&hist, 0) != 300 ||
+		latency_percentile(&hist, 0.98) != 300 ||
+		latency_percentile(&hist, 0.99) != 3000000 ||
+		hist.buckets[LATENCY_BUCKETS - 1] != 2;
+	latency_report(&hist, "outliers", stdout);
+	return (wrong);
+}
+
+/**
+ * main - Checks the latency distributions.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int failures = check_uniform() + check_edges();
+
+	if (failures)
+		printf("%d latency checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
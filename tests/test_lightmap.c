@@ -0,0 +1,200 @@
+#include "tests.h"
+
+#define LIGHT_TEST_SOURCES 4
+#define LIGHT_TEST_FILE "/tmp/maze-test.lights"
+
+/**
+ * check_shade - Checks the multiply table of a lightmap.
+ * @lightmap: The lightmap.
+ *
+ * Return: The number of wrong entries: level 0 must give black, full
+ * light the texel itself, and channels must grow with the level.
+ */
+static int check_shade(const lightmap_t *lightmap)
+{
+	int level, c, failures = 0;
+
+	for (c = 0; c < 256; c++)
+	{
+		failures += lightmap->shade[0][c] != 0 ||
+			lightmap->shade[LIGHT_FULL][c] != c;
+		for (level = 1; level < LIGHT_LEVELS; level++)
+			failures += lightmap->shade[level][c] <
+				lightmap->shade[level - 1][c];
+	}
+	return (failures);
+}
+
+/**
+ * check_lights - Compares a lit lightmap with an ambient one.
+ * @lit: The lightmap baked with @lights.
+ * @dark: The lightmap of the same map baked without lights.
+ * @map: The map.
+ * @lights: The lights of @lit.
+ *
+ * Description: A cell out of reach or out of sight of every light must
+ * keep its ambient level, and a cell a light sees well within its radius
+ * must be brighter. Ambient levels stay below LIGHT_FULL, so no light
+ * saturates them unnoticed.
+ *
+ * Return: The number of wrong cells.
+ */
+static int check_lights(const lightmap_t *lit, const lightmap_t *dark,
+		const map_t *map, const light_t *lights)
+{
+	long cell, size = (long)map->rows * map->cols;
+	int i, r, c, row, col, near, seen, failures = 0;
+	float dx, dy, reach;
+
+	for (cell = 0; cell < size; cell++)
+	{
+		r = cell / map->cols;
+		c = cell % map->cols;
+		near = seen = 0;
+		for (i = 0; i < LIGHT_TEST_SOURCES; i++)
+		{
+			row = lights[i].y / TILE_SIZE;
+			col = lights[i].x / TILE_SIZE;
+			dx = (c + 0.5f) * TILE_SIZE - lights[i].x;
+			dy = (r + 0.5f) * TILE_SIZE - lights[i].y;
+			reach = lights[i].radius * lights[i].radius;
+			if (lights[i].x < 0 || lights[i].y < 0 ||
+					row >= map->rows || col >= map->cols ||
+					get_map_at(row, col, map) ||
+					dx * dx + dy * dy >= reach ||
+					!map_line_of_sight(map, row, col, r, c))
+				continue;
+			seen = 1;
+			near |= dx * dx + dy * dy < 0.8f * reach;
+		}
+		failures += near ? lit->cells[cell] <= dark->cells[cell] :
+			seen ? lit->cells[cell] < dark->cells[cell] :
+			lit->cells[cell] != dark->cells[cell];
+	}
+	return (failures);
+}
+
+/**
+ * check_walls - Checks the light levels of every wall column of a scene.
+ * @run: The scene, lit.
+ *
+ * Description: Every baked cell and corner, and every column, must get a
+ * level within range; the whole script is played so hits at map edges
+ * and corners are covered.
+ *
+ * Return: The number of levels out of range.
+ */
+static int check_walls(scene_run_t *run)
+{
+	long i, corners = (long)(run->map.rows + 1) * (run->map.cols + 1);
+	int frame, col, level, failures = 0;
+
+	for (i = 0; i < corners; i++)
+		failures += run->lightmap.corners[i] > LIGHT_FULL ||
+			(i < (long)run->map.rows * run->map.cols &&
+			 run->lightmap.cells[i] > LIGHT_FULL);
+
+	for (frame = 0; run->scene->script[frame]; frame++)
+	{
+		scene_step(run, frame);
+		for (col = 0; col < run->view.rays.count; col++)
+		{
+			level = lightmap_wall_level(&run->lightmap,
+					&run->view.rays, col);
+			failures += level < 0 || level > LIGHT_FULL;
+		}
+	}
+	return (failures);
+}
+
+/**
+ * check_scene - Bakes a scene's map with and without lights.
+ * @scene: A lit scene.
+ *
+ * Description: The map is also baked with a single negative light, as
+ * code other than the lights file can build.
+ *
+ * Return: The number of failed checks, or 1 if the scene or a lightmap
+ * could not be set up.
+ */
+static int check_scene(const scene_t *scene)
+{
+	light_t lights[LIGHT_TEST_SOURCES];
+	lightmap_t dark;
+	scene_run_t run;
+	int i, failures;
+
+	if (!scene_open(&run, scene))
+		return (1);
+	if (!lightmap_build(&dark, &run.map, NULL, 0, LIGHT_AMBIENT))
+	{
+		scene_close(&run);
+		return (1);
+	}
+	for (i = 0; i < LIGHT_TEST_SOURCES; i++)
+	{
+		lights[i].x = scene->x + (i % 2 ? 3 : -2) * i * TILE_SIZE;
+		lights[i].y = scene->y + (i / 2 ? 2 : -1) * i * TILE_SIZE;
+		lights[i].radius = (3 + 2 * i) * TILE_SIZE;
+		lights[i].level = 20 + 10 * i;
+	}
+	lightmap_free(&run.lightmap);
+	failures = !lightmap_build(&run.lightmap, &run.map, lights,
+			LIGHT_TEST_SOURCES, LIGHT_AMBIENT) ||
+		check_shade(&run.lightmap) ||
+		check_lights(&run.lightmap, &dark, &run.map, lights) ||
+		check_walls(&run);
+	/* A negative light darkens down to black, never wrapping around */
+	lights[0].level = -100;
+	lightmap_free(&run.lightmap);
+	failures += !lightmap_build(&run.lightmap, &run.map, lights, 1,
+			LIGHT_AMBIENT) || check_walls(&run);
+	lightmap_free(&dark);
+	scene_close(&run);
+	return (failures);
+}
+
+/**
+ * main - Checks the lightmaps of the lit test scenes.
+ *
+ * Description: A lights file with a level out of range must be rejected
+ * as malformed.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	static const char * const levels[] = {"-100", "64", "63"};
+	light_t lights[LIGHT_TEST_SOURCES];
+	int i, failures, passed = 0, total = 0;
+	FILE *file;
+
+	for (i = 0; i < 3; i++)
+	{
+		file = fopen(LIGHT_TEST_FILE, "w");
+		if (file)
+		{
+			fprintf(file, "1.5 1.5 3 %s\n", levels[i]);
+			fclose(file);
+		}
+		failures = lightmap_load_lights(LIGHT_TEST_FILE, lights,
+				LIGHT_TEST_SOURCES) != (i < 2 ? -1 : 1);
+		printf("level %-10s %s\n", levels[i],
+				failures ? "FAILED" : "ok");
+		passed += !failures;
+		total++;
+	}
+	remove(LIGHT_TEST_FILE);
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		if (!test_scenes[i].lit)
+			continue;
+		failures = check_scene(&test_scenes[i]);
+		printf("%-16s %s\n", test_scenes[i].name,
+				failures ? "FAILED" : "ok");
+		passed += !failures;
+		total++;
+	}
+	printf("%d of %d checks passed\n", passed, total);
+	return (passed == total ? 0 : 1);
+}
@@ -0,0 +1,203 @@
+#include "tests.h"
+
+#define NAV_TEST_QUERIES 64
+#define NAV_TEST_ROUNDS 6
+#define NAV_TEST_TOGGLES 24
+
+/**
+ * path_cost - Walks a path found by nav_find_path() cell by cell.
+ * @search: The search holding the path.
+ * @map: The map the path was found in.
+ *
+ * Return: The cost of the path, or NAV_UNREACHABLE if two consecutive
+ * cells are not joined by a straight or diagonal run of legal steps.
+ */
+static uint32_t path_cost(const nav_search_t *search, const map_t *map)
+{
+	static const int directions[3][3] = {
+		{5, 6, 7}, {4, NAV_NONE, 0}, {3, 2, 1}
+	};
+	int i, cell, dr, dc, d;
+	uint32_t cost = 0;
+
+	for (i = 1; i < search->path_count; i++)
+	{
+		cell = search->path[i - 1];
+		dr = search->path[i] / map->cols - cell / map->cols;
+		dc = search->path[i] % map->cols - cell % map->cols;
+		if (dr != 0 && dc != 0 && abs(dr) != abs(dc))
+			return (NAV_UNREACHABLE);
+		d = directions[(dr > 0) - (dr < 0) + 1]
+			[(dc > 0) - (dc < 0) + 1];
+		while (d != NAV_NONE && cell >= 0 && cell != search->path[i])
+		{
+			cell = nav_neighbor(map, cell, d);
+			cost += d & 1 ? NAV_DIAGONAL_COST : NAV_STRAIGHT_COST;
+		}
+		if (cell < 0 || d == NAV_NONE)
+			return (NAV_UNREACHABLE);
+	}
+	return (cost);
+}
+
+/**
+ * check_paths - Compares jump point search with a flow field.
+ * @field: The computed flow field.
+ * @search: The memory of the searches.
+ * @seed: The seed picking the start cells.
+ *
+ * Description: Every reachable cell but the goal must step to a
+ * neighbour costing exactly one step less, and paths from random cells
+ * must cost what the field says.
+ *
+ * Return: The number of cells failing either check.
+ */
+static int check_paths(const nav_field_t *field, nav_search_t *search,
+		uint64_t seed)
+{
+	long cell, size = (long)field->map->rows * field->map->cols;
+	int i, d, next, failures = 0;
+	uint32_t cost, expected;
+
+	for (cell = 0; cell < size; cell++)
+	{
+		d = field->direction[cell];
+		if (field->cost[cell] == NAV_UNREACHABLE || cell == field->goal)
+			continue;
+		next = d == NAV_NONE ? -1 : nav_neighbor(field->map, cell, d);
+		failures += next < 0 || field->cost[cell] != field->cost[next] +
+			(d & 1 ? NAV_DIAGONAL_COST : NAV_STRAIGHT_COST);
+	}
+	for (i = 0; i < NAV_TEST_QUERIES; i++)
+	{
+		cell = mazegen_hash(seed, i, 1) % size;
+		cost = nav_find_path(search, field->map, cell, field->goal) ?
+			path_cost(search, field->map) : NAV_UNREACHABLE;
+		expected = field->cost[cell];
+		if (field->map->cells[cell] == 0 && cost != expected &&
+				failures++ == 0)
+			fprintf(stderr, "path %ld to %d costs %u, not %u\n",
+					cell, field->goal, cost, expected);
+	}
+	return (failures);
+}
+
+/**
+ * check_updates - Toggles walls and compares updated and fresh fields.
+ * @map: The map, modified and restored.
+ * @field: A computed flow field over @map.
+ * @fresh: A second flow field over @map, recomputed to compare.
+ * @search: The memory of the searches.
+ *
+ * Description: Even rounds toggle random cells, odd rounds toggle them
+ * back, so both new walls and new openings are repaired. The last two
+ * rounds, one of each kind, are checked against a field computed from
+ * scratch and against path searches on the changed map.
+ *
+ * Return: The number of failed checks, or -1 if memory allocation
+ * failed.
+ */
+static int check_updates(map_t *map, nav_field_t *field, nav_field_t *fresh,
+		nav_search_t *search)
+{
+	int cells[NAV_TEST_TOGGLES], round, i, row, col, failures = 0;
+
+	fresh->goal = field->goal;
+	for (round = 0; round < 2 * NAV_TEST_ROUNDS; round++)
+	{
+		for (i = 0; i < NAV_TEST_TOGGLES; i++)
+		{
+			if (round % 2 == 0)
+			{
+				row = 1 + mazegen_hash(map->rows, round, i) %
+					(map->rows - 2);
+				col = 1 + mazegen_hash(map->cols, i, round) %
+					(map->cols - 2);
+				cells[i] = row * map->cols + col;
+			}
+			map->cells[cells[i]] = !map->cells[cells[i]];
+		}
+		if (!nav_field_update(field, cells, NAV_TEST_TOGGLES))
+			return (-1);
+		if (round < 2 * NAV_TEST_ROUNDS - 2)
+			continue;
+		if (!nav_field_compute(fresh))
+			return (-1);
+		failures += check_paths(field, search, round) +
+			(memcmp(field->cost, fresh->cost, sizeof(uint32_t) *
+				map->rows * map->cols) != 0);
+	}
+	return (failures);
+}
+
+/**
+ * open_fields - Loads a map and computes two flow fields over it.
+ * @map: Receives the map.
+ * @file: The map file.
+ * @fields: Receives a field to the open cell nearest the top left corner
+ * and one to the open cell nearest the center.
+ * @pool: The thread pool computing the fields.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool open_fields(map_t *map, const char *file, nav_field_t *fields,
+		thread_pool_t *pool)
+{
+	float x, y;
+	int k;
+
+	memset(map, 0, sizeof(*map));
+	memset(fields, 0, 2 * sizeof(nav_field_t));
+	if (!parse_map_from_file(file, map))
+		return (false);
+	for (k = 0; k < 2; k++)
+	{
+		x = (k ? map->cols / 2 + 0.5f : 1.5f) * TILE_SIZE;
+		y = (k ? map->rows / 2 + 0.5f : 1.5f) * TILE_SIZE;
+		if (!map_find_open_cell(&x, &y, map) ||
+				!nav_field_init(&fields[k], map,
+					(int)(y / TILE_SIZE) * map->cols +
+					x / TILE_SIZE))
+			return (false);
+	}
+	return (nav_fields_compute(pool, fields, 2));
+}
+
+/**
+ * main - Checks flow fields and jump point search on the test maps.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	thread_pool_t pool;
+	nav_field_t fields[2];
+	nav_search_t search;
+	map_t map;
+	int i, failures, passed = 0, total = 0;
+
+	memset(&search, 0, sizeof(search));
+	if (!thread_pool_init(&pool, 2))
+		return (1);
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		if (i > 0 && strcmp(test_scenes[i].map_file,
+					test_scenes[i - 1].map_file) == 0)
+			continue;
+		failures = !open_fields(&map, test_scenes[i].map_file, fields,
+				&pool) || check_paths(&fields[0], &search, i) ||
+			check_paths(&fields[1], &search, ~i) ||
+			check_updates(&map, &fields[1], &fields[0], &search);
+		printf("%-16s %s\n", test_scenes[i].name,
+				failures ? "FAILED" : "ok");
+		passed += !failures;
+		total++;
+		nav_field_free(&fields[0]);
+		nav_field_free(&fields[1]);
+		map_free(&map);
+	}
+	thread_pool_destroy(&pool);
+	nav_search_free(&search);
+	printf("%d of %d maps passed\n", passed, total);
+	return (passed == total ? 0 : 1);
+}
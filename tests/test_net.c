@@ -0,0 +1,223 @@
+#include "tests.h"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <time.h>
+
+#define NET_TEST_RATE 30.0f
+#define NET_TEST_TICKS 600
+#define NET_TEST_MAX_ERROR 40.0
+#define NET_TEST_MEAN_ERROR 0.25
+
+/**
+ * session_open - Starts a server and connects clients to it.
+ * @session: Receives the session.
+ * @map: The map the players move in.
+ * @count: The number of clients.
+ * @network: The loss, latency and jitter of every link.
+ *
+ * Return: True on success, false if a socket cannot be opened.
+ */
+static bool session_open(net_session_t *session, const map_t *map,
+		int count, const double *network)
+{
+	struct sockaddr_in addr;
+	socklen_t length = sizeof(addr);
+	net_link_t *link;
+	int i;
+
+	memset(session, 0, sizeof(*session));
+	session->count = count;
+	if (!net_server_init(&session->server, map, 0, NET_TEST_RATE) ||
+			getsockname(session->server.link.fd,
+				(struct sockaddr *)&addr, &length) != 0)
+		return (false);
+	for (i = 0; i <= count; i++)
+	{
+		link = i < count ? &session->clients[i].link :
+			&session->server.link;
+		if (i < count && !net_client_init(&session->clients[i],
+					"127.0.0.1", ntohs(addr.sin_port),
+					NET_TEST_RATE))
+			return (false);
+		link->loss = network[0];
+		link->latency = network[1];
+		link->jitter = network[2];
+		link->seed += i * 7919;
+	}
+	return (true);
+}
+
+/**
+ * session_check - Checks where a client draws its player.
+ * @session: The session.
+ * @client: The client.
+ * @now: The time to draw at, in seconds.
+ *
+ * Description: The pose must be close to the server's at the tick the
+ * client draws, blended between the two ticks around it. Lost snapshots
+ * are bridged by a straight line, which strays from the path by up to
+ * the 25 units a wall collision slides the player in one tick.
+ */
+static void session_check(net_session_t *session, const net_client_t *client,
+		double now)
+{
+	const net_snapshot_t *history = session->server.history;
+	const net_entity_t *a, *b;
+	player_t player;
+	double tick, error;
+	uint32_t t;
+
+	tick = client->latest + (now - client->latest_time) * NET_TEST_RATE -
+		NET_INTERP_TICKS;
+	t = tick < 1 ? 0 : (uint32_t)tick;
+	a = &history[t % NET_HISTORY].entities[client->slot];
+	b = &history[(t + 1) % NET_HISTORY].entities[client->slot];
+	if (t < 1 || history[t % NET_HISTORY].tick != t ||
+			history[(t + 1) % NET_HISTORY].tick != t + 1 ||
+			!a->active || !b->active)
+		return;
+	if (!net_client_interpolate(client, client->slot, now, &player))
+	{
+		session->wrong++;
+		return;
+	}
+	tick -= t;
+	error = hypot(player.x - (a->x + ((double)b->x - a->x) * tick) /
+			NET_POSITION_SCALE,
+			player.y - (a->y + ((double)b->y - a->y) * tick) /
+			NET_POSITION_SCALE);
+	session->max_error = error > session->max_error ? error :
+		session->max_error;
+	session->total_error += error;
+	session->poses++;
+}
+
+/**
+ * session_step - Plays one tick: inputs, simulation, then snapshots.
+ * @session: The session.
+ * @tick: The number of the tick, which picks the inputs.
+ *
+ * Description: The newest snapshot of each client must decode to exactly
+ * the server's, and its player is checked on the tick and half-way to
+ * the next one.
+ *
+ * Return: The time the server took, in seconds.
+ */
+static double session_step(net_session_t *session, int tick)
+{
+	struct timespec start, end;
+	const net_snapshot_t *snapshot;
+	const net_client_t *client;
+	env_action_t action;
+	int i, polled;
+
+	for (i = 0; i < session->count; i++)
+	{
+		action.walk_direction = (tick / 90 + i) % 3 ? 1 : -1;
+		action.turn_direction = (tick / (12 + i) + i) % 3 - 1;
+		net_client_send(&session->clients[i], &action, session->now);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	net_server_tick(&session->server, session->now);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	for (i = 0; i < session->count; i++)
+	{
+		polled = net_client_poll(&session->clients[i], session->now);
+		session->snapshots += polled > 0 ? polled : 0;
+		client = &session->clients[i];
+		snapshot = &session->server.history[client->latest %
+			NET_HISTORY];
+		session->wrong += snapshot->tick == client->latest &&
+			memcmp(snapshot, &client->history[client->latest %
+					NET_HISTORY], sizeof(*snapshot)) != 0;
+		session_check(session, client, session->now);
+		session_check(session, client,
+				session->now + 0.5 / NET_TEST_RATE);
+	}
+	session->now += 1 / NET_TEST_RATE;
+	return ((end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) /
+			1e9);
+}
+
+/**
+ * check_network - Plays a session and checks the snapshots and poses.
+ * @name: The name of the case.
+ * @map: The map the players move in.
+ * @count: The number of clients.
+ * @network: The loss, latency and jitter of every link.
+ *
+ * Description: Every client must decode the server's snapshots exactly
+ * and draw its player near the server's, deltas must cost less than
+ * whole snapshots, and leaving must free the slots. A bye the server
+ * sends itself, from an address it does not know, must not take one.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_network(const char *name, const map_t *map, int count,
+		const double *network)
+{
+	static net_session_t session;
+	unsigned char data[NET_MAX_PACKET];
+	double seconds = 0, sent, mean;
+	int tick, full, i, failures;
+
+	if (!session_open(&session, map, count, network))
+		return (1);
+	for (tick = 0; tick < NET_TEST_TICKS; tick++)
+		seconds += session_step(&session, tick);
+	full = net_snapshot_encode(&session.server.history[session.server.tick
+			% NET_HISTORY], NULL, 0, data);
+	for (i = 0, sent = 0; i < count; i++)
+		sent += session.server.peers[i].sent_bytes;
+	sent /= (double)count * NET_TEST_TICKS;
+	mean = session.poses ? session.total_error / session.poses : 0;
+	printf("%-7s %2d clients: %5.1f bytes/client/tick (%d whole), "
+			"%6.0f ticks/s, %lu snapshots, %lu wrong, error %.2f "
+			"mean %.2f max\n", name, count, sent, full,
+			NET_TEST_TICKS / seconds, session.snapshots,
+			session.wrong, mean, session.max_error);
+	failures = session.wrong > 0 ||
+		session.max_error > NET_TEST_MAX_ERROR ||
+		mean > NET_TEST_MEAN_ERROR || !session.poses ||
+		sent >= full ||
+		session.snapshots < (unsigned long)count * NET_TEST_TICKS / 2;
+	for (i = 0; i < count; i++)
+		net_client_free(&session.clients[i]);
+	session.server.link.loss = session.server.link.latency =
+		session.server.link.jitter = 0;
+	net_server_tick(&session.server, session.now + 1);
+	for (i = 0; i < count; i++)
+		failures += session.server.peers[i].connected;
+	data[0] = NET_MSG_BYE;
+	net_link_send(&session.server.link, &session.clients[0].server, data,
+			1, session.now + 1);
+	net_server_tick(&session.server, session.now + 2);
+	failures += session.server.peers[0].addr.sin_port ==
+		session.clients[0].server.sin_port;
+	net_server_free(&session.server);
+	return (failures);
+}
+
+/**
+ * main - Checks the server and clients over the loopback.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	static const double perfect[3] = {0, 0, 0};
+	static const double bad[3] = {0.1, 0.05, 0.03};
+	map_t map;
+	int failures = 0;
+
+	if (!parse_map_from_file("./tests/maps/gen_braided.txt", &map))
+		return (1);
+	failures += check_network("perfect", &map, 4, perfect);
+	failures += check_network("lossy", &map, 4, bad);
+	failures += check_network("crowded", &map, NET_MAX_PLAYERS, perfect);
+	failures += check_network("crowded", &map, NET_MAX_PLAYERS, bad);
+	map_free(&map);
+	if (failures)
+		printf("%d network checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
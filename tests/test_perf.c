@@ -0,0 +1,125 @@
+#include "tests.h"
+
+#define BUSY_LOOPS 2000000
+
+/**
+ * check_scene - Renders a scene with and without counters.
+ * @scene: The scene.
+ * @perf: The counters, which may not be active.
+ * @interleave: The interleave factor of both views.
+ *
+ * Description: A view with counters draws the floor, ceiling and walls
+ * in separate passes, which must give the same frames and counters.
+ * Moving and casting are not marked, so they count as the floor.
+ *
+ * Return: The number of frames that differ, or 1 if the scene cannot be
+ * opened.
+ */
+static int check_scene(const scene_t *scene, perf_counters_t *perf,
+		int interleave)
+{
+	scene_run_t counted, plain;
+	int frame, wrong = 0;
+
+	if (!scene_open(&counted, scene) || !scene_open(&plain, scene) ||
+			!view_set_interleave(&counted.view, interleave) ||
+			!view_set_interleave(&plain.view, interleave))
+	{
+		printf("%s: cannot open the scene\n", scene->name);
+		return (1);
+	}
+	counted.view.perf = perf;
+	for (frame = 0; scene->script[frame]; frame++)
+	{
+		scene_step(&plain, frame);
+		perf_mark(perf, PERF_STAGE_INPUT);
+		scene_step(&counted, frame);
+		perf_frame_end(perf, NULL);
+		wrong += frame_hash(&counted.view.frame) !=
+			frame_hash(&plain.view.frame) || memcmp(
+				&counted.view.stats, &plain.view.stats,
+				sizeof(frame_stats_t)) != 0;
+	}
+	printf("%s, interleave %d: %d frames differ\n", scene->name,
+			interleave, wrong);
+	scene_close(&counted);
+	scene_close(&plain);
+	return (wrong);
+}
+
+/**
+ * check_marks - Checks that work is charged to the stage doing it.
+ * @perf: The counters, which are active.
+ *
+ * Description: A busy loop is marked as the cast stage, with nothing
+ * marked as the move stage before it; the frame is then logged.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_marks(perf_counters_t *perf)
+{
+	static volatile unsigned long sink;
+	uint64_t frames = perf->frames;
+	char line[256];
+	FILE *log = tmpfile();
+	int i, lines = 0, wrong;
+
+	perf_mark(perf, PERF_STAGE_INPUT);
+	perf_mark(perf, PERF_STAGE_MOVE);
+	for (i = 0; i < BUSY_LOOPS; i++)
+		sink += i;
+	perf_mark(perf, PERF_STAGE_CAST);
+	wrong = perf->frame[PERF_STAGE_CAST][PERF_TASK_CLOCK] <=
+		perf->frame[PERF_STAGE_MOVE][PERF_TASK_CLOCK];
+	if (perf->slots[PERF_INSTRUCTIONS] >= 0)
+		wrong += perf->frame[PERF_STAGE_CAST][PERF_INSTRUCTIONS] <
+			BUSY_LOOPS || perf->frame[PERF_STAGE_MOVE][
+			PERF_INSTRUCTIONS] > BUSY_LOOPS / 100;
+	perf_frame_end(perf, log);
+	wrong += perf->frames != frames + 1 ||
+		perf->frame[PERF_STAGE_CAST][PERF_TASK_CLOCK] != 0 || !log;
+	if (log)
+	{
+		rewind(log);
+		while (fgets(line, sizeof(line), log))
+			lines++;
+		fclose(log);
+	}
+	wrong += lines != (frames ? 0 : 1) + PERF_STAGES;
+	return (wrong);
+}
+
+/**
+ * main - Checks the per-stage counters.
+ *
+ * Description: Where counters cannot be opened, as in many containers
+ * and virtual machines, marks must change nothing, and the scenes are
+ * still drawn in separate passes.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	static perf_counters_t perf;
+	perf_counters_t idle;
+	int i, failures = 0;
+
+	if (perf_init(&perf))
+		failures += check_marks(&perf);
+	else
+	{
+		idle = perf;
+		perf_mark(NULL, PERF_STAGE_CAST);
+		perf_mark(&perf, PERF_STAGE_CAST);
+		perf_frame_end(&perf, NULL);
+		failures += memcmp(&idle, &perf, sizeof(perf)) != 0;
+	}
+	for (i = 0; i < num_test_scenes; i++)
+		failures += check_scene(&test_scenes[i], &perf, 1);
+	failures += check_scene(&test_scenes[0], &perf, 2);
+	perf_close(&perf);
+	perf_report(&perf, stdout);
+	if (failures)
+		printf("%d counter checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
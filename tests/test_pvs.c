@@ -0,0 +1,202 @@
+#include "tests.h"
+
+#define PVS_TEST_SOURCES 48
+#define PVS_TEST_FILE "./tests/maps/test.pvs"
+
+/**
+ * line_of_sight - Checks if the centers of two cells see each other.
+ * @map: The map.
+ * @r0: The row of the first cell.
+ * @c0: The column of the first cell.
+ * @r1: The row of the second cell.
+ * @c1: The column of the second cell.
+ *
+ * Description: Independent of the engine: every cell between the two is
+ * tested against the segment, in coordinates doubled so cell corners and
+ * centers are integers. A wall blocks if the segment enters it, and a
+ * corner the segment goes through blocks if both cells beside it are
+ * walls.
+ *
+ * Return: True if nothing blocks the segment.
+ */
+static bool line_of_sight(const map_t *map, int r0, int c0, int r1, int c1)
+{
+	long dx = 2 * (c1 - c0), dy = 2 * (r1 - r0), x, y, base, dot, cross;
+	int top = r0 < r1 ? r0 : r1, left = c0 < c1 ? c0 : c1, r, c, i, k;
+	int width = abs(c1 - c0) + 1, count = (abs(r1 - r0) + 1) * width;
+	int pos, neg;
+
+	for (i = 0; i < count; i++)
+	{
+		r = top + i / width;
+		c = left + i % width;
+		x = 2 * (c - c0) + 1;
+		y = 2 * (r - r0) + 1;
+		base = dx * y - dy * x;
+		dot = dx * x + dy * y;
+		if (base == 0 && dot > 0 && dot < dx * dx + dy * dy &&
+				get_map_at(r + (dy > 0), c + (dx < 0), map) &&
+				get_map_at(r + (dy < 0), c + (dx > 0), map))
+			return (false);
+		if ((r == r0 && c == c0) || (r == r1 && c == c1))
+			continue;
+		for (k = pos = neg = 0; k < 4; k++)
+		{
+			cross = base - dx * (k & 2) + dy * (k << 1 & 2);
+			pos |= cross > 0;
+			neg |= cross < 0;
+		}
+		if (pos && neg && get_map_at(r, c, map))
+			return (false);
+	}
+	return (true);
+}
+
+/**
+ * check_window - Compares a visibility set with lines of sight from a cell.
+ * @pvs: The visibility set.
+ * @map: The map it was built from.
+ * @s: The index of the source cell.
+ * @visible: Receives the number of clusters pvs_visible() accepts.
+ *
+ * Description: Every cell of the clusters in range of the cluster of @s
+ * is compared. With one cell per cluster the set must match exactly;
+ * with larger clusters it must at least contain every line of sight.
+ *
+ * Return: The number of mismatches.
+ */
+static int check_window(const pvs_t *pvs, const map_t *map, int s,
+		int *visible)
+{
+	int mask = (1 << pvs->shift) - 1, reach = pvs->radius << pvs->shift;
+	int top = (s / map->cols & ~mask) - reach, r, c, failures = 0;
+	int left = (s % map->cols & ~mask) - reach, i, count, width;
+	bool sight, seen;
+
+	width = (2 * reach) + mask + 1;
+	count = width * width;
+	*visible = 0;
+	for (i = 0; i < count; i++)
+	{
+		r = top + i / width;
+		c = left + i % width;
+		if (r < 0 || r >= map->rows || c < 0 || c >= map->cols)
+			continue;
+		sight = (!map->cells[s] || !get_map_at(r, c, map)) &&
+			line_of_sight(map, s / map->cols, s % map->cols, r, c);
+		seen = pvs_visible(pvs, s, r * map->cols + c);
+		failures += seen != sight && (sight || !pvs->shift);
+		*visible += seen && !(r & mask) && !(c & mask);
+	}
+	return (failures);
+}
+
+/**
+ * check_sources - Compares a visibility set with lines of sight.
+ * @pvs: The visibility set.
+ * @map: The map it was built from.
+ * @seed: The seed picking the source cells.
+ *
+ * Description: From random cells, the window in range is compared with
+ * check_window(), and pvs_list() must list the clusters pvs_visible()
+ * accepts. A cell just past the radius must count as visible.
+ *
+ * Return: The number of mismatches, or -1 if memory allocation failed.
+ */
+static int check_sources(const pvs_t *pvs, const map_t *map, uint64_t seed)
+{
+	int *clusters = malloc(sizeof(int) * pvs->window * pvs->window);
+	int i, s, listed, visible, row, col, failures = 0;
+
+	for (i = 0; clusters && i < PVS_TEST_SOURCES; i++)
+	{
+		s = mazegen_hash(seed, i, 0) % ((long)map->rows * map->cols);
+		failures += check_window(pvs, map, s, &visible);
+		listed = pvs_list(pvs, s, clusters);
+		failures += listed != visible;
+		while (listed-- > 0)
+		{
+			row = clusters[listed] / pvs->cluster_cols;
+			col = clusters[listed] % pvs->cluster_cols;
+			row <<= pvs->shift;
+			col <<= pvs->shift;
+			failures += !pvs_visible(pvs, s, row * map->cols + col);
+		}
+		row = s / map->cols + ((pvs->radius + 1) << pvs->shift);
+		if (row < map->rows)
+			failures += !pvs_visible(pvs, s, row * map->cols +
+					s % map->cols);
+	}
+	free(clusters);
+	return (clusters ? failures : -1);
+}
+
+/**
+ * check_file - Checks that a visibility set survives a round trip.
+ * @pvs: The visibility set.
+ * @map: The map it was built from, changed and restored.
+ *
+ * Description: The saved set must load identical, be rejected once a
+ * wall moves, and pvs_open() must rebuild it for another radius.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_file(const pvs_t *pvs, map_t *map)
+{
+	size_t bytes = pvs->row_bytes * pvs->cluster_rows * pvs->cluster_cols;
+	int failures = !pvs_save(pvs, PVS_TEST_FILE);
+	pvs_t loaded;
+
+	failures += !pvs_load(&loaded, PVS_TEST_FILE, map) ||
+		memcmp(loaded.bits, pvs->bits, bytes) != 0;
+	pvs_free(&loaded);
+	map->cells[map->cols + 1] = !map->cells[map->cols + 1];
+	failures += pvs_load(&loaded, PVS_TEST_FILE, map);
+	pvs_free(&loaded);
+	map->cells[map->cols + 1] = !map->cells[map->cols + 1];
+	failures += !pvs_open(&loaded, PVS_TEST_FILE, map, pvs->shift, 1) ||
+		loaded.radius != 1;
+	pvs_free(&loaded);
+	failures += !pvs_load(&loaded, PVS_TEST_FILE, map) ||
+		loaded.radius != 1;
+	pvs_free(&loaded);
+	remove(PVS_TEST_FILE);
+	return (failures);
+}
+
+/**
+ * main - Checks visibility sets on the test maps.
+ *
+ * Description: Maps up to 64 cells high get an exact set, larger ones
+ * clusters of 4x4 or 8x8 cells; the radius covers 16 cells.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, shift, failures, passed = 0, total = 0;
+	pvs_t pvs;
+	map_t map;
+
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		if (i > 0 && strcmp(test_scenes[i].map_file,
+					test_scenes[i - 1].map_file) == 0)
+			continue;
+		memset(&map, 0, sizeof(map));
+		memset(&pvs, 0, sizeof(pvs));
+		failures = !parse_map_from_file(test_scenes[i].map_file, &map);
+		shift = map.rows <= 64 ? 0 : map.rows <= 600 ? 2 : 3;
+		failures = failures || !pvs_build(&pvs, &map, shift,
+				16 >> shift) || check_sources(&pvs, &map, i) ||
+			check_file(&pvs, &map);
+		printf("%-16s %s\n", test_scenes[i].name,
+				failures ? "FAILED" : "ok");
+		passed += !failures;
+		total++;
+		pvs_free(&pvs);
+		map_free(&map);
+	}
+	printf("%d of %d maps passed\n", passed, total);
+	return (passed == total ? 0 : 1);
+}
@@ -0,0 +1,185 @@
+#include "tests.h"
+#include <unistd.h>
+
+#define RELOAD_TEST_FILE "./tests/maps/reload.txt"
+#define RELOAD_TEST_OTHER "./tests/maps/reload_other.txt"
+#define RELOAD_TEST_LIGHTS 4
+#define RELOAD_TEST_EDITS 40
+
+/**
+ * reload_from - Writes a map file and reloads a map from it.
+ * @live: The map to reload.
+ * @written: The map written to the file, or NULL for a malformed file.
+ * @reload: The reload, zeroed or already polled.
+ *
+ * Return: True if the reload changed @live, false otherwise.
+ */
+static bool reload_from(map_t *live, const map_t *written,
+		map_reload_t *reload)
+{
+	FILE *file = fopen(RELOAD_TEST_FILE, "w");
+	long cell, size = written ? (long)written->rows * written->cols : 0;
+	bool applied;
+
+	if (!file)
+		return (false);
+	for (cell = 0; cell < size; cell++)
+		fprintf(file, "%d%c", written->cells[cell],
+				(cell + 1) % written->cols ? ' ' : '\n');
+	fputs(written ? "" : "1 x\n", file);
+	if (fclose(file) != 0 ||
+			!map_reload_start(reload, RELOAD_TEST_FILE, live) ||
+			map_reload_start(reload, RELOAD_TEST_FILE, live))
+		return (false);
+	while (!(applied = map_reload_poll(reload, live)) && reload->running)
+		usleep(1000);
+	return (applied);
+}
+
+/**
+ * edit_map - Places lights on a map and moves walls around them.
+ * @map: The map to edit.
+ * @lights: Receives RELOAD_TEST_LIGHTS lights, placed before the edits.
+ * @seed: The seed picking the lights and the edits.
+ *
+ * Description: Most edits open or close cells close to a light, the
+ * others anywhere on the map, and a cell may be edited twice.
+ */
+static void edit_map(map_t *map, light_t *lights, uint64_t seed)
+{
+	long cell, size = (long)map->rows * map->cols;
+	int i, r, c;
+
+	for (i = 0; i < RELOAD_TEST_LIGHTS; i++)
+	{
+		lights[i].x = mazegen_hash(seed, i, 0) % map->cols * TILE_SIZE;
+		lights[i].y = mazegen_hash(seed, i, 1) % map->rows * TILE_SIZE;
+		map_find_open_cell(&lights[i].x, &lights[i].y, map);
+		lights[i].radius = (2 + i) * TILE_SIZE;
+		lights[i].level = 40;
+	}
+	for (i = 0; i < RELOAD_TEST_EDITS; i++)
+	{
+		r = lights[i % RELOAD_TEST_LIGHTS].y / TILE_SIZE - 3 +
+			mazegen_hash(seed, i, 2) % 7;
+		c = lights[i % RELOAD_TEST_LIGHTS].x / TILE_SIZE - 3 +
+			mazegen_hash(seed, i, 3) % 7;
+		if (i % 4 == 0)
+			cell = mazegen_hash(seed, i, 4) % size;
+		else if (r >= 0 && r < map->rows && c >= 0 && c < map->cols)
+			cell = (long)r * map->cols + c;
+		else
+			continue;
+		map->cells[cell] = map->cells[cell] ? 0 : 1 + i % NUM_TEXTURES;
+	}
+}
+
+/**
+ * check_map - Reloads an edited map and updates its lighting.
+ * @map_file: The map.
+ * @seed: The seed picking the lights and the edits.
+ *
+ * Description: The reload must list exactly the edited cells, and the
+ * lighting updated from them must match a lighting baked from scratch.
+ * A malformed file must leave the map alone, and a map of another size
+ * must replace it.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_map(const char *map_file, uint64_t seed)
+{
+	map_t map = {NULL, 0, 0, 0}, live = {NULL, 0, 0, 0};
+	light_t lights[RELOAD_TEST_LIGHTS];
+	lightmap_t lit, built = {0};
+	map_reload_t reload;
+	long cell, size;
+	int expected = 0, failures;
+
+	memset(&reload, 0, sizeof(reload));
+	if (!parse_map_from_file(map_file, &map) ||
+			!parse_map_from_file(map_file, &live))
+		return (1);
+	size = (long)map.rows * map.cols;
+	edit_map(&map, lights, seed);
+	for (cell = 0; cell < size; cell++)
+		expected += map.cells[cell] != live.cells[cell];
+	failures = !lightmap_build(&lit, &live, lights, RELOAD_TEST_LIGHTS,
+			LIGHT_AMBIENT) || !reload_from(&live, &map, &reload) ||
+		reload.count != expected ||
+		memcmp(live.cells, map.cells, size) ||
+		!lightmap_update(&lit, &live, reload.changed, reload.count);
+	failures += !lightmap_build(&built, &live, lights,
+			RELOAD_TEST_LIGHTS, LIGHT_AMBIENT) ||
+		memcmp(lit.cells, built.cells, size) ||
+		memcmp(lit.corners, built.corners,
+				size + map.rows + map.cols + 1);
+	failures += reload_from(&live, NULL, &reload) || live.rows != map.rows;
+	map.rows--;
+	failures += !reload_from(&live, &map, &reload) || reload.count != -1 ||
+		live.rows != map.rows || lightmap_update(&lit, &live, NULL, 0);
+	lightmap_free(&lit);
+	lightmap_free(&built);
+	map_reload_free(&reload);
+	map_free(&live);
+	map_free(&map);
+	return (failures);
+}
+
+/**
+ * check_watch - Checks that written and renamed files are noticed.
+ *
+ * Description: A file closed after writing and a file renamed into
+ * place must each be reported once, and only them; the empty path
+ * between them, a gap in a texture list, never is.
+ *
+ * Return: The number of failed checks, or 1 if inotify is unavailable.
+ */
+static int check_watch(void)
+{
+	const char *paths[3] = {RELOAD_TEST_FILE, "", RELOAD_TEST_OTHER};
+	bool changed[3];
+	watch_t watch;
+	FILE *file;
+	int failures;
+
+	if (!watch_init(&watch, paths, 3))
+		return (1);
+	failures = watch_poll(&watch, changed) != 0;
+	file = fopen(RELOAD_TEST_FILE, "w");
+	failures += !file || fputs("1\n", file) < 0 || fclose(file) != 0;
+	failures += watch_poll(&watch, changed) != 1 || !changed[0] ||
+		changed[1] || changed[2];
+	failures += rename(RELOAD_TEST_FILE, RELOAD_TEST_OTHER) != 0;
+	failures += watch_poll(&watch, changed) != 1 || changed[0] ||
+		changed[1] || !changed[2];
+	failures += watch_poll(&watch, changed) != 0;
+	watch_close(&watch);
+	remove(RELOAD_TEST_OTHER);
+	return (failures);
+}
+
+/**
+ * main - Checks file watching and map reloads on the test maps.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, failures = check_watch(), passed = !failures, total = 1;
+
+	printf("%-16s %s\n", "watch", failures ? "FAILED" : "ok");
+	for (i = 0; i < num_test_scenes; i++)
+	{
+		if (i > 0 && strcmp(test_scenes[i].map_file,
+					test_scenes[i - 1].map_file) == 0)
+			continue;
+		failures = check_map(test_scenes[i].map_file, i);
+		printf("%-16s %s\n", test_scenes[i].name,
+				failures ? "FAILED" : "ok");
+		passed += !failures;
+		total++;
+	}
+	remove(RELOAD_TEST_FILE);
+	printf("%d of %d checks passed\n", passed, total);
+	return (passed == total ? 0 : 1);
+}
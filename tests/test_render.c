@@ -0,0 +1,128 @@
+#include "tests.h"
+
+/**
+ * read_golden - Reads the golden hash of the next frame.
+ * @golden: The golden file.
+ * @scene: The scene being checked.
+ * @frame: The index of the frame being checked.
+ * @expected: Set to the golden hash of the frame.
+ *
+ * Return: True on success, false if the file does not list the frame
+ * next, in which case the goldens need to be regenerated.
+ */
+static bool read_golden(FILE *golden, const scene_t *scene, int frame,
+		unsigned long *expected)
+{
+	char name[64];
+	int index;
+
+	if (fscanf(golden, "%63s %d %lx", name, &index, expected) == 3 &&
+			strcmp(name, scene->name) == 0 && index == frame)
+		return (true);
+	fprintf(stderr, "%s: golden file out of date\n", scene->name);
+	return (false);
+}
+
+/**
+ * check_marker - Checks that the player shows on the minimap.
+ * @run: The scene, whose minimap was just drawn.
+ *
+ * Description: The marker is drawn in white over the rays, at least one
+ * pixel wide and tall however small the scale.
+ *
+ * Return: True if the marker is in the minimap and every pixel of its
+ * first column is white.
+ */
+static bool check_marker(const scene_run_t *run)
+{
+	const minimap_t *minimap = &run->view.minimap;
+	int x = run->player.x * minimap->scale - minimap->origin_x;
+	int y = run->player.y * minimap->scale - minimap->origin_y;
+	int row, height = run->player.height * minimap->scale;
+
+	if (x < 0 || x >= minimap->width || y < 0 || y >= minimap->height)
+		return (false);
+	for (row = y; row < y + (height > 1 ? height : 1) &&
+			row < minimap->height; row++)
+		if (run->view.frame.pixels[(long)row * run->view.frame.pitch +
+				x] != 0xFFFFFFFF)
+			return (false);
+	return (true);
+}
+
+/**
+ * check_scene - Plays a scene and compares every frame with its golden.
+ * @scene: The scene to play.
+ * @golden: The golden file, read from, or written to when @update is set.
+ * @update: A flag to record new goldens instead of checking them.
+ *
+ * Description: Scenes with a minimap must also show the player on it.
+ *
+ * Return: The number of frames that differ, or -1 if the scene or the
+ * golden file could not be read.
+ */
+static int check_scene(const scene_t *scene, FILE *golden, bool update)
+{
+	unsigned long expected, hash;
+	int frame, failures = 0;
+	scene_run_t run;
+
+	if (!scene_open(&run, scene))
+		return (-1);
+	for (frame = 0; scene->script[frame] && failures >= 0; frame++)
+	{
+		scene_step(&run, frame);
+		hash = (unsigned long)frame_hash(&run.view.frame);
+		if (update)
+			fprintf(golden, "%s %d %016lx\n", scene->name, frame,
+					hash);
+		else if (!read_golden(golden, scene, frame, &expected))
+			failures = -1;
+		else if (hash != expected && failures++ == 0)
+			fprintf(stderr, "%s: frame %d is %016lx, not %016lx\n",
+					scene->name, frame, hash, expected);
+		if (failures >= 0 && scene->minimap && !check_marker(&run) &&
+				failures++ == 0)
+			fprintf(stderr, "%s: frame %d hides the player\n",
+					scene->name, frame);
+	}
+	scene_close(&run);
+	return (failures);
+}
+
+/**
+ * main - Renders every test scene and checks the frames against goldens.
+ * @argc: The number of command-line arguments.
+ * @argv: The golden file, optionally followed by --update to rewrite it.
+ *
+ * Return: 0 if every frame matches, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	bool update = argc == 3 && strcmp(argv[2], "--update") == 0;
+	FILE *golden;
+	int i, failures = 0, passed = 0;
+
+	if (argc != 2 && !update)
+	{
+		fprintf(stderr, "Usage: %s <golden_file> [--update]\n",
+				argv[0]);
+		return (1);
+	}
+	golden = fopen(argv[1], update ? "w" : "r");
+	if (!golden)
+	{
+		fprintf(stderr, "Unable to open file: %s\n", argv[1]);
+		return (1);
+	}
+	for (i = 0; i < num_test_scenes && failures >= 0; i++)
+	{
+		failures = check_scene(&test_scenes[i], golden, update);
+		printf("%-16s %s\n", test_scenes[i].name, failures == 0 ?
+				(update ? "updated" : "ok") : "FAILED");
+		passed += failures == 0;
+	}
+	fclose(golden);
+	printf("%d of %d scenes passed\n", passed, num_test_scenes);
+	return (passed == num_test_scenes ? 0 : 1);
+}
@@ -0,0 +1,113 @@
+#include "tests.h"
+
+/**
+ * check_rays - Casts every column again and compares it with the frame.
+ * @run: The scene run, whose rays were cast with wall spans.
+ *
+ * Return: The number of ray fields that differ from a traversal.
+ */
+static int check_rays(scene_run_t *run)
+{
+	ray_buffer_t *rays = &run->view.rays;
+	int col, i, width = rays->count, wrong = 0;
+	float *fields[4], saved[6], plane = run->view.dist_proj_plane;
+
+	fields[0] = rays->ray_angle, fields[1] = rays->wall_hit_x;
+	fields[2] = rays->wall_hit_y, fields[3] = rays->distance;
+	for (col = 0; col < width; col++)
+	{
+		for (i = 0; i < 4; i++)
+			saved[i] = fields[i][col];
+		saved[4] = rays->texture[col];
+		saved[5] = rays->was_hit_vertical[col];
+		cast_ray(run->player.rotation_angle + atan((col - width / 2) /
+					plane), col, &run->view);
+		for (i = 0; i < 4; i++)
+			wrong += memcmp(&saved[i], &fields[i][col],
+					sizeof(float)) != 0;
+		wrong += saved[4] != rays->texture[col] ||
+			saved[5] != rays->was_hit_vertical[col];
+	}
+	return (wrong);
+}
+
+/**
+ * check_packets - Casts every column in packets and compares them.
+ * @run: The scene run.
+ *
+ * Description: The packets grow from one ray to RAY_PACKET and start
+ * over, so partly filled packets are checked too.
+ *
+ * Return: The number of ray fields that differ from a traversal.
+ */
+static int check_packets(scene_run_t *run)
+{
+	ray_buffer_t *rays = &run->view.rays;
+	int col, count, i, width = rays->count, columns[RAY_PACKET];
+
+	for (col = 0, count = 1; col < width; col += count++)
+	{
+		if (count > RAY_PACKET)
+			count = 1;
+		if (col + count > width)
+			count = width - col;
+		for (i = 0; i < count; i++)
+		{
+			columns[i] = col + i;
+			rays->ray_angle[col + i] = run->player.rotation_angle +
+				atan((col + i - width / 2) /
+						run->view.dist_proj_plane);
+		}
+		cast_ray_packet(&run->view, columns, count);
+	}
+	return (check_rays(run));
+}
+
+/**
+ * check_scene - Plays a scene and checks the rays of every frame.
+ * @scene: The scene.
+ *
+ * Description: Every scene turns in place at some point, so some frames
+ * must come from the ray cache, and their rays are checked as well. Ray
+ * packets are checked on every frame.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_scene(const scene_t *scene)
+{
+	scene_run_t run;
+	int frame, wrong = 0;
+	long spans = 0, cached = 0;
+
+	if (!scene_open(&run, scene))
+		return (1);
+	for (frame = 0; scene->script[frame]; frame++)
+	{
+		scene_step(&run, frame);
+		spans += run.view.span_columns;
+		cached += run.view.ray_cache.cast > 0;
+		wrong += check_rays(&run) + check_packets(&run);
+	}
+	printf("%-16s %.2f of the columns from spans, %ld frames from the "
+			"ray cache, %d wrong rays\n", scene->name,
+			(double)spans / frame / scene->width, cached, wrong);
+	scene_close(&run);
+	return (wrong > 0 || spans == 0 || cached == 0);
+}
+
+/**
+ * main - Checks that wall spans and ray packets find the hits of a grid
+ * traversal.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, failures = 0;
+
+	for (i = 0; i < num_test_scenes; i++)
+		failures += check_scene(&test_scenes[i]);
+	if (failures)
+		printf("%d scenes have wrong wall spans\n", failures);
+	return (failures ? 1 : 0);
+}
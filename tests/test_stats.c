@@ -0,0 +1,160 @@
+#include "tests.h"
+#include <unistd.h>
+
+#define STATS_TEST_FRAMES 1000000
+
+/**
+ * check_scene - Plays a scene and checks the counters of every frame.
+ * @scene: The scene.
+ *
+ * Description: Every column is either cast or filled from a wall span,
+ * every wall, floor and ceiling pixel reads one texel and is written by
+ * one draw_pixel() call, which counts them on its own, and the three
+ * cover the frame.
+ *
+ * Return: The number of frames with wrong counters.
+ */
+static int check_scene(const scene_t *scene)
+{
+	scene_run_t run;
+	const frame_stats_t *stats = &run.view.stats;
+	uint64_t pixels, area = (uint64_t)scene->width * scene->height;
+	int frame, wrong = 0;
+	frame_stats_t total;
+
+	if (!scene_open(&run, scene))
+		return (1);
+	memset(&total, 0, sizeof(total));
+	for (frame = 0; scene->script[frame]; frame++)
+	{
+		scene_step(&run, frame);
+		frame_stats_add(&total, stats);
+		pixels = stats->wall_pixels + stats->floor_pixels +
+			stats->ceiling_pixels;
+		wrong += stats->rays_cast - run.view.ray_cache.cast +
+			run.view.span_columns !=
+			(uint64_t)scene->width || stats->cells_visited == 0 ||
+			stats->texel_fetches != pixels || pixels < area ||
+			stats->pixel_calls != pixels;
+	}
+	printf("%-16s %lu rays, %.1f cells each, %.2f pixels per pixel, "
+			"%d wrong frames\n", scene->name,
+			(unsigned long)total.rays_cast / frame,
+			(double)total.cells_visited / total.rays_cast,
+			(double)total.pixel_calls / frame / area, wrong);
+	scene_close(&run);
+	return (wrong);
+}
+
+/**
+ * publish_frames - Publishes frames whose counters are all 1.
+ * @arg: The stats_export_t struct to publish to.
+ *
+ * Return: NULL.
+ */
+static void *publish_frames(void *arg)
+{
+	frame_stats_t ones;
+	uint64_t *count = (uint64_t *)&ones;
+	size_t i;
+	int frame;
+
+	for (i = 0; i < sizeof(ones) / sizeof(uint64_t); i++)
+		count[i] = 1;
+	for (frame = 0; frame < STATS_TEST_FRAMES; frame++)
+		stats_export_publish(arg, &ones);
+	return (NULL);
+}
+
+/**
+ * check_export - Reads a segment while another thread publishes to it.
+ *
+ * Description: Every copy must be consistent: each total equals the
+ * number of frames and the last frame is all ones. Once closed, the
+ * segment must be gone.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_export(void)
+{
+	stats_export_t export;
+	stats_shared_t shared;
+	pthread_t publisher;
+	const uint64_t *total = (const uint64_t *)&shared.total;
+	const uint64_t *last = (const uint64_t *)&shared.last;
+	char name[64];
+	int reads = 0, torn = 0, busy = 0, i;
+
+	sprintf(name, "/maze-stats-test.%d", (int)getpid());
+	if (!stats_export_open(&export, name))
+		return (1);
+	if (pthread_create(&publisher, NULL, publish_frames, &export))
+	{
+		stats_export_close(&export);
+		return (1);
+	}
+	do {
+		if (!stats_export_read(name, &shared))
+		{
+			busy++;
+			continue;
+		}
+		for (i = 0; i < (int)(sizeof(frame_stats_t) / 8); i++)
+			torn += total[i] != shared.frames ||
+				(shared.frames && last[i] != 1);
+		reads++;
+	} while (shared.frames < STATS_TEST_FRAMES);
+	pthread_join(publisher, NULL);
+	stats_export_close(&export);
+	printf("export: %d reads, %d torn, %d busy, pid %d\n", reads, torn,
+			busy, (int)shared.pid);
+	return (torn > 0 || reads == 0 || shared.pid != getpid() ||
+			stats_export_read(name, &shared));
+}
+
+/**
+ * check_hud - Draws the counters on a black frame.
+ *
+ * Return: 1 if nothing is drawn or pixels change outside the 176x150
+ * top-right corner, 0 otherwise.
+ */
+static int check_hud(void)
+{
+	static color_t pixels[320 * 200];
+	framebuffer_t frame = {pixels, 320, 200, 320, 0};
+	frame_stats_t stats;
+	int x, y, lit = 0, outside = 0;
+
+	memset(&stats, 0, sizeof(stats));
+	stats.rays_cast = 1234567890;
+	stats.late_frames = 8;
+	stats_hud_draw(&frame, &stats, &stats);
+	for (y = 0; y < frame.height; y++)
+		for (x = 0; x < frame.width; x++)
+		{
+			lit += pixels[y * frame.width + x] == 0xFFFFFFFF;
+			outside += pixels[y * frame.width + x] != 0 &&
+				(x < frame.width - 176 || y >= 150);
+		}
+	printf("hud: %d lit pixels, %d outside\n", lit, outside);
+	return (lit == 0 || outside > 0);
+}
+
+/**
+ * main - Checks the frame counters, their export and their display.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, failures = 0;
+
+	for (i = 0; i < num_test_scenes; i++)
+		if (!test_scenes[i].minimap)
+			failures += check_scene(&test_scenes[i]) > 0;
+	failures += check_export();
+	failures += check_hud();
+	if (failures)
+		printf("%d counter checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
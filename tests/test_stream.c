@@ -0,0 +1,201 @@
+#include "tests.h"
+#include <arpa/inet.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+
+#define STREAM_TEST_FRAMES 200
+
+/**
+ * open_receiver - Listens for a frame stream.
+ * @address: The address to listen on; a TCP port of 0 picks a free one.
+ * @actual: Receives the address a sender connects to, 64 bytes at most.
+ *
+ * Return: The listening socket, or -1 on failure.
+ */
+static int open_receiver(const char *address, char *actual)
+{
+	struct sockaddr_in addr;
+	socklen_t length = sizeof(addr);
+	int fd = stream_listen(address);
+
+	strcpy(actual, address);
+	if (fd >= 0 && strncmp(address, "unix:", 5) != 0 &&
+			getsockname(fd, (struct sockaddr *)&addr, &length) == 0)
+		sprintf(actual, "127.0.0.1:%d", ntohs(addr.sin_port));
+	return (fd);
+}
+
+/**
+ * check_codec - Round-trips a block of pixels through the QOI chunks.
+ *
+ * Description: The pixels mix runs, small and large differences and
+ * repeated colors, so every chunk is written, and the block is narrower
+ * than its rows. Their alpha is random but decodes as opaque. Decoding
+ * must use every byte, and fail on one less.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_codec(void)
+{
+	static color_t pixels[50 * 30], decoded[50 * 30];
+	static unsigned char chunks[4 * 50 * 30];
+	color_t palette[4] = {0xFF102030, 0xFF808080, 0xFFFFFFFF, 0xFF000000};
+	unsigned int seed = 12345, i, kind, wrong = 0;
+	size_t size;
+
+	for (i = 0; i < 50 * 30; i++)
+	{
+		seed = seed * 1103515245 + 12345;
+		kind = i ? seed >> 29 : 7;
+		if (kind < 3)
+			pixels[i] = pixels[i - 1];
+		else if (kind < 5)
+			pixels[i] = pixels[i - 1] + (seed >> 8 & 0x030303) -
+				0x010101;
+		else
+			pixels[i] = kind < 6 ? palette[seed >> 16 & 3] :
+				seed >> 8;
+	}
+	size = qoi_encode_rows(pixels + 50 + 3, 37, 23, 50, chunks) - chunks;
+	wrong += qoi_decode_rows(chunks, size - 1, decoded, 37, 23, 50) != 0;
+	wrong += qoi_decode_rows(chunks, size, decoded + 50 + 3, 37, 23,
+			50) != size;
+	for (i = 0; i < 37 * 23; i++)
+		wrong += decoded[(i / 37 + 1) * 50 + 3 + i % 37] !=
+			(pixels[(i / 37 + 1) * 50 + 3 + i % 37] | 0xFF000000);
+	printf("codec            %lu bytes for %d pixels, %u wrong\n",
+			(unsigned long)size, 37 * 23, wrong);
+	return (wrong);
+}
+
+/**
+ * check_scene - Streams a scene and mirrors it on the other end.
+ * @scene: The scene.
+ * @address: The address the receiver listens on.
+ *
+ * Description: The receiver reads each frame before the next one is
+ * queued, so none may be dropped, and its mirror must match the frame
+ * pixel for pixel, once opaque. Sending the last frame again must send no tile.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_scene(const scene_t *scene, const char *address)
+{
+	size_t area = (size_t)scene->width * scene->height, bytes = 0, i;
+	int listener, frame, tiles = 0, wrong = 0;
+	stream_mirror_t mirror;
+	frame_stream_t stream;
+	uint64_t sent, encode_ns;
+	scene_run_t run;
+	char actual[64];
+
+	listener = open_receiver(address, actual);
+	if (listener < 0 || !scene_open(&run, scene) || !stream_start(&stream,
+				actual, scene->width, scene->height))
+		return (1);
+	stream_mirror_open(&mirror, accept(listener, NULL, NULL));
+	for (frame = 0; scene->script[frame]; frame++)
+	{
+		scene_step(&run, frame);
+		wrong += !stream_frame(&stream, run.pixels, scene->width) ||
+			stream_mirror_read(&mirror) != 1 ||
+			mirror.frame != (unsigned long)frame;
+		for (i = 0; i < area && mirror.pixels; i++)
+			if (mirror.pixels[i] != (run.pixels[i] | 0xFF000000))
+				break;
+		wrong += i < area;
+		bytes += mirror.bytes;
+		tiles += mirror.tiles;
+	}
+	stream_frame(&stream, run.pixels, scene->width);
+	wrong += stream_mirror_read(&mirror) != 1 || mirror.tiles != 0;
+	stream_totals(&stream, &sent, &encode_ns);
+	stream_stop(&stream);
+	wrong += stream_mirror_read(&mirror) != 0;
+	printf("%-16s %-4s %6.1f KB and %5.1f tiles per frame, %.2f ms to "
+			"encode, %d wrong\n", scene->name, actual[0] == 'u' ?
+			"unix" : "tcp", bytes / 1024.0 / frame,
+			(double)tiles / frame, encode_ns / 1e6 / frame, wrong);
+	stream_mirror_close(&mirror);
+	close(listener);
+	scene_close(&run);
+	return (wrong);
+}
+
+/**
+ * check_backpressure - Streams noise to a receiver that never reads.
+ * @address: The address the receiver listens on.
+ *
+ * Description: The sender soon blocks on the full socket, so frames
+ * must be dropped rather than make the caller wait, and stopping the
+ * stream while the receiver is still connected must give up the queued
+ * frames after STREAM_DRAIN_MS rather than hang.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_backpressure(const char *address)
+{
+	int listener, receiver, frame, queued = 0, width = 640, height = 400;
+	unsigned int seed = 1, i;
+	double longest = 0, ms;
+	struct timespec start, end;
+	frame_stream_t stream;
+	color_t *pixels = malloc(sizeof(color_t) * width * height);
+	const char *kind = strncmp(address, "unix:", 5) ? "tcp" : "unix";
+	char actual[64];
+
+	listener = open_receiver(address, actual);
+	if (!pixels || listener < 0 ||
+			!stream_start(&stream, actual, width, height))
+		return (1);
+	receiver = accept(listener, NULL, NULL);
+	for (frame = 0; frame < STREAM_TEST_FRAMES; frame++)
+	{
+		for (i = 0; i < (unsigned int)(width * height); i++)
+			pixels[i] = seed = seed * 1103515245 + 12345;
+		clock_gettime(CLOCK_MONOTONIC, &start);
+		queued += stream_frame(&stream, pixels, width);
+		clock_gettime(CLOCK_MONOTONIC, &end);
+		ms = (end.tv_sec - start.tv_sec) * 1e3 +
+			(end.tv_nsec - start.tv_nsec) / 1e6;
+		longest = ms > longest ? ms : longest;
+	}
+	frame = stream.dropped == 0 || queued + stream.dropped !=
+		STREAM_TEST_FRAMES || longest > 50;
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	stream_stop(&stream);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	ms = (end.tv_sec - start.tv_sec) * 1e3 +
+		(end.tv_nsec - start.tv_nsec) / 1e6;
+	printf("backpressure     %-5s %d of %d frames queued, %d dropped, "
+			"%.2f ms at most to queue one, %.0f ms to stop\n", kind,
+			queued, STREAM_TEST_FRAMES, STREAM_TEST_FRAMES - queued,
+			longest, ms);
+	close(receiver);
+	close(listener);
+	free(pixels);
+	return (frame + (ms > 2 * STREAM_DRAIN_MS));
+}
+
+/**
+ * main - Checks frame streams over Unix and TCP sockets.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	char unix_address[64];
+	int i, failures = check_codec();
+
+	sprintf(unix_address, "unix:/tmp/maze-stream-test.%d", (int)getpid());
+	for (i = 0; i < num_test_scenes; i++)
+		failures += check_scene(&test_scenes[i], i % 2 ? "127.0.0.1:0" :
+				unix_address);
+	failures += check_backpressure(unix_address);
+	failures += check_backpressure("127.0.0.1:0");
+	unlink(unix_address + 5);
+	if (failures)
+		printf("%d frame stream checks failed\n", failures);
+	return (failures ? 1 : 0);
+}
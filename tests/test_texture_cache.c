@@ -0,0 +1,129 @@
+#include "tests.h"
+
+#define CACHE_TEST_FILE "/tmp/maze-test.cache"
+#define CACHE_TEST_IDS 4
+#define CACHE_TEST_TEXEL(index, i) (0xFF000000 | ((index) * 7919u + (i)))
+
+static const char * const cache_sources[CACHE_TEST_IDS] = {
+	"/tmp/maze-test-0.img", "", "/tmp/maze-test-2.img",
+	"/tmp/maze-test-3.img"
+};
+
+/**
+ * cache_decode - Decodes a procedural texture, as the game decodes an
+ * image.
+ * @context: The array counting the decodes of each texture index.
+ * @index: The texture index.
+ * @texture: Receives the texture, in a malloc'ed buffer.
+ *
+ * Return: True on success, false if memory allocation failed.
+ */
+static bool cache_decode(void *context, int index, texture_t *texture)
+{
+	int *calls = context, i;
+
+	calls[index]++;
+	texture->width = 8 + index;
+	texture->height = 4;
+	texture->texture_buffer = malloc(sizeof(color_t) * texture->width *
+			texture->height);
+	for (i = 0; texture->texture_buffer && i < texture->width *
+			texture->height; i++)
+		texture->texture_buffer[i] = CACHE_TEST_TEXEL(index, i);
+	return (texture->texture_buffer != NULL);
+}
+
+/**
+ * cache_touch - Writes a source image of the test.
+ * @path: The path of the image.
+ * @bytes: The number of bytes to write, which changes its size.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool cache_touch(const char *path, int bytes)
+{
+	FILE *file = fopen(path, "w");
+
+	while (file && bytes-- > 0)
+		fputc('x', file);
+	return (file && fclose(file) == 0);
+}
+
+/**
+ * check_textures - Checks the textures read from a cache.
+ * @textures: The CACHE_TEST_IDS textures.
+ *
+ * Description: The gap must have no buffer, and the other textures
+ * the texels cache_decode() gave them.
+ *
+ * Return: The number of wrong textures.
+ */
+static int check_textures(const texture_t *textures)
+{
+	int index, i, wrong = 0;
+
+	for (index = 0; index < CACHE_TEST_IDS; index++)
+	{
+		if (!*cache_sources[index])
+		{
+			wrong += textures[index].texture_buffer != NULL;
+			continue;
+		}
+		if (!textures[index].texture_buffer ||
+				textures[index].width != 8 + index ||
+				textures[index].height != 4)
+		{
+			wrong++;
+			continue;
+		}
+		for (i = 0; i < textures[index].width * 4; i++)
+			if (textures[index].texture_buffer[i] !=
+					CACHE_TEST_TEXEL(index, i))
+				break;
+		wrong += i < textures[index].width * 4;
+	}
+	return (wrong);
+}
+
+/**
+ * main - Writes a texture cache whose list has a gap and reads it back.
+ *
+ * Description: The gap must not be decoded, nor keep the cache from
+ * being written or read; editing a source must still reject the cache.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	texture_t textures[CACHE_TEST_IDS];
+	int calls[CACHE_TEST_IDS] = {0}, i, failures = 0;
+	texture_cache_t cache;
+
+	for (i = 0; i < CACHE_TEST_IDS; i++)
+		failures += *cache_sources[i] && !cache_touch(cache_sources[i],
+				i);
+	failures += !texture_cache_save(CACHE_TEST_FILE, cache_sources,
+			CACHE_TEST_IDS, cache_decode, calls) || calls[1] != 0;
+	printf("%-16s %s\n", "save", failures ? "FAILED" : "ok");
+	if (texture_cache_load(&cache, CACHE_TEST_FILE, cache_sources,
+				textures, CACHE_TEST_IDS))
+	{
+		i = check_textures(textures);
+		texture_cache_close(&cache);
+	}
+	else
+		i = 1;
+	printf("%-16s %s\n", "load", i ? "FAILED" : "ok");
+	failures += i;
+	i = !cache_touch(cache_sources[2], 5) || texture_cache_load(&cache,
+			CACHE_TEST_FILE, cache_sources, textures,
+			CACHE_TEST_IDS);
+	texture_cache_close(&cache);
+	printf("%-16s %s\n", "edited source", i ? "FAILED" : "ok");
+	failures += i;
+	for (i = 0; i < CACHE_TEST_IDS; i++)
+		if (*cache_sources[i])
+			remove(cache_sources[i]);
+	remove(CACHE_TEST_FILE);
+	return (failures ? 1 : 0);
+}
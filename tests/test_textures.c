@@ -0,0 +1,221 @@
+#include "tests.h"
+
+#define POOL_IDS 200
+#define POOL_BUDGET (24 * 64 * 64 * sizeof(color_t))
+#define POOL_TEXEL(index, generation, x, y) (0xFF000000 | \
+		(((index) * 2654435761u + (generation) * 40503u + \
+		  (x) * 3u + (y) * 1031u) & 0xFFFFFF))
+
+/**
+ * pool_load - Loads a procedural texture, as a game decodes an image.
+ * @context: The pool_run_t struct of the pool.
+ * @index: The texture index.
+ * @generation: The generation of the texture, mixed into its texels.
+ * @texture: Receives the texture, in a malloc'ed buffer.
+ * @borrowed: Set when @texture points into the atlas of the test.
+ *
+ * Description: Every fourth texture is 32x32 and every sixteenth 48x40,
+ * so tiles of several sizes and resampled ones share the budget. Once
+ * the pool runs, odd textures are borrowed from the atlas until they are
+ * reloaded, as the game borrows them from its texture cache.
+ *
+ * Return: True on success, false for the failing index.
+ */
+static bool pool_load(void *context, int index, unsigned int generation,
+		texture_t *texture, bool *borrowed)
+{
+	pool_run_t *test = context;
+	color_t *texel;
+	int x, y;
+
+	test->calls[index]++;
+	test->foreign += !pthread_equal(pthread_self(), test->caller);
+	if (index == test->failing)
+		return (false);
+	if (index % 2 && !generation && test->pool.load)
+	{
+		*texture = test->atlas.tiles[index];
+		*borrowed = true;
+		return (true);
+	}
+	texture->width = index % 16 == 15 ? 48 : index % 4 == 3 ? 32 : 64;
+	texture->height = index % 16 == 15 ? 40 : texture->width;
+	texel = malloc(sizeof(color_t) * texture->width * texture->height);
+	texture->texture_buffer = texel;
+	for (y = 0; texel && y < texture->height; y++)
+		for (x = 0; x < texture->width; x++)
+			*texel++ = POOL_TEXEL(index, generation, x, y);
+	return (texture->texture_buffer != NULL);
+}
+
+/**
+ * pool_open - Opens a scene whose walls use POOL_IDS textures.
+ * @test: Pointer to the zeroed pool_run_t struct to set up.
+ * @scene: The scene.
+ *
+ * Description: The walls of the map are given texture IDs spread over
+ * the whole pool, so frames hit many textures and moving around keeps
+ * hitting new ones.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool pool_open(pool_run_t *test, const scene_t *scene)
+{
+	texture_t sources[POOL_IDS];
+	size_t cell, cells;
+	bool built, borrowed;
+	int i;
+
+	test->failing = -1;
+	test->caller = pthread_self();
+	if (!scene_open(&test->run, scene))
+		return (false);
+	cells = (size_t)test->run.map.rows * test->run.map.cols;
+	for (cell = 0; cell < cells; cell++)
+		if (test->run.map.cells[cell])
+			test->run.map.cells[cell] = 1 + cell * 37 % POOL_IDS;
+	for (i = 0; i < POOL_IDS; i++)
+		pool_load(test, i, 0, &sources[i], &borrowed);
+	built = texture_atlas_build(&test->atlas, sources, POOL_IDS);
+	for (i = 0; i < POOL_IDS; i++)
+		free(sources[i].texture_buffer);
+	memset(test->calls, 0, sizeof(test->calls));
+	test->foreign = 0;
+	test->world = test->run.world;
+	test->world.textures = test->atlas.tiles;
+	test->run.world.textures = test->pool.textures;
+	test->pixels = malloc(sizeof(color_t) * scene->width * scene->height);
+	return (built && test->pixels && view_init(&test->reference,
+				&test->world, &test->run.player, test->pixels,
+				scene->width, scene->height) &&
+			texture_pool_init(&test->pool, POOL_IDS, POOL_BUDGET,
+				pool_load, test));
+}
+
+/**
+ * check_frame - Plays a frame and checks the pool once it is loaded.
+ * @test: The pool run.
+ * @frame: The index of the frame in the script of the scene.
+ *
+ * Description: Every texture the frame hit must be resident with the
+ * right texels, the pool must stay under its budget unless the frame
+ * alone exceeds it, the textures evicted must not have been hit more
+ * recently than those kept, and drawing the frame again must give the
+ * frame of the atlas.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_frame(pool_run_t *test, int frame)
+{
+	texture_pool_t *pool = &test->pool;
+	const texture_slot_t *slot = pool->slots;
+	unsigned long evicted = 0, kept = (unsigned long)-1;
+	size_t bytes = 0, hit_bytes = 0;
+	bool resident[POOL_IDS];
+	int i, wrong = 0;
+
+	for (i = 0; i < POOL_IDS; i++)
+		resident[i] = slot[i].state == TEXTURE_RESIDENT;
+	scene_step(&test->run, frame);
+	texture_pool_update(pool, &test->run.view, 1);
+	for (i = 0; i < POOL_IDS; i++)
+		test->misses += slot[i].state == TEXTURE_QUEUED;
+	texture_pool_flush(pool);
+	for (i = 0; i < POOL_IDS; i++)
+	{
+		if (slot[i].state == TEXTURE_RESIDENT)
+		{
+			bytes += slot[i].bytes;
+			if (slot[i].last_used < kept)
+				kept = slot[i].last_used;
+			wrong += pool->textures[i].texture_buffer[0] !=
+				POOL_TEXEL(i, test->generation, 0, 0);
+		}
+		else if (resident[i] && slot[i].last_used > evicted)
+			evicted = slot[i].last_used;
+		if (test->run.view.textures_hit[i / 32] >> i % 32 & 1)
+			wrong += slot[i].state != TEXTURE_RESIDENT;
+		hit_bytes += test->run.view.textures_hit[i / 32] >> i % 32 & 1 ?
+			slot[i].bytes : 0;
+	}
+	test->peak = bytes > test->peak ? bytes : test->peak;
+	wrong += bytes != pool->resident || evicted > kept ||
+		(bytes > pool->budget && bytes > hit_bytes);
+	render_view(&test->run.view);
+	cast_all_rays(&test->reference);
+	render_view(&test->reference);
+	return (wrong + (frame_hash(&test->run.view.frame) !=
+				frame_hash(&test->reference.frame)));
+}
+
+/**
+ * check_scene - Plays a scene through a texture pool.
+ * @scene: The scene.
+ *
+ * Description: After the last frame, the floor texture is reloaded
+ * twice: a failed load keeps the old texels and is not retried, and
+ * invalidating it again reads the new ones. It is invalidated once more
+ * while that load may be in progress, which the next update reads.
+ *
+ * Return: The number of failed checks.
+ */
+static int check_scene(const scene_t *scene)
+{
+	pool_run_t *test = calloc(1, sizeof(*test));
+	unsigned long calls, old;
+	int frame = 0, i = FLOOR_TEXTURE_INDEX, wrong = 1;
+
+	if (test && pool_open(test, scene))
+		for (wrong = 0; scene->script[frame]; frame++)
+			wrong += check_frame(test, frame);
+	for (calls = 0; test && !wrong && calls < 4; calls++)
+	{
+		old = test->calls[i];
+		test->generation += calls % 2 == 0;
+		test->failing = calls == 0 ? i : -1;
+		if (calls % 2 == 0)
+			texture_pool_invalidate(&test->pool, i);
+		texture_pool_update(&test->pool, &test->run.view, 1);
+		test->generation += calls == 2;
+		if (calls == 2)
+			texture_pool_invalidate(&test->pool, i);
+		texture_pool_flush(&test->pool);
+		wrong += test->calls[i] != old + (calls != 1) || (calls != 2 &&
+				test->pool.textures[i].texture_buffer[0] !=
+				POOL_TEXEL(i, test->generation - (calls < 2),
+					0, 0));
+	}
+	if (test)
+	{
+		wrong += test->foreign != test->pool.loads + 1;
+		printf("%-16s %lu loads, %lu evictions, %.1f misses per frame, "
+				"%lu KB at most, %d wrong\n", scene->name,
+				test->pool.loads, test->pool.evictions,
+				(double)test->misses / frame,
+				(unsigned long)test->peak / 1024, wrong);
+		texture_pool_free(&test->pool);
+		view_free(&test->reference);
+		texture_atlas_free(&test->atlas);
+		free(test->pixels);
+		scene_close(&test->run);
+	}
+	free(test);
+	return (wrong);
+}
+
+/**
+ * main - Plays the test scenes through texture pools.
+ *
+ * Return: 0 if every check passes, 1 otherwise.
+ */
+int main(void)
+{
+	int i, failures = 0;
+
+	for (i = 0; i < num_test_scenes; i++)
+		if (!test_scenes[i].minimap)
+			failures += check_scene(&test_scenes[i]) > 0;
+	if (failures)
+		printf("%d scenes failed\n", failures);
+	return (failures ? 1 : 0);
+}
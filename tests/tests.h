@@ -0,0 +1,162 @@
+#ifndef __MAZE_TESTS__
+#define __MAZE_TESTS__
+
+#include "../headers/maze.h"
+
+#define SCENE_DELTA_TIME (1.0f / 30)
+
+/**
+ * struct scene_s - A scripted camera path rendered by the test suites.
+ *
+ * @name: The name of the scene, used in the golden and baseline files.
+ * @map_file: The map the scene is rendered in.
+ * @width: The width of the framebuffer.
+ * @height: The height of the framebuffer.
+ * @x: The starting x-coordinate of the camera.
+ * @y: The starting y-coordinate of the camera.
+ * @angle: The starting rotation angle of the camera.
+ * @minimap: A flag to draw the minimap.
+ * @lit: A flag to bake a lightmap, with a light where the camera starts.
+ * @script: One character per frame: 'w' and 's' walk forward and back,
+ * 'l' and 'r' turn left and right, 'W' walks while turning right and
+ * '.' stands still.
+ */
+typedef struct scene_s
+{
+	const char *name;
+	const char *map_file;
+	int width;
+	int height;
+	float x;
+	float y;
+	float angle;
+	bool minimap;
+	bool lit;
+	const char *script;
+} scene_t;
+
+/**
+ * struct scene_run_s - Everything needed to play back a scene.
+ *
+ * @scene: The scene being played.
+ * @map: The map of the scene.
+ * @atlas: Procedural textures, identical on every machine.
+ * @lightmap: The lighting of @map, for lit scenes.
+ * @world: The world made of @map and @atlas, and @lightmap if lit.
+ * @player: The camera.
+ * @view: The view rendering @player into @pixels.
+ * @pixels: The framebuffer.
+ */
+typedef struct scene_run_s
+{
+	const scene_t *scene;
+	map_t map;
+	texture_atlas_t atlas;
+	lightmap_t lightmap;
+	world_t world;
+	player_t player;
+	view_t view;
+	color_t *pixels;
+} scene_run_t;
+
+/**
+ * struct micro_kernel_s - A kernel measured by the microbenchmark.
+ *
+ * @name: The name of the kernel in the JSON report.
+ * @run: Runs the kernel once on a scene and returns the number of items
+ * it processed: rays, lookups, pixels, lines or map cells.
+ */
+typedef struct micro_kernel_s
+{
+	const char *name;
+	unsigned long (*run)(scene_run_t *);
+} micro_kernel_t;
+
+/**
+ * struct net_session_s - A server and its clients on the loopback.
+ *
+ * @server: The server.
+ * @clients: The clients, one player each.
+ * @count: The number of clients.
+ * @now: The virtual time, in seconds.
+ * @wrong: The number of snapshots decoded differently from the server's.
+ * @snapshots: The number of snapshots the clients decoded.
+ * @max_error: The largest distance between an interpolated player and
+ * the server's player at the same tick, in world units.
+ * @total_error: The sum of those distances.
+ * @poses: The number of those distances.
+ */
+typedef struct net_session_s
+{
+	net_server_t server;
+	net_client_t clients[NET_MAX_PLAYERS];
+	int count;
+	double now;
+	unsigned long wrong;
+	unsigned long snapshots;
+	double max_error;
+	double total_error;
+	unsigned long poses;
+} net_session_t;
+
+/**
+ * struct pool_run_s - A scene rendered through a texture pool, next to
+ * the same scene rendered with every texture in an atlas.
+ *
+ * @run: The scene, whose world reads the textures of @pool.
+ * @pool: The pool under test.
+ * @atlas: Every texture of the pool, for @reference.
+ * @world: The world of @run, reading @atlas instead.
+ * @reference: A view of the player of @run into @world.
+ * @pixels: The framebuffer of @reference.
+ * @caller: The thread rendering the frames.
+ * @generation: The generation the reloaded texture should have.
+ * @failing: The texture index whose loads fail, or -1.
+ * @calls: The number of loads of each texture index.
+ * @foreign: The number of loads run on another thread than @caller.
+ * @misses: The textures hit before they were resident, summed over the
+ * frames.
+ * @peak: The most bytes resident after a frame.
+ */
+typedef struct pool_run_s
+{
+	scene_run_t run;
+	texture_pool_t pool;
+	texture_atlas_t atlas;
+	world_t world;
+	view_t reference;
+	color_t *pixels;
+	pthread_t caller;
+	int generation;
+	int failing;
+	unsigned long calls[TEXTURE_MAX_IDS];
+	unsigned long foreign;
+	unsigned long misses;
+	size_t peak;
+} pool_run_t;
+
+extern volatile unsigned long micro_sink;
+extern const scene_t test_scenes[];
+extern const int num_test_scenes;
+
+bool scene_open(scene_run_t *, const scene_t *);
+void scene_step(scene_run_t *, int);
+void scene_close(scene_run_t *);
+uint64_t frame_hash(const framebuffer_t *);
+
+unsigned long micro_cast_all_rays(scene_run_t *);
+unsigned long micro_cast_ray(scene_run_t *);
+unsigned long micro_cast_packet(scene_run_t *);
+unsigned long micro_map_has_wall_at(scene_run_t *);
+unsigned long micro_draw_line(scene_run_t *);
+unsigned long micro_parse_map(scene_run_t *);
+unsigned long micro_render_floor(scene_run_t *);
+unsigned long micro_render_ceil(scene_run_t *);
+unsigned long micro_wall_span(scene_run_t *);
+unsigned long micro_darken(scene_run_t *);
+unsigned long micro_fill(scene_run_t *);
+unsigned long micro_render_floor_lit(scene_run_t *);
+unsigned long micro_wall_span_lit(scene_run_t *);
+unsigned long micro_lightmap_build(scene_run_t *);
+
+#endif /* __MAZE_TESTS__ */
@@ -0,0 +1,126 @@
+#include "../headers/maze.h"
+#include <sys/socket.h>
+#include <time.h>
+
+/**
+ * save_snapshot - Writes the frame a mirror holds as a QOI image.
+ * @mirror: The mirror.
+ * @path: The image to write, replaced atomically.
+ *
+ * Return: True on success, false otherwise.
+ */
+static bool save_snapshot(const stream_mirror_t *mirror, const char *path)
+{
+	size_t size = (size_t)mirror->width * mirror->height * 4 + 22;
+	unsigned char *image = malloc(size);
+	char temporary[4096];
+	FILE *file;
+	bool ok;
+
+	file = snprintf(temporary, sizeof(temporary), "%s.tmp", path) <
+		(int)sizeof(temporary) ? fopen(temporary, "wb") : NULL;
+	if (!image || !file)
+	{
+		if (file)
+			fclose(file);
+		free(image);
+		return (false);
+	}
+	size = capture_encode_qoi(mirror->pixels, mirror->width,
+			mirror->height, image);
+	ok = fwrite(image, 1, size, file) == size;
+	ok = fclose(file) == 0 && ok && rename(temporary, path) == 0;
+	free(image);
+	return (ok);
+}
+
+/**
+ * seconds_now - Reads the monotonic clock.
+ *
+ * Return: The time, in seconds.
+ */
+static double seconds_now(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec + now.tv_nsec / 1e9);
+}
+
+/**
+ * mirror_session - Mirrors the frames of one sender until it leaves.
+ * @mirror: The mirror, connected to the sender.
+ * @snapshot: The image to keep the latest frame in, or NULL.
+ *
+ * Description: Once a second, the frame rate, the bandwidth and the
+ * tiles per frame are printed and the snapshot is written.
+ */
+static void mirror_session(stream_mirror_t *mirror, const char *snapshot)
+{
+	double start = seconds_now(), now;
+	unsigned long frames = 0, tiles = 0, bytes = 0;
+	int status;
+
+	printf("Mirroring %dx%d frames\n", mirror->width, mirror->height);
+	while ((status = stream_mirror_read(mirror)) == 1)
+	{
+		frames++;
+		tiles += mirror->tiles;
+		bytes += mirror->bytes;
+		if ((now = seconds_now()) - start < 1)
+			continue;
+		printf("%.1f fps, %.1f KB/s, %.1f tiles per frame\n",
+				frames / (now - start),
+				bytes / 1024.0 / (now - start),
+				(double)tiles / frames);
+		fflush(stdout);
+		if (snapshot && !save_snapshot(mirror, snapshot))
+			fprintf(stderr, "Unable to write %s\n", snapshot);
+		start = now;
+		frames = tiles = bytes = 0;
+	}
+	printf(status == 0 ? "The sender stopped\n" : "The stream broke\n");
+	fflush(stdout);
+}
+
+/**
+ * main - Receives the frames a game streams and mirrors them.
+ * @argc: The number of command-line arguments.
+ * @argv: The address to listen on, unix:path or host:port, and
+ * optionally a QOI image to keep the latest frame in.
+ *
+ * Description: Senders are mirrored one after the other, as long as the
+ * program runs.
+ *
+ * Return: 1 if the address cannot be listened on; never returns
+ * otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	stream_mirror_t mirror;
+	int listener;
+
+	if (argc != 2 && argc != 3)
+	{
+		fprintf(stderr, "Usage: %s <host:port|unix:path> "
+				"[snapshot.qoi]\n", argv[0]);
+		return (1);
+	}
+	listener = stream_listen(argv[1]);
+	if (listener < 0)
+	{
+		fprintf(stderr, "Unable to listen on %s\n", argv[1]);
+		return (1);
+	}
+	printf("Listening on %s\n", argv[1]);
+	while (true)
+	{
+		if (!stream_mirror_open(&mirror, accept(listener, NULL, NULL)))
+		{
+			fprintf(stderr, "A sender sent no frame stream\n");
+			continue;
+		}
+		mirror_session(&mirror, argc == 3 ? argv[2] : NULL);
+		stream_mirror_close(&mirror);
+	}
+}
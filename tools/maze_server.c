@@ -0,0 +1,121 @@
+#include "../headers/maze.h"
+#include <signal.h>
+#include <time.h>
+
+static volatile sig_atomic_t running = 1;
+
+/**
+ * stop - Asks the server loop to stop.
+ * @signum: The signal received, unused.
+ */
+static void stop(int signum)
+{
+	(void)signum;
+	running = 0;
+}
+
+/**
+ * now_seconds - Reads the monotonic clock.
+ *
+ * Return: The time, in seconds.
+ */
+static double now_seconds(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec + now.tv_nsec / 1e9);
+}
+
+/**
+ * report - Prints what the server did over the last second.
+ * @server: The server.
+ * @ticks: The number of ticks run since the last report.
+ * @sent: The number of bytes sent since the last report.
+ * @elapsed: The time since the last report, in seconds.
+ */
+static void report(const net_server_t *server, unsigned long ticks,
+		unsigned long sent, double elapsed)
+{
+	int i, clients = 0;
+
+	for (i = 0; i < NET_MAX_PLAYERS; i++)
+		clients += server->peers[i].connected;
+	printf("tick %lu: %d clients, %.1f ticks/s, %.0f bytes/s per client, "
+			"%lu dropped\n", (unsigned long)server->tick, clients,
+			ticks / elapsed,
+			clients ? sent / elapsed / clients : 0.0,
+			server->link.dropped);
+	fflush(stdout);
+}
+
+/**
+ * serve - Runs the server at a fixed tick rate until interrupted.
+ * @server: The server.
+ */
+static void serve(net_server_t *server)
+{
+	double next = now_seconds(), last = next, now;
+	unsigned long ticks = 0, sent = server->link.sent_bytes;
+	struct timespec sleep;
+
+	while (running)
+	{
+		now = now_seconds();
+		if (now < next)
+		{
+			sleep.tv_sec = 0;
+			sleep.tv_nsec = (next - now) * 1e9;
+			nanosleep(&sleep, NULL);
+			continue;
+		}
+		net_server_tick(server, now);
+		ticks++;
+		next += 1 / server->tick_rate;
+		if (now - next > 1)
+			next = now;
+		if (now - last >= 1)
+		{
+			report(server, ticks, server->link.sent_bytes - sent,
+					now - last);
+			ticks = 0, sent = server->link.sent_bytes, last = now;
+		}
+	}
+}
+
+/**
+ * main - Runs a headless server players of the game can connect to.
+ * @argc: The number of command-line arguments.
+ * @argv: The map file, the UDP port and optionally the tick rate.
+ *
+ * Return: 0 on success, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	static net_server_t server;
+	map_t map;
+	float tick_rate = argc == 4 ? atof(argv[3]) : NET_TICK_RATE;
+
+	if ((argc != 3 && argc != 4) || tick_rate <= 0)
+	{
+		fprintf(stderr, "Usage: %s <map_file> <port> [tick_rate]\n",
+				argv[0]);
+		return (1);
+	}
+	if (!parse_map_from_file(argv[1], &map))
+		return (1);
+	if (!net_server_init(&server, &map, atoi(argv[2]), tick_rate))
+	{
+		fprintf(stderr, "Unable to listen on port %s\n", argv[2]);
+		map_free(&map);
+		return (1);
+	}
+	signal(SIGINT, stop);
+	signal(SIGTERM, stop);
+	printf("Serving %s on port %s at %.0f ticks/s\n", argv[1], argv[2],
+			tick_rate);
+	serve(&server);
+	net_server_free(&server);
+	map_free(&map);
+	return (0);
+}
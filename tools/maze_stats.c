@@ -0,0 +1,87 @@
+#include "../headers/maze.h"
+#include <time.h>
+
+/**
+ * print_stats - Prints the counters of a game over an interval.
+ * @now: The segment read at the end of the interval.
+ * @then: The segment read at its start.
+ * @seconds: The length of the interval.
+ */
+static void print_stats(const stats_shared_t *now,
+		const stats_shared_t *then, double seconds)
+{
+	const uint64_t *total = (const uint64_t *)&now->total;
+	const uint64_t *start = (const uint64_t *)&then->total;
+	uint64_t frames = now->frames - then->frames;
+	uint64_t sum[sizeof(frame_stats_t) / sizeof(uint64_t)];
+	size_t i;
+
+	for (i = 0; i < sizeof(sum) / sizeof(sum[0]); i++)
+		sum[i] = total[i] - start[i];
+	printf("%.1f fps", frames / seconds);
+	if (frames)
+		printf(", per frame: %lu rays, %lu cells, %lu wall, "
+				"%lu floor and %lu ceiling pixels, %lu texels, "
+				"%lu draw_pixel, %lu bytes uploaded",
+				(unsigned long)(sum[0] / frames),
+				(unsigned long)(sum[1] / frames),
+				(unsigned long)(sum[2] / frames),
+				(unsigned long)(sum[3] / frames),
+				(unsigned long)(sum[4] / frames),
+				(unsigned long)(sum[5] / frames),
+				(unsigned long)(sum[6] / frames),
+				(unsigned long)(sum[7] / frames));
+	printf("; %lu late, %lu dropped", (unsigned long)sum[8],
+			(unsigned long)sum[9]);
+	if (sum[10])
+		printf("; input shown after %.1f ms on average",
+				sum[11] / 1e3 / sum[10]);
+	if (frames && sum[12])
+		printf("; streamed %.1f KB per frame, %.2f ms to encode",
+				sum[12] / 1024.0 / frames,
+				sum[13] / 1e3 / frames);
+	putchar('\n');
+	fflush(stdout);
+}
+
+/**
+ * main - Prints the counters a running game publishes.
+ * @argc: The number of command-line arguments.
+ * @argv: The process ID of the game, or the name of its segment, and
+ * optionally the interval between two reports in seconds.
+ *
+ * Return: 0 once the game exits, 1 if it cannot be found.
+ */
+int main(int argc, char *argv[])
+{
+	stats_shared_t then, now;
+	struct timespec interval;
+	char name[64];
+	double seconds = argc == 3 ? atof(argv[2]) : 1;
+
+	if ((argc != 2 && argc != 3) || seconds <= 0 ||
+			strlen(argv[1]) >= sizeof(name) - 16)
+	{
+		fprintf(stderr, "Usage: %s <pid|name> [seconds]\n", argv[0]);
+		return (1);
+	}
+	if (argv[1][0] == '/')
+		strcpy(name, argv[1]);
+	else
+		sprintf(name, "/maze-stats.%s", argv[1]);
+	if (!stats_export_read(name, &then))
+	{
+		fprintf(stderr, "No frame counters published as %s\n", name);
+		return (1);
+	}
+	printf("Reading %s of process %d\n", name, (int)then.pid);
+	interval.tv_sec = seconds;
+	interval.tv_nsec = (seconds - interval.tv_sec) * 1e9;
+	while (nanosleep(&interval, NULL) == 0 &&
+			stats_export_read(name, &now))
+	{
+		print_stats(&now, &then, seconds);
+		then = now;
+	}
+	return (0);
+}
@@ -0,0 +1,66 @@
+#include "../headers/maze.h"
+
+/**
+ * parse_layout - Looks up a layout by name.
+ * @name: One of perfect, braided, cave or hall.
+ * @layout: Receives the layout.
+ *
+ * Return: True if @name is a layout, false otherwise.
+ */
+static bool parse_layout(const char *name, maze_layout_t *layout)
+{
+	static const char * const names[] = {
+		"perfect", "braided", "cave", "hall"
+	};
+	static const maze_layout_t layouts[] = {
+		MAZE_PERFECT, MAZE_BRAIDED, MAZE_CAVE, MAZE_HALL
+	};
+	int i;
+
+	for (i = 0; i < 4; i++)
+		if (strcmp(name, names[i]) == 0)
+		{
+			*layout = layouts[i];
+			return (true);
+		}
+	return (false);
+}
+
+/**
+ * main - Generates a map for the game.
+ * @argc: The number of command-line arguments.
+ * @argv: The layout, the number of rows and columns, the seed and
+ * optionally the output file; the map goes to stdout otherwise.
+ *
+ * Return: 0 on success, 1 otherwise.
+ */
+int main(int argc, char *argv[])
+{
+	mazegen_t gen;
+	FILE *file = stdout;
+	bool written;
+
+	if ((argc != 5 && argc != 6) || !parse_layout(argv[1], &gen.layout))
+	{
+		fprintf(stderr, "Usage: %s <perfect|braided|cave|hall> <rows> "
+				"<cols> <seed> [map_file]\n", argv[0]);
+		return (1);
+	}
+	gen.rows = atoi(argv[2]);
+	gen.cols = atoi(argv[3]);
+	gen.seed = strtoul(argv[4], NULL, 10);
+	if (argc == 6)
+		file = fopen(argv[5], "w");
+	if (!file)
+	{
+		fprintf(stderr, "Unable to open file: %s\n", argv[5]);
+		return (1);
+	}
+	written = mazegen_write(file, &gen);
+	if (file != stdout)
+		written = fclose(file) == 0 && written;
+	if (!written)
+		fprintf(stderr, "Unable to generate a %dx%d map (at most %d)\n",
+				gen.rows, gen.cols, MAP_MAX_SIZE);
+	return (written ? 0 : 1);
+}